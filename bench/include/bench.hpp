@@ -0,0 +1,217 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file bench.hpp
+ * \brief Minimal microbenchmark harness used by the benchmark suite.
+ *
+ * Benchmarks are registered with PL_BENCHMARK and run by bench_main.cpp,
+ * which writes the results as CSV or JSON so they can be tracked over time.
+**/
+#ifndef INCG_PL_BENCH_BENCH_HPP
+#define INCG_PL_BENCH_BENCH_HPP
+#include "../../include/pl/compiler.hpp" // PL_COMPILER, PL_COMPILER_MSVC
+#include "../../include/pl/glue.hpp"     // PL_GLUE
+#include <chrono>                        // std::chrono::steady_clock
+#include <cstddef>                       // std::size_t
+#include <cstdint>                       // std::int64_t, std::uint64_t
+#include <initializer_list>              // std::initializer_list
+#include <string>                        // std::string
+#include <vector>                        // std::vector
+#if PL_COMPILER == PL_COMPILER_MSVC
+#include <intrin.h> // _ReadWriteBarrier
+#endif              // PL_COMPILER == PL_COMPILER_MSVC
+
+namespace pl {
+namespace bench {
+/*!
+ * \brief Passed to a benchmark function. Drives the measured loop and
+ *        collects the counters reported alongside the timing.
+ *
+ * A benchmark function looks like:
+ * \code
+ * void my_benchmark(pl::bench::state& state)
+ * {
+ *     // set up, not measured
+ *     while (state.keep_running()) {
+ *         // measured
+ *     }
+ *     state.set_items_processed(state.iterations());
+ * }
+ * \endcode
+**/
+class state {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /*!
+     * \brief Creates a state.
+     * \param iterations The amount of iterations to run.
+     * \param arg The argument the benchmark is run with, for instance
+     *        the amount of threads to use.
+    **/
+    state(std::uint64_t iterations, std::int64_t arg) noexcept;
+
+    /*!
+     * \brief Starts the timer on the first call. Stops the timer once all
+     *        the iterations have been run.
+     * \return true while iterations are left to run; false otherwise.
+    **/
+    bool keep_running() noexcept;
+
+    /*!
+     * \brief Stops the timer, for work that is not to be measured.
+    **/
+    void pause_timing() noexcept;
+
+    /*!
+     * \brief Restarts the timer after pause_timing.
+    **/
+    void resume_timing() noexcept;
+
+    /*!
+     * \brief Returns the amount of iterations to run.
+    **/
+    std::uint64_t iterations() const noexcept;
+
+    /*!
+     * \brief Returns the argument the benchmark is run with.
+    **/
+    std::int64_t arg() const noexcept;
+
+    /*!
+     * \brief Sets the amount of items processed, reported as items/s.
+    **/
+    void set_items_processed(std::uint64_t items) noexcept;
+
+    /*!
+     * \brief Sets the amount of bytes processed, reported as bytes/s.
+    **/
+    void set_bytes_processed(std::uint64_t bytes) noexcept;
+
+    std::uint64_t items_processed() const noexcept;
+
+    std::uint64_t bytes_processed() const noexcept;
+
+    /*!
+     * \brief Returns the time measured.
+    **/
+    clock::duration elapsed() const noexcept;
+
+private:
+    std::uint64_t     m_iterations;
+    std::uint64_t     m_remaining;
+    std::int64_t      m_arg;
+    bool              m_started;
+    clock::time_point m_start;
+    clock::duration   m_elapsed;
+    std::uint64_t     m_items;
+    std::uint64_t     m_bytes;
+};
+
+/*!
+ * \brief Signature of a benchmark function.
+**/
+using function = void (*)(state&);
+
+/*!
+ * \brief A registered benchmark.
+**/
+struct benchmark {
+    std::string               name; //!< the name reported.
+    function                  fn;   //!< the benchmark function.
+    std::vector<std::int64_t> args; //!< run once per argument.
+};
+
+/*!
+ * \brief Returns the benchmarks registered.
+**/
+std::vector<benchmark>& registry();
+
+/*!
+ * \brief Registers a benchmark when constructed. Used by PL_BENCHMARK.
+**/
+class registrar {
+public:
+    registrar(
+        const char*                         name,
+        function                            fn,
+        std::initializer_list<std::int64_t> args);
+};
+
+/*!
+ * \brief Prevents the compiler from optimizing away the computation of value.
+**/
+template <typename Type>
+inline void do_not_optimize(const Type& value)
+{
+#if PL_COMPILER == PL_COMPILER_MSVC
+    static volatile const void* sink{nullptr};
+    sink = &value;
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/*!
+ * \brief Prevents the compiler from caching memory across this point.
+**/
+inline void clobber_memory()
+{
+#if PL_COMPILER == PL_COMPILER_MSVC
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+} // namespace bench
+} // namespace pl
+
+/*!
+ * \def PL_BENCHMARK(function_name)
+ * \brief Registers the benchmark function function_name to be run once
+ *        with an argument of 0.
+**/
+#define PL_BENCHMARK(function_name)                              \
+    static const ::pl::bench::registrar PL_GLUE(                 \
+        pl_bench_registrar_, function_name)                      \
+    {                                                            \
+        #function_name, &function_name, { std::int64_t{0} }      \
+    }
+
+/*!
+ * \def PL_BENCHMARK_ARGS(function_name, ...)
+ * \brief Registers the benchmark function function_name to be run once for
+ *        every argument passed in the variadic arguments, for instance
+ *        once per amount of threads to use.
+**/
+#define PL_BENCHMARK_ARGS(function_name, ...)                    \
+    static const ::pl::bench::registrar PL_GLUE(                 \
+        pl_bench_registrar_, function_name)                      \
+    {                                                            \
+        #function_name, &function_name, { __VA_ARGS__ }          \
+    }
+#endif // INCG_PL_BENCH_BENCH_HPP
@@ -0,0 +1,75 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"                // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/aligned_buffer.hpp" // pl::aligned_buffer
+#include <cstddef>                             // std::size_t
+#include <cstdint>                             // std::uint64_t
+#include <cstring>                             // std::memset
+
+namespace {
+/*!
+ * \brief Reads state.arg() MiB of memory in a random order, which is
+ *        dominated by TLB misses unless the memory is backed by huge
+ *        pages.
+**/
+void random_reads(pl::bench::state& state, pl::huge_page_policy policy)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U * 1024U};
+    const std::size_t  count{byte_count / sizeof(std::uint64_t)};
+    pl::aligned_buffer buffer{byte_count, pl::cache_line_size, policy};
+    std::uint64_t* const values{static_cast<std::uint64_t*>(buffer.data())};
+    std::memset(buffer.data(), 1, byte_count);
+
+    std::uint64_t index{0U};
+    std::uint64_t sum{0U};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < 1024U; ++i) {
+            index = (index * 6364136223846793005U) + 1442695040888963407U;
+            sum += values[(index >> 16U) % count];
+        }
+    }
+
+    pl::bench::do_not_optimize(sum);
+    state.set_items_processed(state.iterations() * 1024U);
+}
+
+void random_reads_small_pages(pl::bench::state& state)
+{
+    random_reads(state, pl::huge_page_policy::never);
+}
+
+PL_BENCHMARK_ARGS(random_reads_small_pages, 64, 512);
+
+void random_reads_huge_pages(pl::bench::state& state)
+{
+    random_reads(state, pl::huge_page_policy::always);
+}
+
+PL_BENCHMARK_ARGS(random_reads_huge_pages, 64, 512);
+} // anonymous namespace
@@ -0,0 +1,85 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"       // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/arena.hpp" // pl::arena, pl::arena_allocator
+#include <cstddef>                    // std::size_t
+#include <cstdint>                    // std::uint64_t
+#include <list>                       // std::list
+
+namespace {
+/*!
+ * \brief Builds and tears down a std::list of state.arg() elements,
+ *        allocating every node from the heap.
+**/
+void list_std_allocator(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+
+    while (state.keep_running()) {
+        std::list<std::uint64_t> list{};
+
+        for (std::size_t i{0U}; i < count; ++i) {
+            list.push_back(i);
+        }
+
+        pl::bench::do_not_optimize(list.back());
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(list_std_allocator, 16, 256, 4096);
+
+/*!
+ * \brief The same as list_std_allocator, but the nodes are allocated from
+ *        an arena that is reset after each iteration.
+**/
+void list_arena_allocator(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+    pl::arena         arena{};
+
+    while (state.keep_running()) {
+        {
+            std::list<std::uint64_t, pl::arena_allocator<std::uint64_t>> list{
+                pl::arena_allocator<std::uint64_t>{arena}};
+
+            for (std::size_t i{0U}; i < count; ++i) {
+                list.push_back(i);
+            }
+
+            pl::bench::do_not_optimize(list.back());
+        }
+
+        arena.reset();
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(list_arena_allocator, 16, 256, 4096);
+} // anonymous namespace
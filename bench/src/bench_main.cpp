@@ -0,0 +1,293 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"          // pl::bench::state, pl::bench::registry
+#include "../../include/pl/compiler.hpp" // PL_COMPILER_NAME
+#include "../../include/pl/os.hpp"       // PL_OS_NAME
+#include <algorithm>                     // std::max, std::min
+#include <chrono>                        // std::chrono::duration
+#include <ciso646>                       // not, and, or
+#include <cstdint>                       // std::uint64_t, std::int64_t
+#include <cstdlib>                       // std::strtod, EXIT_SUCCESS, EXIT_FAILURE
+#include <cstring>                       // std::strncmp, std::strlen
+#include <iostream>                      // std::cout, std::cerr
+#include <string>                        // std::string
+#include <thread>                        // std::thread::hardware_concurrency
+#include <vector>                        // std::vector
+
+namespace pl {
+namespace bench {
+state::state(std::uint64_t iterations, std::int64_t arg) noexcept
+    : m_iterations{iterations},
+      m_remaining{iterations},
+      m_arg{arg},
+      m_started{false},
+      m_start{},
+      m_elapsed{clock::duration::zero()},
+      m_items{0U},
+      m_bytes{0U}
+{
+}
+
+bool state::keep_running() noexcept
+{
+    if (not m_started) {
+        m_started = true;
+        m_start   = clock::now();
+    }
+
+    if (m_remaining == 0U) {
+        m_elapsed += clock::now() - m_start;
+        return false;
+    }
+
+    --m_remaining;
+    return true;
+}
+
+void state::pause_timing() noexcept { m_elapsed += clock::now() - m_start; }
+
+void state::resume_timing() noexcept { m_start = clock::now(); }
+
+std::uint64_t state::iterations() const noexcept { return m_iterations; }
+
+std::int64_t state::arg() const noexcept { return m_arg; }
+
+void state::set_items_processed(std::uint64_t items) noexcept
+{
+    m_items = items;
+}
+
+void state::set_bytes_processed(std::uint64_t bytes) noexcept
+{
+    m_bytes = bytes;
+}
+
+std::uint64_t state::items_processed() const noexcept { return m_items; }
+
+std::uint64_t state::bytes_processed() const noexcept { return m_bytes; }
+
+state::clock::duration state::elapsed() const noexcept { return m_elapsed; }
+
+std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> benchmarks{};
+    return benchmarks;
+}
+
+registrar::registrar(
+    const char*                         name,
+    function                            fn,
+    std::initializer_list<std::int64_t> args)
+{
+    registry().push_back(benchmark{name, fn, args});
+}
+
+namespace {
+/*!
+ * \brief The result of running a benchmark with one argument.
+**/
+struct result {
+    std::string   name;
+    std::int64_t  arg;
+    std::uint64_t iterations;
+    double        real_time_ns;
+    double        ns_per_iteration;
+    double        items_per_second;
+    double        bytes_per_second;
+};
+
+/*!
+ * \brief Command line options.
+**/
+struct options {
+    std::string format;   //!< "csv" or "json"
+    std::string filter;   //!< substring the names must contain
+    double      min_time; //!< minimum seconds to run each benchmark
+};
+
+/*!
+ * \brief Runs the benchmark with increasing iteration counts until a run
+ *        takes at least min_time seconds.
+**/
+result run(const benchmark& bm, std::int64_t arg, double min_time)
+{
+    static constexpr std::uint64_t max_iterations{1000000000U};
+    std::uint64_t                  iterations{1U};
+
+    for (;;) {
+        state st{iterations, arg};
+        bm.fn(st);
+
+        const double seconds{
+            std::chrono::duration<double>{st.elapsed()}.count()};
+
+        if ((seconds >= min_time) or (iterations >= max_iterations)) {
+            const double ns{seconds * 1e9};
+            return result{
+                bm.name,
+                arg,
+                iterations,
+                ns,
+                ns / static_cast<double>(iterations),
+                seconds > 0.0
+                    ? static_cast<double>(st.items_processed()) / seconds
+                    : 0.0,
+                seconds > 0.0
+                    ? static_cast<double>(st.bytes_processed()) / seconds
+                    : 0.0};
+        }
+
+        // estimate the amount of iterations needed, grow by at most 100x.
+        const double factor{
+            seconds > 0.0 ? std::min(100.0, 1.4 * min_time / seconds)
+                          : 100.0};
+        iterations = std::min(
+            max_iterations,
+            std::max(
+                iterations + 1U,
+                static_cast<std::uint64_t>(
+                    static_cast<double>(iterations) * factor)));
+    }
+}
+
+std::string escape_json(const std::string& str)
+{
+    std::string escaped{};
+
+    for (char c : str) {
+        if ((c == '"') or (c == '\\')) {
+            escaped += '\\';
+        }
+
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+void write_csv(const std::vector<result>& results)
+{
+    std::cout << "name,arg,iterations,real_time_ns,ns_per_iteration,"
+                 "items_per_second,bytes_per_second\n";
+
+    for (const result& r : results) {
+        std::cout << r.name << ',' << r.arg << ',' << r.iterations << ','
+                  << r.real_time_ns << ',' << r.ns_per_iteration << ','
+                  << r.items_per_second << ',' << r.bytes_per_second << '\n';
+    }
+}
+
+void write_json(const std::vector<result>& results)
+{
+    std::cout << "{\n  \"context\": {\n"
+              << "    \"compiler\": \"" << PL_COMPILER_NAME << "\",\n"
+              << "    \"compiler_major\": " << PL_COMPILER_MAJOR << ",\n"
+              << "    \"os\": \"" << PL_OS_NAME << "\",\n"
+              << "    \"hardware_concurrency\": "
+              << std::thread::hardware_concurrency() << "\n  },\n"
+              << "  \"benchmarks\": [";
+
+    for (std::size_t i{0U}; i < results.size(); ++i) {
+        const result& r{results[i]};
+        std::cout << (i == 0U ? "\n" : ",\n") << "    {\"name\": \""
+                  << escape_json(r.name) << "\", \"arg\": " << r.arg
+                  << ", \"iterations\": " << r.iterations
+                  << ", \"real_time_ns\": " << r.real_time_ns
+                  << ", \"ns_per_iteration\": " << r.ns_per_iteration
+                  << ", \"items_per_second\": " << r.items_per_second
+                  << ", \"bytes_per_second\": " << r.bytes_per_second << '}';
+    }
+
+    std::cout << "\n  ]\n}\n";
+}
+
+bool starts_with(const char* str, const char* prefix)
+{
+    return std::strncmp(str, prefix, std::strlen(prefix)) == 0;
+}
+
+void print_usage(const char* program)
+{
+    std::cerr << "Usage: " << program
+              << " [--format=csv|json] [--filter=SUBSTRING]"
+                 " [--min-time=SECONDS]\n";
+}
+} // anonymous namespace
+} // namespace bench
+} // namespace pl
+
+int main(int argc, char* argv[])
+{
+    pl::bench::options opts{"csv", "", 0.5};
+
+    for (int i{1}; i < argc; ++i) {
+        const char* const arg{argv[i]};
+
+        if (pl::bench::starts_with(arg, "--format=")) {
+            opts.format = arg + std::strlen("--format=");
+        }
+        else if (pl::bench::starts_with(arg, "--filter=")) {
+            opts.filter = arg + std::strlen("--filter=");
+        }
+        else if (pl::bench::starts_with(arg, "--min-time=")) {
+            opts.min_time
+                = std::strtod(arg + std::strlen("--min-time="), nullptr);
+        }
+        else {
+            pl::bench::print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ((opts.format != "csv") and (opts.format != "json")) {
+        pl::bench::print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<pl::bench::result> results{};
+    std::cout.precision(10);
+
+    for (const pl::bench::benchmark& bm : pl::bench::registry()) {
+        if (bm.name.find(opts.filter) == std::string::npos) {
+            continue;
+        }
+
+        for (std::int64_t bm_arg : bm.args) {
+            std::cerr << "running " << bm.name << '/' << bm_arg << '\n';
+            results.push_back(pl::bench::run(bm, bm_arg, opts.min_time));
+        }
+    }
+
+    if (opts.format == "json") {
+        pl::bench::write_json(results);
+    }
+    else {
+        pl::bench::write_csv(results);
+    }
+
+    return EXIT_SUCCESS;
+}
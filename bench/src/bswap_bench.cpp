@@ -0,0 +1,169 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"              // PL_BENCHMARK_ARGS, pl::bench::state
+#include "../../include/pl/bswap.hpp"        // pl::bswap, pl::bswap_n
+#include "../../include/pl/cpu_features.hpp" // pl::simd_level
+#include <cstddef>                           // std::size_t
+#include <cstdint>                           // std::uint16_t, std::uint32_t, std::uint64_t
+#include <vector>                            // std::vector
+
+namespace {
+/*!
+ * \brief Returns the amount of elements of type Ty in state.arg() KiB.
+**/
+template<typename Ty>
+std::size_t element_count(pl::bench::state& state)
+{
+    return (static_cast<std::size_t>(state.arg()) * 1024U) / sizeof(Ty);
+}
+
+/*!
+ * \brief Byte swaps state.arg() KiB of Ty calling pl::bswap for every
+ *        element.
+**/
+template<typename Ty>
+void bswap_loop(pl::bench::state& state)
+{
+    const std::size_t     count{element_count<Ty>(state)};
+    const std::vector<Ty> source(count, static_cast<Ty>(0x1234));
+    std::vector<Ty>       destination(count);
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < count; ++i) {
+            destination[i] = pl::bswap(source[i]);
+        }
+
+        pl::bench::do_not_optimize(destination.data());
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * count * sizeof(Ty));
+}
+
+/*!
+ * \brief Byte swaps state.arg() KiB of Ty using bswap_n with 'level'.
+**/
+template<typename Ty>
+void bswap_n_level(pl::bench::state& state, pl::simd_level level)
+{
+    const std::size_t     count{element_count<Ty>(state)};
+    const std::vector<Ty> source(count, static_cast<Ty>(0x1234));
+    std::vector<Ty>       destination(count);
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(
+            pl::bswap_n(destination.data(), source.data(), count, level));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * count * sizeof(Ty));
+}
+
+void bswap_loop_u16(pl::bench::state& state)
+{
+    bswap_loop<std::uint16_t>(state);
+}
+
+PL_BENCHMARK_ARGS(bswap_loop_u16, 4, 4096);
+
+void bswap_n_scalar_u16(pl::bench::state& state)
+{
+    bswap_n_level<std::uint16_t>(state, pl::simd_level::none);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_scalar_u16, 4, 4096);
+
+void bswap_n_ssse3_u16(pl::bench::state& state)
+{
+    bswap_n_level<std::uint16_t>(state, pl::simd_level::ssse3);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_ssse3_u16, 4, 4096);
+
+void bswap_n_avx2_u16(pl::bench::state& state)
+{
+    bswap_n_level<std::uint16_t>(state, pl::simd_level::avx2);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_avx2_u16, 4, 4096);
+
+void bswap_loop_u32(pl::bench::state& state)
+{
+    bswap_loop<std::uint32_t>(state);
+}
+
+PL_BENCHMARK_ARGS(bswap_loop_u32, 4, 4096);
+
+void bswap_n_scalar_u32(pl::bench::state& state)
+{
+    bswap_n_level<std::uint32_t>(state, pl::simd_level::none);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_scalar_u32, 4, 4096);
+
+void bswap_n_ssse3_u32(pl::bench::state& state)
+{
+    bswap_n_level<std::uint32_t>(state, pl::simd_level::ssse3);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_ssse3_u32, 4, 4096);
+
+void bswap_n_avx2_u32(pl::bench::state& state)
+{
+    bswap_n_level<std::uint32_t>(state, pl::simd_level::avx2);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_avx2_u32, 4, 4096);
+
+void bswap_loop_u64(pl::bench::state& state)
+{
+    bswap_loop<std::uint64_t>(state);
+}
+
+PL_BENCHMARK_ARGS(bswap_loop_u64, 4, 4096);
+
+void bswap_n_scalar_u64(pl::bench::state& state)
+{
+    bswap_n_level<std::uint64_t>(state, pl::simd_level::none);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_scalar_u64, 4, 4096);
+
+void bswap_n_ssse3_u64(pl::bench::state& state)
+{
+    bswap_n_level<std::uint64_t>(state, pl::simd_level::ssse3);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_ssse3_u64, 4, 4096);
+
+void bswap_n_avx2_u64(pl::bench::state& state)
+{
+    bswap_n_level<std::uint64_t>(state, pl::simd_level::avx2);
+}
+
+PL_BENCHMARK_ARGS(bswap_n_avx2_u64, 4, 4096);
+} // anonymous namespace
@@ -0,0 +1,162 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"                // PL_BENCHMARK_ARGS, pl::bench::state
+#include "../../include/pl/dynamic_bitset.hpp" // pl::dynamic_bitset
+#include <cstddef>                             // std::size_t
+#include <vector>                              // std::vector
+
+namespace {
+/*!
+ * \brief Returns state.arg() Ki bits with every third bit set.
+**/
+template<typename Bitset>
+Bitset make_bits(pl::bench::state& state)
+{
+    const std::size_t bit_count{static_cast<std::size_t>(state.arg()) * 1024U};
+    Bitset            bits(bit_count);
+
+    for (std::size_t i{0U}; i < bit_count; i += 3U) {
+        bits[i] = true;
+    }
+
+    return bits;
+}
+
+template<>
+pl::dynamic_bitset make_bits<pl::dynamic_bitset>(pl::bench::state& state)
+{
+    const std::size_t  bit_count{static_cast<std::size_t>(state.arg()) * 1024U};
+    pl::dynamic_bitset bits(bit_count);
+
+    for (std::size_t i{0U}; i < bit_count; i += 3U) {
+        bits.set(i);
+    }
+
+    return bits;
+}
+
+void vector_bool_and(pl::bench::state& state)
+{
+    std::vector<bool>       bits{make_bits<std::vector<bool>>(state)};
+    const std::vector<bool> other(bits.size(), true);
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < bits.size(); ++i) {
+            bits[i] = bits[i] and other[i];
+        }
+
+        pl::bench::clobber_memory();
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(vector_bool_and, 64, 8192);
+
+void dynamic_bitset_and(pl::bench::state& state)
+{
+    pl::dynamic_bitset       bits{make_bits<pl::dynamic_bitset>(state)};
+    const pl::dynamic_bitset other(bits.size(), true);
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(&(bits &= other));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(dynamic_bitset_and, 64, 8192);
+
+void vector_bool_count(pl::bench::state& state)
+{
+    const std::vector<bool> bits{make_bits<std::vector<bool>>(state)};
+
+    while (state.keep_running()) {
+        std::size_t count{0U};
+
+        for (bool bit : bits) {
+            count += bit ? 1U : 0U;
+        }
+
+        pl::bench::do_not_optimize(count);
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(vector_bool_count, 64, 8192);
+
+void dynamic_bitset_count(pl::bench::state& state)
+{
+    const pl::dynamic_bitset bits{make_bits<pl::dynamic_bitset>(state)};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(bits.count());
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(dynamic_bitset_count, 64, 8192);
+
+void vector_bool_iterate(pl::bench::state& state)
+{
+    const std::vector<bool> bits{make_bits<std::vector<bool>>(state)};
+
+    while (state.keep_running()) {
+        std::size_t sum{0U};
+
+        for (std::size_t i{0U}; i < bits.size(); ++i) {
+            if (bits[i]) {
+                sum += i;
+            }
+        }
+
+        pl::bench::do_not_optimize(sum);
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(vector_bool_iterate, 64, 8192);
+
+void dynamic_bitset_iterate(pl::bench::state& state)
+{
+    const pl::dynamic_bitset bits{make_bits<pl::dynamic_bitset>(state)};
+
+    while (state.keep_running()) {
+        std::size_t sum{0U};
+        bits.for_each_set([&sum](std::size_t i) { sum += i; });
+        pl::bench::do_not_optimize(sum);
+    }
+
+    state.set_items_processed(state.iterations() * bits.size());
+}
+
+PL_BENCHMARK_ARGS(dynamic_bitset_iterate, 64, 8192);
+} // anonymous namespace
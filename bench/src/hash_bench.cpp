@@ -0,0 +1,235 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"      // PL_BENCHMARK_ARGS, pl::bench::state
+#include "../../include/pl/hash.hpp" // pl::hash_bytes, pl::crc32c, pl::hash, pl::hash_range
+#include <algorithm>                 // std::fill
+#include <cstddef>                   // std::size_t
+#include <cstdint>                   // std::uint64_t
+#include <list>                      // std::list
+#include <functional>                // std::hash
+#include <string>                    // std::string
+#include <vector>                    // std::vector
+
+namespace {
+/*!
+ * \brief Returns a string of state.arg() bytes.
+**/
+std::string make_input(pl::bench::state& state)
+{
+    return std::string(static_cast<std::size_t>(state.arg()), 'x');
+}
+
+void hash_bytes(pl::bench::state& state)
+{
+    const std::string input{make_input(state)};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::hash_bytes(input.data(), input.size()));
+    }
+
+    state.set_bytes_processed(state.iterations() * input.size());
+}
+
+PL_BENCHMARK_ARGS(hash_bytes, 8, 64, 1024, 65536);
+
+void std_hash_string(pl::bench::state& state)
+{
+    const std::string       input{make_input(state)};
+    const std::hash<std::string> hasher{};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(hasher(input));
+    }
+
+    state.set_bytes_processed(state.iterations() * input.size());
+}
+
+PL_BENCHMARK_ARGS(std_hash_string, 8, 64, 1024, 65536);
+
+void crc32c(pl::bench::state& state)
+{
+    const std::string input{make_input(state)};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::crc32c(input.data(), input.size()));
+    }
+
+    state.set_bytes_processed(state.iterations() * input.size());
+}
+
+PL_BENCHMARK_ARGS(crc32c, 8, 64, 1024, 65536);
+
+void crc32c_software(pl::bench::state& state)
+{
+    const std::string input{make_input(state)};
+    const auto* const data
+        = reinterpret_cast<const unsigned char*>(input.data());
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(
+            pl::detail::crc32c_software(0xFFFFFFFFU, data, input.size()));
+    }
+
+    state.set_bytes_processed(state.iterations() * input.size());
+}
+
+PL_BENCHMARK_ARGS(crc32c_software, 8, 64, 1024, 65536);
+
+/*!
+ * \brief Inserts state.arg() multiples of 1024 into a linear probing hash
+ *        table with a power of two size using 'Hash'.
+ *
+ * Keys that share their low bits are the worst case for such a table,
+ * a hash function with poor avalanche behavior maps them to the same
+ * slots, which makes every insertion probe the entire cluster.
+**/
+template<typename Hash>
+void insert_strided(pl::bench::state& state)
+{
+    const std::size_t          count{static_cast<std::size_t>(state.arg())};
+    const std::size_t          mask{(count * 2U) - 1U};
+    std::vector<std::uint64_t> table(count * 2U);
+    const Hash                 hasher{};
+
+    while (state.keep_running()) {
+        std::fill(table.begin(), table.end(), std::uint64_t{0U});
+
+        for (std::size_t i{1U}; i <= count; ++i) {
+            const std::uint64_t key{std::uint64_t{i} << 10U};
+            std::size_t         slot{hasher(key) & mask};
+
+            while (table[slot] != 0U) {
+                slot = (slot + 1U) & mask;
+            }
+
+            table[slot] = key;
+        }
+
+        pl::bench::do_not_optimize(table.data());
+        pl::bench::clobber_memory();
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+/*!
+ * \brief Hashes a single value with the classic golden ratio combiner.
+**/
+struct golden_ratio_hash {
+    std::size_t operator()(std::uint64_t value) const noexcept
+    {
+        std::size_t seed{0U};
+        seed ^= std::hash<std::uint64_t>{}(value) + 0x9E3779B9U + (seed << 6U)
+                + (seed >> 2U);
+        return seed;
+    }
+};
+
+/*!
+ * \brief Hashes a single value with pl::hash.
+**/
+struct pl_hash {
+    std::size_t operator()(std::uint64_t value) const noexcept
+    {
+        return pl::hash(value);
+    }
+};
+
+void insert_strided_golden_ratio(pl::bench::state& state)
+{
+    insert_strided<golden_ratio_hash>(state);
+}
+
+PL_BENCHMARK_ARGS(insert_strided_golden_ratio, 1024, 4096);
+
+void insert_strided_pl_hash(pl::bench::state& state)
+{
+    insert_strided<pl_hash>(state);
+}
+
+PL_BENCHMARK_ARGS(insert_strided_pl_hash, 1024, 4096);
+
+/*!
+ * \brief Returns a vector of state.arg() ints.
+**/
+std::vector<int> make_ints(pl::bench::state& state)
+{
+    std::vector<int> ints(static_cast<std::size_t>(state.arg()));
+
+    for (std::size_t i{0U}; i < ints.size(); ++i) {
+        ints[i] = static_cast<int>(i);
+    }
+
+    return ints;
+}
+
+void hash_ints_per_element(pl::bench::state& state)
+{
+    const std::vector<int> ints{make_ints(state)};
+
+    while (state.keep_running()) {
+        std::size_t hash_seed{0U};
+
+        for (int value : ints) {
+            pl::hash_combine(hash_seed, std::hash<int>{}(value));
+        }
+
+        pl::bench::do_not_optimize(hash_seed);
+    }
+
+    state.set_items_processed(state.iterations() * ints.size());
+}
+
+PL_BENCHMARK_ARGS(hash_ints_per_element, 16, 10000);
+
+void hash_range_vector(pl::bench::state& state)
+{
+    const std::vector<int> ints{make_ints(state)};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::hash_range(ints));
+    }
+
+    state.set_items_processed(state.iterations() * ints.size());
+}
+
+PL_BENCHMARK_ARGS(hash_range_vector, 16, 10000);
+
+void hash_range_list(pl::bench::state& state)
+{
+    const std::vector<int> ints{make_ints(state)};
+    const std::list<int>   list(ints.begin(), ints.end());
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::hash_range(list));
+    }
+
+    state.set_items_processed(state.iterations() * list.size());
+}
+
+PL_BENCHMARK_ARGS(hash_range_list, 16, 10000);
+} // anonymous namespace
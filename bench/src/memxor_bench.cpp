@@ -0,0 +1,230 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"              // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/byte.hpp"         // pl::byte
+#include "../../include/pl/cpu_features.hpp" // pl::simd_level
+#include "../../include/pl/memxor.hpp"       // pl::memxor, pl::memxor_n
+#include <cstddef>                           // std::size_t
+#include <cstring>                           // std::memcpy
+#include <vector>                            // std::vector
+
+namespace {
+/*!
+ * \brief xors state.arg() KiB using the kernel for 'level'.
+ *        Levels not supported by the CPU fall back to the best one that is.
+**/
+void memxor_level(pl::bench::state& state, pl::simd_level level)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<pl::byte>       destination(byte_count, pl::byte{0x12});
+    const std::vector<pl::byte> source(byte_count, pl::byte{0x34});
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(
+            pl::memxor(destination.data(), source.data(), byte_count, level));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+/*!
+ * \brief The previous implementation, one byte per iteration, which the
+ *        compiler may vectorize on its own.
+**/
+void memxor_bytewise(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<pl::byte>       destination(byte_count, pl::byte{0x12});
+    const std::vector<pl::byte> source(byte_count, pl::byte{0x34});
+
+    while (state.keep_running()) {
+        pl::byte*       dest{destination.data()};
+        const pl::byte* src{source.data()};
+
+        for (std::size_t i{0U}; i < byte_count; ++i) {
+            dest[i] ^= src[i];
+        }
+
+        pl::bench::do_not_optimize(dest);
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+PL_BENCHMARK_ARGS(memxor_bytewise, 4, 64, 4096);
+
+void memxor_words(pl::bench::state& state)
+{
+    memxor_level(state, pl::simd_level::none);
+}
+
+PL_BENCHMARK_ARGS(memxor_words, 4, 64, 4096);
+
+void memxor_sse2(pl::bench::state& state)
+{
+    memxor_level(state, pl::simd_level::sse2);
+}
+
+PL_BENCHMARK_ARGS(memxor_sse2, 4, 64, 4096);
+
+void memxor_avx2(pl::bench::state& state)
+{
+    memxor_level(state, pl::simd_level::avx2);
+}
+
+PL_BENCHMARK_ARGS(memxor_avx2, 4, 64, 4096);
+
+void memxor_avx512(pl::bench::state& state)
+{
+    memxor_level(state, pl::simd_level::avx512);
+}
+
+PL_BENCHMARK_ARGS(memxor_avx512, 4, 64, 4096);
+
+/*!
+ * \brief The amount of data buffers the parity benchmarks combine.
+**/
+constexpr std::size_t parity_source_count{4U};
+
+/*!
+ * \brief Creates parity_source_count buffers of state.arg() KiB each.
+**/
+std::vector<std::vector<pl::byte>> parity_sources(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<std::vector<pl::byte>> sources{};
+
+    for (std::size_t i{0U}; i < parity_source_count; ++i) {
+        sources.emplace_back(byte_count, static_cast<pl::byte>(i + 1U));
+    }
+
+    return sources;
+}
+
+/*!
+ * \brief Computes parity by calling memxor once per source, which reads and
+ *        writes the destination once per source.
+**/
+void memxor_parity_repeated(pl::bench::state& state)
+{
+    const std::vector<std::vector<pl::byte>> sources{parity_sources(state)};
+    const std::size_t     byte_count{sources.front().size()};
+    std::vector<pl::byte> parity(byte_count);
+
+    while (state.keep_running()) {
+        for (const std::vector<pl::byte>& source : sources) {
+            pl::bench::do_not_optimize(
+                pl::memxor(parity.data(), source.data(), byte_count));
+        }
+
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(
+        state.iterations() * parity_source_count * byte_count);
+}
+
+PL_BENCHMARK_ARGS(memxor_parity_repeated, 64, 4096, 65536);
+
+/*!
+ * \brief Computes parity with a single cache blocked memxor_n pass.
+**/
+void memxor_parity_n(pl::bench::state& state)
+{
+    const std::vector<std::vector<pl::byte>> sources{parity_sources(state)};
+    const std::size_t     byte_count{sources.front().size()};
+    std::vector<pl::byte> parity(byte_count);
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::memxor_n(
+            parity.data(),
+            {sources[0U].data(),
+             sources[1U].data(),
+             sources[2U].data(),
+             sources[3U].data()},
+            byte_count));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(
+        state.iterations() * parity_source_count * byte_count);
+}
+
+PL_BENCHMARK_ARGS(memxor_parity_n, 64, 4096, 65536);
+
+/*!
+ * \brief Combines two buffers into a third one by copying the first one
+ *        and xor-assigning the second one.
+**/
+void memxor_copy_then_xor(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    const std::vector<pl::byte> first(byte_count, pl::byte{0x12});
+    const std::vector<pl::byte> second(byte_count, pl::byte{0x34});
+    std::vector<pl::byte>       destination(byte_count);
+
+    while (state.keep_running()) {
+        std::memcpy(destination.data(), first.data(), byte_count);
+        pl::bench::do_not_optimize(
+            pl::memxor(destination.data(), second.data(), byte_count));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * 2U * byte_count);
+}
+
+PL_BENCHMARK_ARGS(memxor_copy_then_xor, 64, 4096, 65536);
+
+/*!
+ * \brief Combines two buffers into a third one using the three operand
+ *        memxor.
+**/
+void memxor_three_operand(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    const std::vector<pl::byte> first(byte_count, pl::byte{0x12});
+    const std::vector<pl::byte> second(byte_count, pl::byte{0x34});
+    std::vector<pl::byte>       destination(byte_count);
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(pl::memxor(
+            destination.data(), first.data(), second.data(), byte_count));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * 2U * byte_count);
+}
+
+PL_BENCHMARK_ARGS(memxor_three_operand, 64, 4096, 65536);
+} // anonymous namespace
@@ -0,0 +1,89 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"             // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/object_pool.hpp" // pl::object_pool
+#include <cstddef>                          // std::size_t
+#include <cstdint>                          // std::uint64_t
+#include <vector>                           // std::vector
+
+namespace {
+struct node {
+    std::uint64_t values[4];
+};
+
+/*!
+ * \brief Allocates and frees state.arg() objects with new and delete.
+**/
+void new_delete(pl::bench::state& state)
+{
+    const std::size_t  count{static_cast<std::size_t>(state.arg())};
+    std::vector<node*> nodes(count);
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < count; ++i) {
+            nodes[i] = new node{{i, i, i, i}};
+        }
+
+        pl::bench::do_not_optimize(nodes.back());
+
+        for (node* n : nodes) {
+            delete n;
+        }
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(new_delete, 16, 256, 4096);
+
+/*!
+ * \brief The same as new_delete, but the objects are allocated from an
+ *        object_pool.
+**/
+void object_pool_create_destroy(pl::bench::state& state)
+{
+    const std::size_t     count{static_cast<std::size_t>(state.arg())};
+    std::vector<node*>    nodes(count);
+    pl::object_pool<node> pool{};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < count; ++i) {
+            nodes[i] = pool.create(node{{i, i, i, i}});
+        }
+
+        pl::bench::do_not_optimize(nodes.back());
+
+        for (node* n : nodes) {
+            pool.destroy(n);
+        }
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(object_pool_create_destroy, 16, 256, 4096);
+} // anonymous namespace
@@ -0,0 +1,80 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"                  // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/byte.hpp"             // pl::byte
+#include "../../include/pl/raw_memory_array.hpp" // pl::raw_memory_array, pl::default_init_t
+#include <cstddef>                               // std::size_t
+#include <cstdint>                               // std::uint32_t
+#include <memory>                                // std::unique_ptr
+
+namespace {
+/*!
+ * \brief Creates a raw_memory_array of state.arg() KiB of integers,
+ *        filling it with zeroes and writing one element.
+**/
+void raw_memory_array_fill(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    const std::unique_ptr<pl::byte[]> memory{new pl::byte[byte_count]};
+
+    while (state.keep_running()) {
+        pl::raw_memory_array<std::uint32_t> array{
+            memory.get(), byte_count, 0U};
+        array.front() = 1U;
+        pl::bench::do_not_optimize(array.front());
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+PL_BENCHMARK_ARGS(raw_memory_array_fill, 1024, 4096, 16384);
+
+/*!
+ * \brief The same as raw_memory_array_fill, but the elements are left
+ *        uninitialized.
+**/
+void raw_memory_array_default_init(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    const std::unique_ptr<pl::byte[]> memory{new pl::byte[byte_count]};
+
+    while (state.keep_running()) {
+        pl::raw_memory_array<std::uint32_t> array{
+            memory.get(), byte_count, pl::default_init_t{}};
+        array.front() = 1U;
+        pl::bench::do_not_optimize(array.front());
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+PL_BENCHMARK_ARGS(raw_memory_array_default_init, 1024, 4096, 16384);
+} // anonymous namespace
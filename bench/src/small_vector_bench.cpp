@@ -0,0 +1,125 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"              // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/small_vector.hpp" // pl::small_vector
+#include <cstddef>                           // std::size_t
+#include <cstdint>                           // std::uint64_t
+#include <string>                            // std::string
+#include <vector>                            // std::vector
+
+namespace {
+/*!
+ * \brief Fills a std::vector with state.arg() integers.
+**/
+void std_vector_push_back(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+
+    while (state.keep_running()) {
+        std::vector<std::uint64_t> vector{};
+
+        for (std::size_t i{0U}; i < count; ++i) {
+            vector.push_back(i);
+        }
+
+        pl::bench::do_not_optimize(vector.back());
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(std_vector_push_back, 4, 16, 64);
+
+/*!
+ * \brief The same as std_vector_push_back, but with a small_vector that
+ *        holds 16 integers inline.
+**/
+void small_vector_push_back(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+
+    while (state.keep_running()) {
+        pl::small_vector<std::uint64_t, 16> vector{};
+
+        for (std::size_t i{0U}; i < count; ++i) {
+            vector.push_back(i);
+        }
+
+        pl::bench::do_not_optimize(vector.back());
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(small_vector_push_back, 4, 16, 64);
+
+/*!
+ * \brief Grows a std::vector of strings, moving the strings whenever it
+ *        reallocates.
+**/
+void std_vector_grow_strings(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+
+    while (state.keep_running()) {
+        std::vector<std::string> vector{};
+
+        for (std::size_t i{0U}; i < count; ++i) {
+            vector.emplace_back(4U, 'a');
+        }
+
+        pl::bench::do_not_optimize(vector.back());
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(std_vector_grow_strings, 4, 16, 64);
+
+/*!
+ * \brief The same as std_vector_grow_strings, but with a small_vector that
+ *        holds 16 strings inline.
+**/
+void small_vector_grow_strings(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+
+    while (state.keep_running()) {
+        pl::small_vector<std::string, 16> vector{};
+
+        for (std::size_t i{0U}; i < count; ++i) {
+            vector.emplace_back(4U, 'a');
+        }
+
+        pl::bench::do_not_optimize(vector.back());
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(small_vector_grow_strings, 4, 16, 64);
+} // anonymous namespace
@@ -0,0 +1,110 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"            // PL_BENCHMARK, pl::bench::state
+#include "../../include/pl/soa_vector.hpp" // pl::soa_vector
+#include <cstddef>                         // std::size_t
+#include <cstdint>                         // std::uint64_t
+#include <vector>                          // std::vector
+
+namespace {
+/*!
+ * \brief A record of which only the position is hot.
+**/
+struct particle {
+    double        position;
+    double        velocity[3];
+    std::uint64_t id;
+    std::uint64_t flags;
+    double        mass;
+    double        charge;
+};
+
+/*!
+ * \brief Sums the positions of state.arg() particles stored as an array of
+ *        structs.
+**/
+void array_of_structs_sum(pl::bench::state& state)
+{
+    const std::size_t     count{static_cast<std::size_t>(state.arg())};
+    std::vector<particle> particles(count);
+
+    for (std::size_t i{0U}; i < count; ++i) {
+        particles[i].position = static_cast<double>(i);
+    }
+
+    while (state.keep_running()) {
+        double sum{0.0};
+
+        for (const particle& p : particles) {
+            sum += p.position;
+        }
+
+        pl::bench::do_not_optimize(sum);
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(array_of_structs_sum, 1024, 1048576);
+
+/*!
+ * \brief The same as array_of_structs_sum, but the particles are stored in
+ *        a soa_vector, so only the positions are loaded.
+**/
+void soa_vector_sum(pl::bench::state& state)
+{
+    const std::size_t count{static_cast<std::size_t>(state.arg())};
+    pl::soa_vector<
+        double,
+        double,
+        double,
+        double,
+        std::uint64_t,
+        std::uint64_t,
+        double,
+        double>
+        particles(count);
+
+    for (std::size_t i{0U}; i < count; ++i) {
+        particles.column<0>()[i] = static_cast<double>(i);
+    }
+
+    while (state.keep_running()) {
+        double sum{0.0};
+
+        for (double position : particles.column<0>()) {
+            sum += position;
+        }
+
+        pl::bench::do_not_optimize(sum);
+    }
+
+    state.set_items_processed(state.iterations() * count);
+}
+
+PL_BENCHMARK_ARGS(soa_vector_sum, 1024, 1048576);
+} // anonymous namespace
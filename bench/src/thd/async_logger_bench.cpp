@@ -0,0 +1,111 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                  // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/async_logger.hpp" // pl::thd::async_logger
+#include <cstddef>                                  // std::size_t
+#include <cstdio>                                   // std::FILE, std::fopen, std::fprintf, std::fclose, std::setvbuf
+#include <thread>                                   // std::thread
+#include <vector>                                   // std::vector
+
+namespace {
+constexpr int messages_per_thread{10000};
+
+/*!
+ * \brief Threads logging through an async_logger writing to /dev/null.
+**/
+void async_logger_log(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::FILE* const  null_file{std::fopen("/dev/null", "w")};
+    std::vector<std::thread> threads{};
+
+    {
+        pl::thd::async_logger logger{fileno(null_file)};
+
+        while (state.keep_running()) {
+            for (std::size_t i{0U}; i < thread_count; ++i) {
+                threads.emplace_back([&logger, i] {
+                    for (int j{0}; j < messages_per_thread; ++j) {
+                        (void)logger.log("thread %zu message %d\n", i, j);
+                    }
+                });
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            threads.clear();
+        }
+
+        logger.flush();
+    }
+
+    std::fclose(null_file);
+    state.set_items_processed(
+        state.iterations() * thread_count
+        * static_cast<std::size_t>(messages_per_thread));
+}
+
+PL_BENCHMARK_ARGS(async_logger_log, 1, 2, 4, 8);
+
+/*!
+ * \brief The same workload written synchronously through fprintf,
+ *        like eprintf does.
+**/
+void fprintf_log(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::FILE* const  null_file{std::fopen("/dev/null", "w")};
+    std::vector<std::thread> threads{};
+    std::setvbuf(null_file, nullptr, _IONBF, 0U);
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([null_file, i] {
+                for (int j{0}; j < messages_per_thread; ++j) {
+                    (void)std::fprintf(
+                        null_file, "thread %zu message %d\n", i, j);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    std::fclose(null_file);
+    state.set_items_processed(
+        state.iterations() * thread_count
+        * static_cast<std::size_t>(messages_per_thread));
+}
+
+PL_BENCHMARK_ARGS(fprintf_log, 1, 2, 4, 8);
+} // anonymous namespace
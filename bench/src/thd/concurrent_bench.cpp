@@ -0,0 +1,77 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/concurrent.hpp" // pl::thd::concurrent
+#include <future>                                 // std::future
+#include <vector>                                 // std::vector
+
+namespace {
+/*!
+ * \brief Latency of running a callable on the concurrent's thread and
+ *        waiting for its result.
+**/
+void concurrent_call_latency(pl::bench::state& state)
+{
+    pl::thd::concurrent<int> concurrent{0};
+
+    while (state.keep_running()) {
+        std::future<int> fut{concurrent([](int& i) { return ++i; })};
+        pl::bench::do_not_optimize(fut.get());
+    }
+
+    state.set_items_processed(state.iterations());
+}
+
+PL_BENCHMARK(concurrent_call_latency);
+
+/*!
+ * \brief Throughput of queueing many callables before waiting for them.
+**/
+void concurrent_throughput(pl::bench::state& state)
+{
+    static constexpr int             batch_size{1000};
+    pl::thd::concurrent<int>         concurrent{0};
+    std::vector<std::future<int>>    futures{};
+    futures.reserve(batch_size);
+
+    while (state.keep_running()) {
+        for (int i{0}; i < batch_size; ++i) {
+            futures.push_back(concurrent([](int& j) { return ++j; }));
+        }
+
+        for (std::future<int>& fut : futures) {
+            pl::bench::do_not_optimize(fut.get());
+        }
+
+        futures.clear();
+    }
+
+    state.set_items_processed(state.iterations() * batch_size);
+}
+
+PL_BENCHMARK(concurrent_throughput);
+} // anonymous namespace
@@ -0,0 +1,129 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                         // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/concurrent_hash_map.hpp" // pl::thd::concurrent_hash_map
+#include "../../../include/pl/thd/monitor.hpp"             // pl::thd::monitor
+#include <cstddef>                                         // std::size_t
+#include <cstdint>                                         // std::uint64_t
+#include <thread>                                          // std::thread
+#include <unordered_map>                                   // std::unordered_map
+#include <utility>                                         // std::move
+#include <vector>                                          // std::vector
+
+namespace {
+constexpr std::uint64_t key_count{4096U};
+constexpr std::uint64_t operations_per_thread{100000U};
+constexpr std::uint64_t writes_per_read{10U}; // one write per 10 operations
+
+template <typename Operation>
+void run_threads(pl::bench::state& state, Operation operation)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::vector<std::thread> threads{};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&operation, i] {
+                std::uint64_t key{i * 7919U};
+                std::uint64_t sum{0U};
+
+                for (std::uint64_t j{0U}; j < operations_per_thread; ++j) {
+                    key = (key + 104729U) % key_count;
+                    sum += operation(key, (j % writes_per_read) == 0U);
+                }
+
+                pl::bench::do_not_optimize(sum);
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    state.set_items_processed(
+        state.iterations() * thread_count * operations_per_thread);
+}
+
+/*!
+ * \brief Mostly lookups with 10% assignments on a concurrent_hash_map.
+**/
+void concurrent_hash_map_read_mostly(pl::bench::state& state)
+{
+    pl::thd::concurrent_hash_map<std::uint64_t, std::uint64_t> map{};
+
+    for (std::uint64_t key{0U}; key < key_count; ++key) {
+        (void)map.insert_or_assign(key, key);
+    }
+
+    run_threads(state, [&map](std::uint64_t key, bool is_write) {
+        if (is_write) {
+            (void)map.insert_or_assign(key, key + 1U);
+            return std::uint64_t{0U};
+        }
+
+        std::uint64_t value{0U};
+        (void)map.find(key, value);
+        return value;
+    });
+}
+
+PL_BENCHMARK_ARGS(concurrent_hash_map_read_mostly, 1, 2, 4, 8);
+
+/*!
+ * \brief The same workload on a std::unordered_map inside a monitor.
+**/
+void monitor_unordered_map_read_mostly(pl::bench::state& state)
+{
+    std::unordered_map<std::uint64_t, std::uint64_t> initial{};
+
+    for (std::uint64_t key{0U}; key < key_count; ++key) {
+        initial[key] = key;
+    }
+
+    pl::thd::monitor<std::unordered_map<std::uint64_t, std::uint64_t>> map{
+        std::move(initial)};
+
+    run_threads(state, [&map](std::uint64_t key, bool is_write) {
+        return map(
+            [key, is_write](
+                std::unordered_map<std::uint64_t, std::uint64_t>& m) {
+                if (is_write) {
+                    m[key] = key + 1U;
+                    return std::uint64_t{0U};
+                }
+
+                const auto it = m.find(key);
+                return it == m.end() ? std::uint64_t{0U} : it->second;
+            });
+    });
+}
+
+PL_BENCHMARK_ARGS(monitor_unordered_map_read_mostly, 1, 2, 4, 8);
+} // anonymous namespace
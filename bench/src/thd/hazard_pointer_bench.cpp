@@ -0,0 +1,154 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                    // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/hazard_pointer.hpp" // pl::thd::hazard_pointer
+#include <atomic>                                     // std::atomic
+#include <cstddef>                                    // std::size_t
+#include <cstdint>                                    // std::uint64_t
+#include <memory>                                     // std::unique_ptr
+#include <mutex>                                      // std::mutex
+#include <thread>                                     // std::thread
+#include <vector>                                     // std::vector
+
+namespace {
+constexpr std::uint64_t reads_per_thread{100000U};
+constexpr std::uint64_t reads_per_update{64U};
+
+class node : public pl::thd::hazard_pointer_obj_base<node> {
+public:
+    explicit node(std::uint64_t value) : m_value{value} {}
+
+    std::uint64_t m_value;
+};
+
+/*!
+ * \brief Read-mostly access to a shared object through hazard pointers.
+ *        The first thread replaces the object every reads_per_update reads.
+**/
+void hazard_pointer_read_mostly(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::atomic<node*> shared{new node{0U}};
+    std::vector<std::thread> threads{};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&shared, i] {
+                pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer()};
+                std::uint64_t           sum{0U};
+
+                for (std::uint64_t j{0U}; j < reads_per_thread; ++j) {
+                    if ((i == 0U) and ((j % reads_per_update) == 0U)) {
+                        shared.exchange(new node{j})->retire();
+                    }
+
+                    sum += hp.protect(shared)->m_value;
+                    hp.reset_protection();
+                }
+
+                pl::bench::do_not_optimize(sum);
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    shared.load()->retire();
+    pl::thd::hazard_pointer_default_domain().reclaim();
+    state.set_items_processed(
+        state.iterations() * thread_count * reads_per_thread);
+}
+
+PL_BENCHMARK_ARGS(hazard_pointer_read_mostly, 1, 2, 4, 8);
+
+/*!
+ * \brief The same workload as hazard_pointer_read_mostly, but with the
+ *        shared object protected by a mutex.
+**/
+void mutex_pointer_read_mostly(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::mutex               mutex{};
+    std::unique_ptr<node>    shared{new node{0U}};
+    std::vector<std::thread> threads{};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&mutex, &shared, i] {
+                std::uint64_t sum{0U};
+
+                for (std::uint64_t j{0U}; j < reads_per_thread; ++j) {
+                    if ((i == 0U) and ((j % reads_per_update) == 0U)) {
+                        std::unique_ptr<node> replacement{new node{j}};
+                        std::lock_guard<std::mutex> lock{mutex};
+                        shared.swap(replacement);
+                    }
+
+                    std::lock_guard<std::mutex> lock{mutex};
+                    sum += shared->m_value;
+                }
+
+                pl::bench::do_not_optimize(sum);
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    state.set_items_processed(
+        state.iterations() * thread_count * reads_per_thread);
+}
+
+PL_BENCHMARK_ARGS(mutex_pointer_read_mostly, 1, 2, 4, 8);
+
+/*!
+ * \brief Cost of protecting and releasing a pointer without contention.
+**/
+void hazard_pointer_protect(pl::bench::state& state)
+{
+    std::atomic<node*>      shared{new node{1U}};
+    pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer()};
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(hp.protect(shared)->m_value);
+        hp.reset_protection();
+    }
+
+    shared.load()->retire();
+    state.set_items_processed(state.iterations());
+}
+
+PL_BENCHMARK(hazard_pointer_protect);
+} // anonymous namespace
@@ -0,0 +1,83 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"             // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/monitor.hpp" // pl::thd::monitor
+#include <cstddef>                             // std::size_t
+#include <cstdint>                             // std::uint64_t
+#include <thread>                              // std::thread
+#include <vector>                              // std::vector
+
+namespace {
+/*!
+ * \brief Cost of an uncontended call through a monitor.
+**/
+void monitor_uncontended(pl::bench::state& state)
+{
+    pl::thd::monitor<std::uint64_t> monitor{0U};
+
+    while (state.keep_running()) {
+        monitor([](std::uint64_t& i) { ++i; });
+    }
+
+    state.set_items_processed(state.iterations());
+}
+
+PL_BENCHMARK(monitor_uncontended);
+
+/*!
+ * \brief Throughput of increments through a monitor depending on the amount
+ *        of threads contending for it.
+**/
+void monitor_contention(pl::bench::state& state)
+{
+    static constexpr std::uint64_t increments_per_thread{10000U};
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    pl::thd::monitor<std::uint64_t> monitor{0U};
+    std::vector<std::thread>        threads{};
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&monitor] {
+                for (std::uint64_t j{0U}; j < increments_per_thread; ++j) {
+                    monitor([](std::uint64_t& k) { ++k; });
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    state.set_items_processed(
+        state.iterations() * thread_count * increments_per_thread);
+}
+
+PL_BENCHMARK_ARGS(monitor_contention, 1, 2, 4, 8);
+} // anonymous namespace
@@ -0,0 +1,297 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                        // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/barrier.hpp"            // pl::thd::barrier
+#include "../../../include/pl/thd/counting_semaphore.hpp" // pl::thd::binary_semaphore
+#include "../../../include/pl/thd/latch.hpp"              // pl::thd::latch
+#include <condition_variable>                             // std::condition_variable
+#include <cstddef>                                        // std::size_t, std::ptrdiff_t
+#include <cstdint>                                        // std::uint64_t
+#include <mutex>                                          // std::mutex, std::unique_lock
+#include <thread>                                         // std::thread
+#include <vector>                                         // std::vector
+
+namespace {
+/*!
+ * \brief A latch built from a mutex and a condition variable.
+**/
+class condvar_latch {
+public:
+    explicit condvar_latch(std::ptrdiff_t expected)
+        : m_mutex{}, m_cv{}, m_counter{expected}
+    {
+    }
+
+    void count_down()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        if (--m_counter == 0) {
+            m_cv.notify_all();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_counter == 0; });
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::ptrdiff_t          m_counter;
+};
+
+/*!
+ * \brief A barrier built from a mutex and a condition variable.
+**/
+class condvar_barrier {
+public:
+    explicit condvar_barrier(std::ptrdiff_t expected)
+        : m_mutex{},
+          m_cv{},
+          m_expected{expected},
+          m_remaining{expected},
+          m_phase{0U}
+    {
+    }
+
+    void arrive_and_wait()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        const std::uint64_t          phase{m_phase};
+
+        if (--m_remaining == 0) {
+            m_remaining = m_expected;
+            ++m_phase;
+            m_cv.notify_all();
+            return;
+        }
+
+        m_cv.wait(lock, [this, phase] { return m_phase != phase; });
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::ptrdiff_t          m_expected;
+    std::ptrdiff_t          m_remaining;
+    std::uint64_t           m_phase;
+};
+
+/*!
+ * \brief A binary semaphore built from a mutex and a condition variable.
+**/
+class condvar_semaphore {
+public:
+    explicit condvar_semaphore(std::ptrdiff_t desired)
+        : m_mutex{}, m_cv{}, m_count{desired}
+    {
+    }
+
+    void release()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        ++m_count;
+        m_cv.notify_one();
+    }
+
+    void acquire()
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_cv.wait(lock, [this] { return m_count > 0; });
+        --m_count;
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+    std::ptrdiff_t          m_count;
+};
+
+constexpr int phases{1000};
+constexpr int round_trips{10000};
+
+/*!
+ * \brief Threads that count down a latch and wait for it.
+**/
+template <typename Latch>
+void latch_count_down_and_wait(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::vector<std::thread> threads{};
+
+    while (state.keep_running()) {
+        Latch latch{static_cast<std::ptrdiff_t>(thread_count)};
+
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&latch] {
+                latch.count_down();
+                latch.wait();
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    state.set_items_processed(state.iterations() * thread_count);
+}
+
+void latch_futex(pl::bench::state& state)
+{
+    latch_count_down_and_wait<pl::thd::latch>(state);
+}
+
+void latch_condvar(pl::bench::state& state)
+{
+    latch_count_down_and_wait<condvar_latch>(state);
+}
+
+PL_BENCHMARK_ARGS(latch_futex, 1, 2, 4, 8);
+PL_BENCHMARK_ARGS(latch_condvar, 1, 2, 4, 8);
+
+/*!
+ * \brief Threads that go through a barrier phases times.
+**/
+template <typename Barrier>
+void barrier_phases(pl::bench::state& state)
+{
+    const std::size_t thread_count{static_cast<std::size_t>(state.arg())};
+    std::vector<std::thread> threads{};
+
+    while (state.keep_running()) {
+        Barrier barrier{static_cast<std::ptrdiff_t>(thread_count)};
+
+        for (std::size_t i{0U}; i < thread_count; ++i) {
+            threads.emplace_back([&barrier] {
+                for (int phase{0}; phase < phases; ++phase) {
+                    barrier.arrive_and_wait();
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        threads.clear();
+    }
+
+    state.set_items_processed(
+        state.iterations() * static_cast<std::uint64_t>(phases));
+}
+
+void barrier_futex(pl::bench::state& state)
+{
+    barrier_phases<pl::thd::barrier<>>(state);
+}
+
+void barrier_condvar(pl::bench::state& state)
+{
+    barrier_phases<condvar_barrier>(state);
+}
+
+PL_BENCHMARK_ARGS(barrier_futex, 1, 2, 4, 8);
+PL_BENCHMARK_ARGS(barrier_condvar, 1, 2, 4, 8);
+
+/*!
+ * \brief Two threads handing control back and forth through two
+ *        semaphores.
+**/
+template <typename Semaphore>
+void semaphore_ping_pong(pl::bench::state& state)
+{
+    while (state.keep_running()) {
+        Semaphore ping{0};
+        Semaphore pong{0};
+
+        std::thread other{[&ping, &pong] {
+            for (int i{0}; i < round_trips; ++i) {
+                ping.acquire();
+                pong.release();
+            }
+        }};
+
+        for (int i{0}; i < round_trips; ++i) {
+            ping.release();
+            pong.acquire();
+        }
+
+        other.join();
+    }
+
+    state.set_items_processed(
+        state.iterations() * static_cast<std::uint64_t>(round_trips));
+}
+
+void semaphore_futex(pl::bench::state& state)
+{
+    semaphore_ping_pong<pl::thd::binary_semaphore>(state);
+}
+
+void semaphore_condvar(pl::bench::state& state)
+{
+    semaphore_ping_pong<condvar_semaphore>(state);
+}
+
+PL_BENCHMARK(semaphore_futex);
+PL_BENCHMARK(semaphore_condvar);
+
+/*!
+ * \brief Cost of an uncontended acquire and release.
+**/
+template <typename Semaphore>
+void semaphore_uncontended(pl::bench::state& state)
+{
+    Semaphore semaphore{1};
+
+    while (state.keep_running()) {
+        semaphore.acquire();
+        semaphore.release();
+    }
+
+    state.set_items_processed(state.iterations());
+}
+
+void semaphore_uncontended_futex(pl::bench::state& state)
+{
+    semaphore_uncontended<pl::thd::binary_semaphore>(state);
+}
+
+void semaphore_uncontended_condvar(pl::bench::state& state)
+{
+    semaphore_uncontended<condvar_semaphore>(state);
+}
+
+PL_BENCHMARK(semaphore_uncontended_futex);
+PL_BENCHMARK(semaphore_uncontended_condvar);
+} // anonymous namespace
@@ -0,0 +1,79 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                 // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/thread_pool.hpp" // pl::thd::thread_pool
+#include <cstddef>                                 // std::size_t
+#include <cstdint>                                 // std::uint64_t
+#include <future>                                  // std::future
+#include <vector>                                  // std::vector
+
+namespace {
+/*!
+ * \brief Latency of submitting a single task and waiting for its result.
+**/
+void thread_pool_submit_latency(pl::bench::state& state)
+{
+    pl::thd::thread_pool tp{1U};
+
+    while (state.keep_running()) {
+        std::future<int> fut{tp.add_task([] { return 1; })};
+        pl::bench::do_not_optimize(fut.get());
+    }
+
+    state.set_items_processed(state.iterations());
+}
+
+PL_BENCHMARK(thread_pool_submit_latency);
+
+/*!
+ * \brief Throughput of batches of small tasks depending on the amount of
+ *        threads in the thread_pool.
+**/
+void thread_pool_throughput(pl::bench::state& state)
+{
+    static constexpr std::size_t batch_size{1000U};
+    pl::thd::thread_pool tp{static_cast<std::size_t>(state.arg())};
+    std::vector<std::future<std::size_t>> futures{};
+    futures.reserve(batch_size);
+
+    while (state.keep_running()) {
+        for (std::size_t i{0U}; i < batch_size; ++i) {
+            futures.push_back(tp.add_task([i] { return i * i; }));
+        }
+
+        for (std::future<std::size_t>& fut : futures) {
+            pl::bench::do_not_optimize(fut.get());
+        }
+
+        futures.clear();
+    }
+
+    state.set_items_processed(state.iterations() * batch_size);
+}
+
+PL_BENCHMARK_ARGS(thread_pool_throughput, 1, 2, 4, 8, 16);
+} // anonymous namespace
@@ -0,0 +1,129 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/bench.hpp"                       // PL_BENCHMARK, pl::bench::state
+#include "../../../include/pl/thd/barrier.hpp"           // pl::thd::barrier
+#include "../../../include/pl/thd/thread_safe_queue.hpp" // pl::thd::thread_safe_queue
+#include <atomic>                                        // std::atomic
+#include <cstddef>                                       // std::size_t, std::ptrdiff_t
+#include <cstdint>                                       // std::uint64_t, std::int64_t
+#include <thread>                                        // std::thread
+#include <vector>                                        // std::vector
+
+namespace {
+/*!
+ * \brief Round trip latency of passing a value to another thread and back.
+**/
+void thread_safe_queue_ping_pong(pl::bench::state& state)
+{
+    pl::thd::thread_safe_queue<std::int64_t> ping{};
+    pl::thd::thread_safe_queue<std::int64_t> pong{};
+
+    std::thread echo{[&ping, &pong] {
+        for (;;) {
+            const std::int64_t value{ping.pop()};
+            pong.push(value);
+
+            if (value < 0) {
+                return;
+            }
+        }
+    }};
+
+    std::int64_t value{0};
+
+    while (state.keep_running()) {
+        ping.push(value);
+        value = pong.pop() + 1;
+    }
+
+    ping.push(-1);
+    (void)pong.pop();
+    echo.join();
+    state.set_items_processed(state.iterations());
+}
+
+PL_BENCHMARK(thread_safe_queue_ping_pong);
+
+/*!
+ * \brief Throughput of many producers pushing to a single consumer,
+ *        depending on the amount of producers.
+ *        The producers are started once and released together by a
+ *        barrier in every iteration, so that they contend for the queue
+ *        and starting threads is not measured.
+**/
+void thread_safe_queue_contention(pl::bench::state& state)
+{
+    static constexpr std::uint64_t items_per_producer{1000U};
+    const std::size_t producer_count{static_cast<std::size_t>(state.arg())};
+    pl::thd::thread_safe_queue<std::uint64_t> queue{};
+    pl::thd::barrier<>                        start{
+        static_cast<std::ptrdiff_t>(producer_count + 1U)};
+    std::atomic<bool>        is_done{false};
+    std::vector<std::thread> producers{};
+
+    for (std::size_t i{0U}; i < producer_count; ++i) {
+        producers.emplace_back([&queue, &start, &is_done] {
+            for (;;) {
+                start.arrive_and_wait();
+
+                if (is_done.load(std::memory_order_relaxed)) {
+                    return;
+                }
+
+                for (std::uint64_t j{0U}; j < items_per_producer; ++j) {
+                    queue.push(j);
+                }
+            }
+        });
+    }
+
+    while (state.keep_running()) {
+        start.arrive_and_wait();
+
+        std::uint64_t sum{0U};
+
+        for (std::uint64_t j{0U}; j < producer_count * items_per_producer;
+             ++j) {
+            sum += queue.pop();
+        }
+
+        pl::bench::do_not_optimize(sum);
+    }
+
+    is_done.store(true, std::memory_order_relaxed);
+    start.arrive_and_wait();
+
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+
+    state.set_items_processed(
+        state.iterations() * producer_count * items_per_producer);
+}
+
+PL_BENCHMARK_ARGS(thread_safe_queue_contention, 1, 2, 4, 8);
+} // anonymous namespace
@@ -0,0 +1,116 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../include/bench.hpp"             // PL_BENCHMARK_ARGS, pl::bench::state
+#include "../../include/pl/byte.hpp"        // pl::byte
+#include "../../include/pl/zero_memory.hpp" // pl::zero_memory, pl::secure_zero_memory, pl::zero_memory_policy
+#include <cstddef>                          // std::size_t
+#include <vector>                           // std::vector
+
+namespace {
+/*!
+ * \brief The previous implementation of secure_zero_memory, one volatile
+ *        byte store per iteration.
+**/
+void zero_memory_volatile_bytewise(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<pl::byte> buffer(byte_count, pl::byte{0x12});
+
+    while (state.keep_running()) {
+        volatile pl::byte* ptr{buffer.data()};
+
+        for (std::size_t i{0U}; i < byte_count; ++i) {
+            ptr[i] = 0U;
+        }
+
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+PL_BENCHMARK_ARGS(zero_memory_volatile_bytewise, 4, 1024, 262144);
+
+void secure_zero_memory(pl::bench::state& state)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<pl::byte> buffer(byte_count, pl::byte{0x12});
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(
+            pl::secure_zero_memory(buffer.data(), byte_count));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+PL_BENCHMARK_ARGS(secure_zero_memory, 4, 1024, 262144);
+
+/*!
+ * \brief Zeroes state.arg() KiB using 'policy'.
+**/
+void zero_memory_with(
+    pl::bench::state&      state,
+    pl::zero_memory_policy policy)
+{
+    const std::size_t byte_count{
+        static_cast<std::size_t>(state.arg()) * 1024U};
+    std::vector<pl::byte> buffer(byte_count, pl::byte{0x12});
+
+    while (state.keep_running()) {
+        pl::bench::do_not_optimize(
+            pl::zero_memory(buffer.data(), byte_count, policy));
+        pl::bench::clobber_memory();
+    }
+
+    state.set_bytes_processed(state.iterations() * byte_count);
+}
+
+void zero_memory_cached(pl::bench::state& state)
+{
+    zero_memory_with(state, pl::zero_memory_policy::cached);
+}
+
+PL_BENCHMARK_ARGS(zero_memory_cached, 4, 1024, 262144);
+
+void zero_memory_streaming(pl::bench::state& state)
+{
+    zero_memory_with(state, pl::zero_memory_policy::streaming);
+}
+
+PL_BENCHMARK_ARGS(zero_memory_streaming, 4, 1024, 262144);
+
+void zero_memory_automatic(pl::bench::state& state)
+{
+    zero_memory_with(state, pl::zero_memory_policy::automatic);
+}
+
+PL_BENCHMARK_ARGS(zero_memory_automatic, 4, 1024, 262144);
+} // anonymous namespace
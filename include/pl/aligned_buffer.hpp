@@ -0,0 +1,549 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file aligned_buffer.hpp
+ * \brief Exports the aligned_buffer type, an owning buffer of raw memory
+ *        with a large alignment that may be backed by huge pages, and the
+ *        aligned_allocator STL allocator.
+**/
+#ifndef INCG_PL_ALIGNED_BUFFER_HPP
+#define INCG_PL_ALIGNED_BUFFER_HPP
+#include "annotations.hpp" // PL_NODISCARD, PL_IN, PL_INOUT
+#include "assert.hpp"      // PL_DBG_CHECK_PRE
+#include "os.hpp"          // PL_OS, PL_OS_LINUX, PL_OS_WINDOWS
+#include <ciso646>         // and, not
+#include <cstddef>         // std::size_t, std::ptrdiff_t
+#include <cstdint>         // std::uintptr_t
+#include <limits>          // std::numeric_limits
+#include <new>             // std::bad_alloc
+#include <utility>         // std::swap, std::move
+#if PL_OS == PL_OS_LINUX
+#include <cstdlib>    // std::strtoull, posix_memalign, std::free
+#include <fstream>    // std::ifstream
+#include <string>     // std::string, std::getline
+#include <sys/mman.h> // mmap, munmap, madvise, MADV_HUGEPAGE
+#elif PL_OS == PL_OS_WINDOWS
+#include <malloc.h> // _aligned_malloc, _aligned_free
+#else
+#include <cstdlib> // posix_memalign, std::free
+#endif
+
+namespace pl {
+/*!
+ * \brief The size of a cache line on common hardware.
+**/
+constexpr std::size_t cache_line_size{64U};
+
+/*!
+ * \brief The size of a huge page on x86-64 and most AArch64 Linux systems.
+**/
+constexpr std::size_t huge_page_size{2U * 1024U * 1024U};
+
+/*!
+ * \brief Determines whether memory is backed by huge pages.
+**/
+enum class huge_page_policy {
+    automatic, /*!< use huge pages for allocations of at least
+                *   huge_page_size bytes.
+               **/
+    never,     //!< never use huge pages.
+    always     /*!< use huge pages regardless of the size, rounding it up to
+                *   a multiple of huge_page_size.
+               **/
+};
+
+/*!
+ * \brief Describes where the memory of an aligned_buffer was placed, to
+ *        check whether it is friendly to the TLB.
+**/
+struct aligned_buffer_placement {
+    bool is_mapped; //!< true if the memory was mapped rather than from the heap.
+    bool is_huge_page_aligned; //!< true if the memory begins at a huge page.
+    bool huge_pages_advised;   /*!< true if the kernel was successfully asked
+                                *   to back the memory with transparent huge
+                                *   pages.
+                               **/
+    std::size_t huge_page_bytes; /*!< the amount of bytes that the kernel
+                                  *   currently backs with transparent huge
+                                  *   pages, 0 if unknown.
+                                 **/
+};
+
+namespace detail {
+/*!
+ * \brief An allocation made by aligned_allocate. Not to be used directly.
+**/
+struct aligned_allocation {
+    void*       memory;
+    std::size_t mapped_size; //!< 0 if the memory is from the heap.
+    bool        huge_pages_advised;
+};
+
+PL_NODISCARD constexpr bool is_power_of_two(std::size_t value) noexcept
+{
+    return (value != 0U) and ((value & (value - 1U)) == 0U);
+}
+
+PL_NODISCARD constexpr std::size_t round_up(
+    std::size_t value,
+    std::size_t multiple) noexcept
+{
+    return ((value + multiple - 1U) / multiple) * multiple;
+}
+
+/*!
+ * \brief Determines whether an allocation of byte_count bytes is mapped
+ *        and backed by huge pages. Not to be used directly.
+**/
+PL_NODISCARD inline bool uses_mapping(
+    std::size_t      byte_count,
+    huge_page_policy policy) noexcept
+{
+#if PL_OS == PL_OS_LINUX
+    return (policy == huge_page_policy::always)
+           or ((policy == huge_page_policy::automatic)
+               and (byte_count >= huge_page_size));
+#else
+    static_cast<void>(byte_count);
+    static_cast<void>(policy);
+    return false;
+#endif
+}
+
+/*!
+ * \brief Allocates at least byte_count bytes aligned to alignment.
+ *        Not to be used directly.
+ * \throws std::bad_alloc if the memory could not be allocated.
+**/
+PL_NODISCARD inline aligned_allocation aligned_allocate(
+    std::size_t      byte_count,
+    std::size_t      alignment,
+    huge_page_policy policy)
+{
+    if (byte_count == 0U) {
+        byte_count = 1U;
+    }
+
+#if PL_OS == PL_OS_LINUX
+    if (uses_mapping(byte_count, policy)) {
+        const std::size_t size{round_up(byte_count, huge_page_size)};
+        const std::size_t align{
+            alignment < huge_page_size ? huge_page_size : alignment};
+
+        if (size > (std::numeric_limits<std::size_t>::max() - align)) {
+            throw std::bad_alloc{};
+        }
+
+        // over map, so that an aligned range can be cut out.
+        void* const raw{::mmap(
+            nullptr,
+            size + align,
+            PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS,
+            -1,
+            0)};
+
+        if (raw == MAP_FAILED) {
+            throw std::bad_alloc{};
+        }
+
+        const std::uintptr_t begin{reinterpret_cast<std::uintptr_t>(raw)};
+        const std::uintptr_t aligned{
+            static_cast<std::uintptr_t>(round_up(begin, align))};
+        const std::size_t head{static_cast<std::size_t>(aligned - begin)};
+        const std::size_t tail{align - head};
+        char* const       memory{reinterpret_cast<char*>(aligned)};
+
+        if (head != 0U) {
+            (void)::munmap(raw, head);
+        }
+
+        if (tail != 0U) {
+            (void)::munmap(memory + size, tail);
+        }
+
+        bool advised{false};
+#ifdef MADV_HUGEPAGE
+        advised = ::madvise(memory, size, MADV_HUGEPAGE) == 0;
+#endif
+        return aligned_allocation{memory, size, advised};
+    }
+#else
+    static_cast<void>(policy);
+#endif
+
+#if PL_OS == PL_OS_WINDOWS
+    void* const memory{::_aligned_malloc(byte_count, alignment)};
+
+    if (memory == nullptr) {
+        throw std::bad_alloc{};
+    }
+#else
+    void* memory{nullptr};
+
+    if (::posix_memalign(
+            &memory,
+            alignment < sizeof(void*) ? sizeof(void*) : alignment,
+            byte_count)
+        != 0) {
+        throw std::bad_alloc{};
+    }
+#endif
+
+    return aligned_allocation{memory, 0U, false};
+}
+
+/*!
+ * \brief Frees an allocation made by aligned_allocate.
+ *        Not to be used directly.
+**/
+inline void aligned_deallocate(const aligned_allocation& allocation) noexcept
+{
+    if (allocation.memory == nullptr) {
+        return;
+    }
+
+#if PL_OS == PL_OS_LINUX
+    if (allocation.mapped_size != 0U) {
+        (void)::munmap(allocation.memory, allocation.mapped_size);
+        return;
+    }
+#endif
+
+#if PL_OS == PL_OS_WINDOWS
+    ::_aligned_free(allocation.memory);
+#else
+    std::free(allocation.memory);
+#endif
+}
+
+/*!
+ * \brief Returns the amount of bytes of the mappings overlapping
+ *        ['begin', 'end') that the kernel backs with transparent huge
+ *        pages, according to /proc/self/smaps. Not to be used directly.
+**/
+PL_NODISCARD inline std::size_t huge_page_bytes(
+    std::uintptr_t begin,
+    std::uintptr_t end)
+{
+    std::size_t total{0U};
+#if PL_OS == PL_OS_LINUX
+    static constexpr char field[] = "AnonHugePages:";
+    std::ifstream         smaps{"/proc/self/smaps"};
+    std::string           line{};
+    bool                  overlaps{false};
+
+    while (std::getline(smaps, line)) {
+        char*                    parsed{nullptr};
+        const unsigned long long first{
+            std::strtoull(line.c_str(), &parsed, 16)};
+
+        // the header of a mapping looks like: 7f0000000000-7f0000200000 ...
+        if (*parsed == '-') {
+            const unsigned long long last{
+                std::strtoull(parsed + 1, nullptr, 16)};
+            overlaps = (first < end) and (last > begin);
+        }
+        else if (
+            overlaps and (line.compare(0U, sizeof(field) - 1U, field) == 0)) {
+            total += static_cast<std::size_t>(std::strtoull(
+                         line.c_str() + sizeof(field) - 1U, nullptr, 10))
+                     * 1024U;
+        }
+    }
+#else
+    static_cast<void>(begin);
+    static_cast<void>(end);
+#endif
+    return total;
+}
+} // namespace detail
+
+/*!
+ * \brief An owning buffer of raw memory aligned to a power of two, a cache
+ *        line by default.
+ *
+ * On Linux large buffers are mapped directly, aligned to huge_page_size
+ * and the kernel is asked to back them with transparent huge pages, which
+ * reduces TLB misses when accessing large working sets.
+ * Use placement to check where the memory ended up.
+ *
+ * Typed views can be created with raw_memory_array:
+ * \code
+ * pl::aligned_buffer              buffer{1024U * sizeof(float)};
+ * pl::raw_memory_array<float> view{
+ *     buffer.data(), buffer.size(), pl::default_init_t{}};
+ * \endcode
+**/
+class aligned_buffer {
+public:
+    using this_type = aligned_buffer;
+    using size_type = std::size_t;
+
+    /*!
+     * \brief Creates an empty aligned_buffer.
+    **/
+    aligned_buffer() noexcept
+        : m_allocation{nullptr, 0U, false}, m_size{0U}, m_alignment{0U}
+    {
+    }
+
+    /*!
+     * \brief Allocates an aligned_buffer of uninitialized memory.
+     * \param byte_count The size of the buffer in bytes.
+     * \param alignment The alignment of the buffer, must be a power of two.
+     * \param policy Determines whether the buffer is backed by huge pages.
+     * \throws std::bad_alloc if the memory could not be allocated.
+     * \throws pl::precondition_violation_exception if alignment is not a
+     *         power of two (debug mode only).
+     * \note Mapped buffers are aligned to at least huge_page_size.
+    **/
+    explicit aligned_buffer(
+        size_type        byte_count,
+        size_type        alignment = cache_line_size,
+        huge_page_policy policy    = huge_page_policy::automatic)
+        : m_allocation{nullptr, 0U, false},
+          m_size{byte_count},
+          m_alignment{alignment}
+    {
+        PL_DBG_CHECK_PRE(detail::is_power_of_two(alignment));
+        m_allocation = detail::aligned_allocate(byte_count, alignment, policy);
+    }
+
+    /*!
+     * \brief Takes the memory of other, leaving it empty.
+     * \param other The aligned_buffer to move from.
+    **/
+    aligned_buffer(PL_INOUT this_type&& other) noexcept
+        : m_allocation{other.m_allocation},
+          m_size{other.m_size},
+          m_alignment{other.m_alignment}
+    {
+        other.m_allocation = detail::aligned_allocation{nullptr, 0U, false};
+        other.m_size       = 0U;
+        other.m_alignment  = 0U;
+    }
+
+    /*!
+     * \brief Frees the memory of this aligned_buffer and takes the memory
+     *        of other, leaving it empty.
+     * \param other The aligned_buffer to move from.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(PL_INOUT this_type&& other) noexcept
+    {
+        this_type temporary{std::move(other)};
+        swap(temporary);
+        return *this;
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    aligned_buffer(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Frees the memory.
+    **/
+    ~aligned_buffer() { detail::aligned_deallocate(m_allocation); }
+    /*!
+     * \brief Returns a pointer to the memory, nullptr if empty.
+    **/
+    PL_NODISCARD void* data() const noexcept { return m_allocation.memory; }
+    /*!
+     * \brief Returns the size of the buffer in bytes, as requested.
+    **/
+    PL_NODISCARD size_type size() const noexcept { return m_size; }
+    /*!
+     * \brief Returns the alignment requested.
+    **/
+    PL_NODISCARD size_type alignment() const noexcept { return m_alignment; }
+    /*!
+     * \brief Checks whether this aligned_buffer owns no memory.
+    **/
+    PL_NODISCARD bool empty() const noexcept
+    {
+        return m_allocation.memory == nullptr;
+    }
+
+    /*!
+     * \brief Reports where the memory was placed.
+     * \note Reads /proc/self/smaps on Linux if the memory is mapped,
+     *       which is slow.
+    **/
+    PL_NODISCARD aligned_buffer_placement placement() const
+    {
+        const std::uintptr_t begin{
+            reinterpret_cast<std::uintptr_t>(m_allocation.memory)};
+        const bool is_mapped{m_allocation.mapped_size != 0U};
+
+        return aligned_buffer_placement{
+            is_mapped,
+            (not empty()) and ((begin % huge_page_size) == 0U),
+            m_allocation.huge_pages_advised,
+            is_mapped ? detail::huge_page_bytes(begin, begin + m_size) : 0U};
+    }
+
+    /*!
+     * \brief Exchanges the memory of this aligned_buffer with the one of
+     *        other.
+     * \param other The other aligned_buffer.
+    **/
+    void swap(PL_INOUT this_type& other) noexcept
+    {
+        using std::swap;
+        swap(m_allocation, other.m_allocation);
+        swap(m_size, other.m_size);
+        swap(m_alignment, other.m_alignment);
+    }
+
+private:
+    detail::aligned_allocation m_allocation;
+    size_type                  m_size;
+    size_type                  m_alignment;
+};
+
+/*!
+ * \brief Exchanges the memory of 'lhs' and 'rhs'.
+ * \param lhs The first operand.
+ * \param rhs The second operand.
+**/
+inline void swap(PL_INOUT aligned_buffer& lhs, PL_INOUT aligned_buffer& rhs)
+    noexcept
+{
+    lhs.swap(rhs);
+}
+
+/*!
+ * \brief An STL compatible allocator that aligns every allocation to
+ *        Alignment, a cache line by default. On Linux allocations of at
+ *        least huge_page_size bytes are backed by huge pages, as with
+ *        aligned_buffer.
+ *
+ * Example:
+ * \code
+ * std::vector<float, pl::aligned_allocator<float>> vector{};
+ * \endcode
+**/
+template <typename Ty, std::size_t Alignment = cache_line_size>
+class aligned_allocator {
+public:
+    static_assert(
+        detail::is_power_of_two(Alignment),
+        "Alignment must be a power of two.");
+    static_assert(
+        Alignment >= alignof(Ty),
+        "Alignment must not be less than the alignment of the type.");
+
+    using this_type       = aligned_allocator;
+    using value_type      = Ty;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename Other>
+    struct rebind {
+        using other = aligned_allocator<Other, Alignment>;
+    };
+
+    /*!
+     * \brief Creates an aligned_allocator.
+    **/
+    aligned_allocator() noexcept = default;
+
+    /*!
+     * \brief Creates an aligned_allocator from an aligned_allocator of a
+     *        different type.
+    **/
+    template <typename Other>
+    aligned_allocator(PL_IN const aligned_allocator<Other, Alignment>&) noexcept
+    {
+    }
+
+    /*!
+     * \brief Allocates aligned memory for count objects of type Ty.
+     * \param count The amount of objects.
+     * \return Pointer to the uninitialized memory.
+     * \throws std::bad_alloc if the memory could not be allocated.
+    **/
+    PL_NODISCARD Ty* allocate(size_type count)
+    {
+        if (count > (std::numeric_limits<size_type>::max() / sizeof(Ty))) {
+            throw std::bad_alloc{};
+        }
+
+        return static_cast<Ty*>(detail::aligned_allocate(
+                                    count * sizeof(Ty),
+                                    Alignment,
+                                    huge_page_policy::automatic)
+                                    .memory);
+    }
+
+    /*!
+     * \brief Frees memory returned by allocate.
+     * \param pointer The memory to free.
+     * \param count The count passed to allocate.
+    **/
+    void deallocate(Ty* pointer, size_type count) noexcept
+    {
+        const size_type byte_count{count * sizeof(Ty)};
+        detail::aligned_deallocate(detail::aligned_allocation{
+            pointer,
+            detail::uses_mapping(byte_count, huge_page_policy::automatic)
+                ? detail::round_up(byte_count, huge_page_size)
+                : 0U,
+            false});
+    }
+};
+
+/*!
+ * \brief aligned_allocators are stateless and always compare equal.
+**/
+template <typename Ty, typename Other, std::size_t Alignment>
+PL_NODISCARD bool operator==(
+    PL_IN const aligned_allocator<Ty, Alignment>&,
+    PL_IN const aligned_allocator<Other, Alignment>&) noexcept
+{
+    return true;
+}
+
+/*!
+ * \brief aligned_allocators are stateless and always compare equal.
+**/
+template <typename Ty, typename Other, std::size_t Alignment>
+PL_NODISCARD bool operator!=(
+    PL_IN const aligned_allocator<Ty, Alignment>&,
+    PL_IN const aligned_allocator<Other, Alignment>&) noexcept
+{
+    return false;
+}
+} // namespace pl
+#endif // INCG_PL_ALIGNED_BUFFER_HPP
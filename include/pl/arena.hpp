@@ -0,0 +1,454 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file arena.hpp
+ * \brief Exports the arena type, a monotonic bump allocator, and the
+ *        arena_allocator STL allocator adapter.
+**/
+#ifndef INCG_PL_ARENA_HPP
+#define INCG_PL_ARENA_HPP
+#include "annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "assert.hpp"      // PL_DBG_CHECK_PRE
+#include <ciso646>         // not, and
+#include <cstddef>         // std::size_t, std::ptrdiff_t, std::max_align_t
+#include <limits>          // std::numeric_limits
+#include <memory>          // std::align
+#include <new>             // ::operator new, ::operator delete, std::bad_alloc
+#include <utility>         // std::forward
+
+namespace pl {
+namespace detail {
+/*!
+ * \brief The constants of arena, in a class template so that they can be
+ *        defined in this header in C++14. Not to be used directly.
+**/
+template <typename = void>
+struct arena_constants {
+    /*!
+     * \brief The size of the blocks allocated from the heap by default.
+    **/
+    static constexpr std::size_t default_block_size{4096U};
+};
+
+template <typename Ty>
+constexpr std::size_t arena_constants<Ty>::default_block_size;
+} // namespace detail
+
+/*!
+ * \brief A monotonic allocator that hands out memory by bumping a pointer
+ *        through a chain of blocks.
+ *
+ * Individual allocations are never freed, instead all of them are released
+ * at once by reset, which rewinds to the first block in constant time and
+ * keeps the blocks allocated from the heap for reuse, or by release, which
+ * gives them back to the heap. The first block can be a buffer provided by
+ * the caller, for instance one allocated on the stack using PL_ALLOCA, in
+ * which case no heap allocation takes place until it is exhausted.
+ *
+ * Example:
+ * \code
+ * void* const buffer{PL_ALLOCA(1024)};
+ * pl::arena   arena{buffer, 1024};
+ * std::vector<int, pl::arena_allocator<int>> vector{
+ *     pl::arena_allocator<int>{arena}};
+ * void* raw{arena.allocate(n * sizeof(int), alignof(int))};
+ * pl::raw_memory_array<int> array{raw, n * sizeof(int)};
+ * \endcode
+ * \warning Objects created in an arena are not destroyed by the arena.
+**/
+class arena : public detail::arena_constants<> {
+public:
+    using this_type = arena;
+    using size_type = std::size_t;
+    using detail::arena_constants<>::default_block_size;
+
+    /*!
+     * \brief Creates an arena that allocates all of its memory from the heap.
+     * \param block_size The minimum size of the blocks allocated from the
+     *                   heap.
+    **/
+    explicit arena(size_type block_size = default_block_size) noexcept
+        : arena{nullptr, 0U, block_size}
+    {
+    }
+
+    /*!
+     * \brief Creates an arena that uses initial_buffer as its first block.
+     * \param initial_buffer The buffer to allocate from first. Must outlive
+     *                       the arena.
+     * \param initial_size The size of initial_buffer in bytes.
+     * \param block_size The minimum size of the blocks allocated from the
+     *                   heap once initial_buffer is exhausted.
+    **/
+    arena(
+        void*     initial_buffer,
+        size_type initial_size,
+        size_type block_size = default_block_size) noexcept
+        : m_initial_buffer{static_cast<char*>(initial_buffer)},
+          m_initial_size{initial_buffer == nullptr ? 0U : initial_size},
+          m_block_size{block_size == 0U ? default_block_size : block_size},
+          m_first_block{nullptr},
+          m_current_block{nullptr},
+          m_cursor{nullptr},
+          m_end{nullptr},
+          m_bytes_used{0U},
+          m_high_water_mark{0U},
+          m_capacity{m_initial_size},
+          m_block_count{0U}
+    {
+        rewind();
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    arena(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Frees the blocks allocated from the heap.
+    **/
+    ~arena() { free_blocks(); }
+
+    /*!
+     * \brief Allocates memory.
+     * \param byte_count The amount of bytes to allocate.
+     * \param alignment The alignment of the memory, must be a power of two.
+     * \return Pointer to the memory allocated.
+     * \throws std::bad_alloc if a new block could not be allocated.
+     * \throws pl::precondition_violation_exception if alignment is not a
+     *         power of two (debug mode only).
+     * \note Amortized constant complexity.
+    **/
+    PL_NODISCARD void* allocate(
+        size_type byte_count,
+        size_type alignment = alignof(std::max_align_t))
+    {
+        PL_DBG_CHECK_PRE(
+            (alignment != 0U) and ((alignment & (alignment - 1U)) == 0U));
+
+        if (byte_count == 0U) {
+            byte_count = 1U;
+        }
+
+        void*     result{m_cursor};
+        size_type space{static_cast<size_type>(m_end - m_cursor)};
+
+        if (std::align(alignment, byte_count, result, space) == nullptr) {
+            next_block(byte_count, alignment);
+            result = m_cursor;
+            space  = static_cast<size_type>(m_end - m_cursor);
+            (void)std::align(alignment, byte_count, result, space);
+        }
+
+        char* const new_cursor{static_cast<char*>(result) + byte_count};
+        m_bytes_used += static_cast<size_type>(new_cursor - m_cursor);
+        m_cursor = new_cursor;
+
+        if (m_bytes_used > m_high_water_mark) {
+            m_high_water_mark = m_bytes_used;
+        }
+
+        return result;
+    }
+
+    /*!
+     * \brief Does nothing, memory is only reclaimed by reset and release.
+     *        Exists for symmetry with allocate.
+    **/
+    void deallocate(void*, size_type) noexcept {}
+
+    /*!
+     * \brief Allocates memory for an object of type Type and constructs it.
+     * \param args The arguments to forward to the constructor.
+     * \return Pointer to the newly created object.
+     * \warning The arena does not call the destructor of the object.
+    **/
+    template <typename Type, typename... Args>
+    PL_NODISCARD Type* create(Args&&... args)
+    {
+        return ::new (allocate(sizeof(Type), alignof(Type)))
+            Type(std::forward<Args>(args)...);
+    }
+
+    /*!
+     * \brief Makes all the memory of the arena available again, without
+     *        giving the blocks allocated from the heap back.
+     * \warning Invalidates all the memory allocated.
+     * \note Constant complexity.
+    **/
+    void reset() noexcept
+    {
+        m_bytes_used = 0U;
+        rewind();
+    }
+
+    /*!
+     * \brief Like reset, but also gives the blocks allocated from the heap
+     *        back.
+     * \warning Invalidates all the memory allocated.
+    **/
+    void release() noexcept
+    {
+        free_blocks();
+        m_first_block = nullptr;
+        m_capacity    = m_initial_size;
+        m_block_count = 0U;
+        reset();
+    }
+
+    /*!
+     * \brief Returns the amount of bytes allocated since the last reset,
+     *        including padding for alignment.
+    **/
+    PL_NODISCARD size_type bytes_used() const noexcept { return m_bytes_used; }
+
+    /*!
+     * \brief Returns the highest value bytes_used ever reached.
+    **/
+    PL_NODISCARD size_type high_water_mark() const noexcept
+    {
+        return m_high_water_mark;
+    }
+
+    /*!
+     * \brief Returns the total size of the initial buffer and the blocks
+     *        allocated from the heap.
+    **/
+    PL_NODISCARD size_type capacity() const noexcept { return m_capacity; }
+
+    /*!
+     * \brief Returns the amount of blocks allocated from the heap.
+    **/
+    PL_NODISCARD size_type block_count() const noexcept
+    {
+        return m_block_count;
+    }
+
+private:
+    /*!
+     * \brief Header of a block allocated from the heap, the usable memory
+     *        follows it directly.
+    **/
+    struct block {
+        block*    next;
+        size_type size;
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    void rewind() noexcept
+    {
+        m_current_block = nullptr;
+
+        if (m_initial_size != 0U) {
+            m_cursor = m_initial_buffer;
+            m_end    = m_initial_buffer + m_initial_size;
+        }
+        else if (m_first_block != nullptr) {
+            use_block(m_first_block);
+        }
+        else {
+            m_cursor = nullptr;
+            m_end    = nullptr;
+        }
+    }
+
+    void use_block(PL_IN block* b) noexcept
+    {
+        m_current_block = b;
+        m_cursor        = b->data();
+        m_end           = b->data() + b->size;
+    }
+
+    /*!
+     * \brief Moves on to the next block that can hold byte_count bytes with
+     *        the alignment given, allocating a new one if need be.
+    **/
+    void next_block(size_type byte_count, size_type alignment)
+    {
+        if (byte_count > (std::numeric_limits<size_type>::max() / 2U)) {
+            throw std::bad_alloc{};
+        }
+
+        const size_type needed{byte_count + alignment - 1U};
+        // the blocks after the current one have been used before a reset.
+        block* const next{
+            m_current_block == nullptr ? m_first_block
+                                       : m_current_block->next};
+
+        if ((next != nullptr) and (next->size >= needed)) {
+            use_block(next);
+            return;
+        }
+
+        const size_type size{needed > m_block_size ? needed : m_block_size};
+        block* const    b{static_cast<block*>(
+            ::operator new(sizeof(block) + size))};
+        b->next = next;
+        b->size = size;
+
+        if (m_current_block == nullptr) {
+            m_first_block = b;
+        }
+        else {
+            m_current_block->next = b;
+        }
+
+        m_capacity += size;
+        ++m_block_count;
+        use_block(b);
+    }
+
+    void free_blocks() noexcept
+    {
+        block* b{m_first_block};
+
+        while (b != nullptr) {
+            block* const next{b->next};
+            ::operator delete(b);
+            b = next;
+        }
+    }
+
+    char*     m_initial_buffer;
+    size_type m_initial_size;
+    size_type m_block_size;
+    block*    m_first_block;
+    block*    m_current_block; //!< nullptr while in the initial buffer
+    char*     m_cursor;
+    char*     m_end;
+    size_type m_bytes_used;
+    size_type m_high_water_mark;
+    size_type m_capacity;
+    size_type m_block_count;
+};
+
+/*!
+ * \brief An STL compatible allocator that allocates from an arena.
+ *        Deallocation does nothing, the memory is reclaimed when the arena
+ *        is reset.
+ *
+ * Example:
+ * \code
+ * pl::arena arena{};
+ * std::vector<int, pl::arena_allocator<int>> vector{
+ *     pl::arena_allocator<int>{arena}};
+ * \endcode
+**/
+template <typename Type>
+class arena_allocator {
+public:
+    template <typename Other>
+    friend class arena_allocator;
+
+    using this_type       = arena_allocator;
+    using value_type      = Type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename Other>
+    struct rebind {
+        using other = arena_allocator<Other>;
+    };
+
+    /*!
+     * \brief Creates an arena_allocator allocating from the arena given.
+     * \param source The arena to allocate from, must outlive all the copies
+     *               of this arena_allocator.
+    **/
+    explicit arena_allocator(PL_INOUT ::pl::arena& source) noexcept
+        : m_arena{&source}
+    {
+    }
+
+    /*!
+     * \brief Creates an arena_allocator using the arena of other.
+    **/
+    template <typename Other>
+    arena_allocator(PL_IN const arena_allocator<Other>& other) noexcept
+        : m_arena{other.m_arena}
+    {
+    }
+
+    /*!
+     * \brief Allocates memory for count objects of type Type.
+     * \param count The amount of objects.
+     * \return Pointer to the uninitialized memory.
+     * \throws std::bad_alloc if the arena could not allocate.
+    **/
+    PL_NODISCARD Type* allocate(size_type count)
+    {
+        if (count > (std::numeric_limits<size_type>::max() / sizeof(Type))) {
+            throw std::bad_alloc{};
+        }
+
+        return static_cast<Type*>(
+            m_arena->allocate(count * sizeof(Type), alignof(Type)));
+    }
+
+    /*!
+     * \brief Does nothing.
+    **/
+    void deallocate(Type*, size_type) noexcept {}
+
+    /*!
+     * \brief Returns the arena allocated from.
+    **/
+    PL_NODISCARD ::pl::arena& arena() const noexcept { return *m_arena; }
+
+private:
+    ::pl::arena* m_arena;
+};
+
+/*!
+ * \brief Two arena_allocators compare equal if they use the same arena.
+**/
+template <typename Type1, typename Type2>
+bool operator==(
+    PL_IN const arena_allocator<Type1>& lhs,
+    PL_IN const arena_allocator<Type2>& rhs) noexcept
+{
+    return &lhs.arena() == &rhs.arena();
+}
+
+/*!
+ * \brief Two arena_allocators compare equal if they use the same arena.
+**/
+template <typename Type1, typename Type2>
+bool operator!=(
+    PL_IN const arena_allocator<Type1>& lhs,
+    PL_IN const arena_allocator<Type2>& rhs) noexcept
+{
+    return not(lhs == rhs);
+}
+} // namespace pl
+#endif // INCG_PL_ARENA_HPP
@@ -31,11 +31,57 @@
 #ifndef INCG_PL_BIT_HPP
 #define INCG_PL_BIT_HPP
 #include "annotations.hpp" // PL_INOUT, PL_IN
-#include "compiler.hpp" // PL_COMPILER, PL_COMPILER_MSVC, PL_COMPILER_VERSION, PL_COMPILER_VERSION_CHECK
+#include "compiler.hpp"    // PL_COMPILER, PL_COMPILER_MSVC, PL_COMPILER_VERSION, PL_COMPILER_VERSION_CHECK
 #include "type_traits.hpp" // pl::remove_const_t
+#include <ciso646>         // and, not
+#include <cstddef>         // std::size_t
+#include <cstdint>         // std::uint8_t, std::uint64_t, UINT64_C
 #include <cstring>         // std::memcpy
+#include <limits>          // std::numeric_limits
 #include <memory>          // std::addressof
-#include <type_traits> // std::is_unsigned, std::is_trivially_copyable, std::is_trivial
+#include <type_traits>     // std::is_unsigned, std::is_same, std::is_trivially_copyable, std::is_trivial, std::integral_constant
+#if defined(__BMI2__)
+#include <immintrin.h> // _pdep_u32, _pext_u32, _pdep_u64, _pext_u64
+#endif
+
+/*!
+ * \def PL_DETAIL_BIT_CONSTEXPR
+ * \brief constexpr, unless the compiler doesn't support C++14 constexpr
+ *        functions. Not to be used directly.
+**/
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+#define PL_DETAIL_BIT_CONSTEXPR constexpr
+#else
+#define PL_DETAIL_BIT_CONSTEXPR inline
+#endif
+
+/*!
+ * \def PL_DETAIL_BIT_GNU_BUILTINS
+ * \brief 1 if the __builtin_clz family of functions, which can be used in
+ *        constant expressions, is available, 0 otherwise.
+ *        Not to be used directly.
+**/
+#if (PL_COMPILER == PL_COMPILER_GCC) || (PL_COMPILER == PL_COMPILER_CLANG)
+#define PL_DETAIL_BIT_GNU_BUILTINS 1
+#else
+#define PL_DETAIL_BIT_GNU_BUILTINS 0
+#endif
+
+/*!
+ * \def PL_DETAIL_BIT_USE_BMI2
+ * \brief 1 if the BMI2 pdep and pext instructions may be used, which
+ *        requires them to be enabled at compile time (e.g. -mbmi2) and a
+ *        way to tell whether a function is being constant evaluated,
+ *        0 otherwise. Not to be used directly.
+**/
+#define PL_DETAIL_BIT_USE_BMI2 0
+#if defined(__BMI2__) && defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#undef PL_DETAIL_BIT_USE_BMI2
+#define PL_DETAIL_BIT_USE_BMI2 1
+#endif
+#endif
 
 namespace pl {
 /*!
@@ -179,5 +225,449 @@ inline To bit_cast(PL_IN const From& from) noexcept
     std::memcpy(std::addressof(to), std::addressof(from), sizeof(To));
     return to;
 }
+
+namespace detail {
+/*!
+ * \brief Whether Ty can be used with the bit manipulation functions below,
+ *        which take unsigned integers of up to 64 bits, except for bool.
+ *        Not to be used directly.
+**/
+template<typename Ty>
+struct is_bit_operand
+    : public std::integral_constant<
+          bool,
+          std::is_unsigned<Ty>::value and (not std::is_same<Ty, bool>::value)
+              and (sizeof(Ty) <= sizeof(std::uint64_t))> {
+};
+
+/*!
+ * \brief Counts the set bits using a SWAR reduction.
+ *        Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR int popcount_fallback(std::uint64_t value) noexcept
+{
+    // sum adjacent bit fields of doubling width in parallel.
+    value -= (value >> 1U) & UINT64_C(0x5555555555555555);
+    value = (value & UINT64_C(0x3333333333333333))
+            + ((value >> 2U) & UINT64_C(0x3333333333333333));
+    value = (value + (value >> 4U)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return static_cast<int>((value * UINT64_C(0x0101010101010101)) >> 56U);
+}
+
+/*!
+ * \brief Counts the set bits of a 64 bit value. Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR int popcount64(std::uint64_t value) noexcept
+{
+    // without the popcnt instruction the builtin calls into libgcc, which is
+    // slower than the inline fallback.
+#if PL_DETAIL_BIT_GNU_BUILTINS && defined(__POPCNT__)
+    return __builtin_popcountll(value);
+#else
+    return popcount_fallback(value);
+#endif
+}
+
+/*!
+ * \brief Counts the leading zero bits of a non-zero 64 bit value.
+ *        Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR int countl_zero64(std::uint64_t value) noexcept
+{
+#if PL_DETAIL_BIT_GNU_BUILTINS
+    return __builtin_clzll(value);
+#else
+    int count{0};
+
+    for (int shift{32}; shift != 0; shift /= 2) {
+        if ((value >> (64 - shift)) == 0U) {
+            count += shift;
+            value <<= shift;
+        }
+    }
+
+    return count;
+#endif
+}
+
+/*!
+ * \brief Counts the trailing zero bits of a non-zero 64 bit value.
+ *        Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR int countr_zero64(std::uint64_t value) noexcept
+{
+#if PL_DETAIL_BIT_GNU_BUILTINS
+    return __builtin_ctzll(value);
+#else
+    // the bits below the lowest set one.
+    return popcount64(~value & (value - 1U));
+#endif
+}
+
+/*!
+ * \brief Deposits the low bits of 'value' at the positions of the set bits
+ *        of 'mask', one bit at a time. Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR std::uint64_t pdep_fallback(
+    std::uint64_t value,
+    std::uint64_t mask) noexcept
+{
+    std::uint64_t result{0U};
+
+    for (std::uint64_t bit{1U}; mask != 0U; bit <<= 1U) {
+        if ((value & bit) != 0U) {
+            result |= mask & (~mask + 1U);
+        }
+
+        mask &= mask - 1U;
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Gathers the bits of 'value' at the positions of the set bits of
+ *        'mask' into the low bits, one bit at a time.
+ *        Not to be used directly.
+**/
+PL_DETAIL_BIT_CONSTEXPR std::uint64_t pext_fallback(
+    std::uint64_t value,
+    std::uint64_t mask) noexcept
+{
+    std::uint64_t result{0U};
+
+    for (std::uint64_t bit{1U}; mask != 0U; bit <<= 1U) {
+        if ((value & mask & (~mask + 1U)) != 0U) {
+            result |= bit;
+        }
+
+        mask &= mask - 1U;
+    }
+
+    return result;
+}
+} // namespace detail
+
+/*!
+ * \brief Counts the bits set in 'value'.
+ * \param value The unsigned integer to examine.
+ * \return The amount of 1 bits in 'value'.
+ * \note Like std::popcount from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int popcount(Unsigned value) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::popcount should be an unsigned integer type.");
+
+    return detail::popcount64(static_cast<std::uint64_t>(value));
+}
+
+/*!
+ * \brief Counts the consecutive 0 bits, starting from the most significant
+ *        bit.
+ * \param value The unsigned integer to examine.
+ * \return The amount of leading 0 bits, the bit width of Unsigned if
+ *         'value' is 0.
+ * \note Like std::countl_zero from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int countl_zero(Unsigned value) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::countl_zero should be an unsigned integer type.");
+
+    constexpr int digits{std::numeric_limits<Unsigned>::digits};
+
+    if (value == 0U) {
+        return digits;
+    }
+
+    return detail::countl_zero64(static_cast<std::uint64_t>(value))
+           - (64 - digits);
+}
+
+/*!
+ * \brief Counts the consecutive 1 bits, starting from the most significant
+ *        bit.
+ * \param value The unsigned integer to examine.
+ * \return The amount of leading 1 bits.
+ * \note Like std::countl_one from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int countl_one(Unsigned value) noexcept
+{
+    return ::pl::countl_zero(static_cast<Unsigned>(~value));
+}
+
+/*!
+ * \brief Counts the consecutive 0 bits, starting from the least
+ *        significant bit.
+ * \param value The unsigned integer to examine.
+ * \return The amount of trailing 0 bits, the bit width of Unsigned if
+ *         'value' is 0.
+ * \note Like std::countr_zero from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int countr_zero(Unsigned value) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::countr_zero should be an unsigned integer type.");
+
+    if (value == 0U) {
+        return std::numeric_limits<Unsigned>::digits;
+    }
+
+    return detail::countr_zero64(static_cast<std::uint64_t>(value));
+}
+
+/*!
+ * \brief Counts the consecutive 1 bits, starting from the least
+ *        significant bit.
+ * \param value The unsigned integer to examine.
+ * \return The amount of trailing 1 bits.
+ * \note Like std::countr_one from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int countr_one(Unsigned value) noexcept
+{
+    return ::pl::countr_zero(static_cast<Unsigned>(~value));
+}
+
+/*!
+ * \brief Rotates the bits of 'value' to the right.
+ * \param value The unsigned integer to rotate.
+ * \param shift The amount of positions to rotate by. A negative amount
+ *              rotates to the left.
+ * \return The rotated value.
+ * \note Like std::rotr from C++20. Compiles to a single instruction on
+ *       common platforms.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned rotr(Unsigned value, int shift) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::rotr should be an unsigned integer type.");
+
+    constexpr int digits{std::numeric_limits<Unsigned>::digits};
+    int           remainder{shift % digits};
+
+    if (remainder < 0) {
+        remainder += digits;
+    }
+
+    if (remainder == 0) {
+        return value;
+    }
+
+    return static_cast<Unsigned>(
+        (value >> remainder) | (value << (digits - remainder)));
+}
+
+/*!
+ * \brief Rotates the bits of 'value' to the left.
+ * \param value The unsigned integer to rotate.
+ * \param shift The amount of positions to rotate by. A negative amount
+ *              rotates to the right.
+ * \return The rotated value.
+ * \note Like std::rotl from C++20. Compiles to a single instruction on
+ *       common platforms.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned rotl(Unsigned value, int shift) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::rotl should be an unsigned integer type.");
+
+    constexpr int digits{std::numeric_limits<Unsigned>::digits};
+
+    // rotating left by n is rotating right by digits - n.
+    return ::pl::rotr(value, digits - (shift % digits));
+}
+
+/*!
+ * \brief Determines whether 'value' is a power of two.
+ * \param value The unsigned integer to examine.
+ * \return true if exactly one bit of 'value' is set, false otherwise.
+ * \note Like std::has_single_bit from C++20.
+ **/
+template<typename Unsigned>
+constexpr bool has_single_bit(Unsigned value) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::has_single_bit should be an unsigned integer type.");
+
+    return (value != 0U) and ((value & (value - 1U)) == 0U);
+}
+
+/*!
+ * \brief Returns the amount of bits needed to represent 'value'.
+ * \param value The unsigned integer to examine.
+ * \return 1 plus the index of the most significant set bit, 0 if 'value'
+ *         is 0.
+ * \note Like std::bit_width from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int bit_width(Unsigned value) noexcept
+{
+    return std::numeric_limits<Unsigned>::digits - ::pl::countl_zero(value);
+}
+
+/*!
+ * \brief Returns the largest power of two not greater than 'value'.
+ * \param value The unsigned integer to round down.
+ * \return The power of two, 0 if 'value' is 0.
+ * \note Like std::bit_floor from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned bit_floor(Unsigned value) noexcept
+{
+    if (value == 0U) {
+        return 0U;
+    }
+
+    return static_cast<Unsigned>(Unsigned{1U} << (::pl::bit_width(value) - 1));
+}
+
+/*!
+ * \brief Returns the smallest power of two not less than 'value'.
+ * \param value The unsigned integer to round up.
+ * \return The power of two, 1 if 'value' is 0.
+ * \warning The behavior is undefined if the result can't be represented
+ *          by Unsigned.
+ * \note Like std::bit_ceil from C++20.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned bit_ceil(Unsigned value) noexcept
+{
+    if (value <= 1U) {
+        return 1U;
+    }
+
+    return static_cast<Unsigned>(
+        Unsigned{1U} << ::pl::bit_width(static_cast<Unsigned>(value - 1U)));
+}
+
+/*!
+ * \brief Parallel bit deposit: copies the low bits of 'value' to the
+ *        positions of the set bits of 'mask', from the least significant
+ *        one upwards.
+ * \param value The bits to deposit.
+ * \param mask Where to deposit them.
+ * \return The deposited bits, all other bits are 0.
+ * \note Uses the BMI2 pdep instruction if it is enabled at compile time,
+ *       except in constant expressions.
+ * \warning pdep is very slow on AMD CPUs before Zen 3.
+ * \see pext
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned pdep(Unsigned value, Unsigned mask) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::pdep should be an unsigned integer type.");
+
+#if PL_DETAIL_BIT_USE_BMI2
+    if (not __builtin_is_constant_evaluated()) {
+#if defined(__x86_64__)
+        if (sizeof(Unsigned) == sizeof(std::uint64_t)) {
+            return static_cast<Unsigned>(_pdep_u64(value, mask));
+        }
+#endif
+        if (sizeof(Unsigned) <= sizeof(std::uint32_t)) {
+            return static_cast<Unsigned>(_pdep_u32(
+                static_cast<std::uint32_t>(value),
+                static_cast<std::uint32_t>(mask)));
+        }
+    }
+#endif
+
+    return static_cast<Unsigned>(detail::pdep_fallback(value, mask));
+}
+
+/*!
+ * \brief Parallel bit extract: gathers the bits of 'value' at the
+ *        positions of the set bits of 'mask' into the low bits of the
+ *        result.
+ * \param value The bits to extract from.
+ * \param mask Which bits to extract.
+ * \return The extracted bits, all higher bits are 0.
+ * \note Uses the BMI2 pext instruction if it is enabled at compile time,
+ *       except in constant expressions.
+ * \warning pext is very slow on AMD CPUs before Zen 3.
+ * \see pdep
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR Unsigned pext(Unsigned value, Unsigned mask) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::pext should be an unsigned integer type.");
+
+#if PL_DETAIL_BIT_USE_BMI2
+    if (not __builtin_is_constant_evaluated()) {
+#if defined(__x86_64__)
+        if (sizeof(Unsigned) == sizeof(std::uint64_t)) {
+            return static_cast<Unsigned>(_pext_u64(value, mask));
+        }
+#endif
+        if (sizeof(Unsigned) <= sizeof(std::uint32_t)) {
+            return static_cast<Unsigned>(_pext_u32(
+                static_cast<std::uint32_t>(value),
+                static_cast<std::uint32_t>(mask)));
+        }
+    }
+#endif
+
+    return static_cast<Unsigned>(detail::pext_fallback(value, mask));
+}
+
+/*!
+ * \brief Returns the index of the n-th set bit of 'value', counting from
+ *        the least significant bit and starting at 0.
+ * \param value The unsigned integer to examine.
+ * \param n Which set bit to find.
+ * \return The index of the bit, the bit width of Unsigned if 'value' has
+ *         no more than n set bits.
+ * \note This is the select operation of rank / select bit vectors.
+ **/
+template<typename Unsigned>
+PL_DETAIL_BIT_CONSTEXPR int select_bit(Unsigned value, int n) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::select_bit should be an unsigned integer type.");
+
+    if ((n < 0) or (n >= ::pl::popcount(value))) {
+        return std::numeric_limits<Unsigned>::digits;
+    }
+
+    return ::pl::countr_zero(
+        ::pl::pdep(static_cast<Unsigned>(Unsigned{1U} << n), value));
+}
+
+/*!
+ * \brief Returns the byte at 'index' of 'value', where index 0 is the
+ *        least significant byte regardless of the byte order.
+ * \param value The unsigned integer to take the byte from.
+ * \param index The index of the byte. [0..sizeof(Unsigned))
+ * \return The selected byte.
+ **/
+template<typename Unsigned>
+constexpr std::uint8_t select_byte(Unsigned value, std::size_t index) noexcept
+{
+    static_assert(
+        detail::is_bit_operand<Unsigned>::value,
+        "Unsigned in pl::select_byte should be an unsigned integer type.");
+
+    return static_cast<std::uint8_t>(
+        static_cast<std::uint64_t>(value) >> (index * 8U));
+}
 } // namespace pl
 #endif // INCG_PL_BIT_HPP
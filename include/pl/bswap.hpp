@@ -27,21 +27,34 @@
 /*!
  * \file bswap.hpp
  * \brief Exports the bswap function template that allows reversing the bytes
- *        of any object.
+ *        of any object and the bswap_n and bswap_inplace function templates
+ *        that reverse the bytes of every element of an array.
  **/
 #ifndef INCG_PL_BSWAP_HPP
 #define INCG_PL_BSWAP_HPP
-#include "as_bytes.hpp" // pl::asBytes
-#include "compiler.hpp" // PL_COMPILER, PL_COMPILER_MSVC, PL_COMPILER_GCC, PL_COMPILER_CLANG, PL_COMPILER_ICC
-#include "inline.hpp"   // PL_ALWAYS_INLINE
+#include "annotations.hpp"       // PL_IN, PL_OUT, PL_INOUT
+#include "as_bytes.hpp"          // pl::asBytes
+#include "assert.hpp"            // PL_DBG_CHECK_PRE
+#include "byte.hpp"              // pl::byte
+#include "compiler.hpp"          // PL_COMPILER, PL_COMPILER_MSVC, PL_COMPILER_GCC, PL_COMPILER_CLANG, PL_COMPILER_ICC
+#include "cont/data.hpp"         // pl::cont::data
+#include "cont/size.hpp"         // pl::cont::size
+#include "cpu_features.hpp"      // pl::simd_level, pl::best_simd_level, PL_TARGET, PL_CPU_X86
+#include "inline.hpp"            // PL_ALWAYS_INLINE
 #include "meta/disable_if.hpp"   // pl::meta::disable_if_t
 #include "meta/remove_cvref.hpp" // pl::meta::remove_cvref_t
 #include <algorithm>             // std::reverse
-#include <ciso646>               // or
-#include <cstdint> // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::int8_t, std::int16_t, std::int32_t, std::int64_t
+#include <ciso646>               // or, and
+#include <cstddef>               // std::size_t
+#include <cstdint>               // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::int8_t, std::int16_t, std::int32_t, std::int64_t
+#include <cstring>               // std::memcpy, std::memmove
+#include <type_traits>           // std::enable_if_t, std::is_arithmetic, std::integral_constant
 #if PL_COMPILER == PL_COMPILER_MSVC
 #include <stdlib.h> // _byteswap_ushort, _byteswap_ulong, _byteswap_uint64
 #endif              // PL_COMPILER == PL_COMPILER_MSVC
+#if PL_CPU_X86
+#include <immintrin.h> // _mm_shuffle_epi8, _mm256_shuffle_epi8
+#endif
 
 namespace pl {
 namespace detail {
@@ -264,5 +277,338 @@ PL_ALWAYS_INLINE auto bswap(Ty ty) noexcept -> meta::disable_if_t<
 {
     return ::pl::detail::bswap_impl(ty);
 }
+
+namespace detail {
+/*!
+ * \brief The unsigned integer type with 'Width' bytes.
+ *        Not to be used directly.
+**/
+template<std::size_t Width>
+struct bswap_word;
+
+template<>
+struct bswap_word<2U> {
+    using type = std::uint16_t;
+};
+
+template<>
+struct bswap_word<4U> {
+    using type = std::uint32_t;
+};
+
+template<>
+struct bswap_word<8U> {
+    using type = std::uint64_t;
+};
+
+/*!
+ * \brief The signature of the bswap_n kernels, which reverse the bytes of
+ *        'count' elements of 'Width' bytes each. Not to be used directly.
+**/
+using bswap_kernel = void (*)(byte*, const byte*, std::size_t);
+
+/*!
+ * \brief Reverses the bytes of one element at a time.
+ *        Not to be used directly.
+**/
+template<std::size_t Width>
+inline void bswap_n_scalar(
+    byte*       dest,
+    const byte* src,
+    std::size_t count) noexcept
+{
+    using word = typename bswap_word<Width>::type;
+
+    for (std::size_t i{0U}; i < count; ++i) {
+        word value;
+        std::memcpy(&value, src + (i * Width), Width);
+        value = ::pl::bswap(value);
+        std::memcpy(dest + (i * Width), &value, Width);
+    }
+}
+
+#if PL_CPU_X86
+/*!
+ * \brief Returns the pshufb control mask that reverses the bytes of every
+ *        'Width' byte element of a 128 bit vector. Not to be used directly.
+**/
+template<std::size_t Width>
+PL_TARGET("sse2")
+inline __m128i bswap_shuffle_mask() noexcept
+{
+    char mask[16];
+
+    for (std::size_t i{0U}; i < 16U; ++i) {
+        mask[i] = static_cast<char>(
+            ((i / Width) * Width) + (Width - 1U - (i % Width)));
+    }
+
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+}
+
+/*!
+ * \brief Reverses the bytes of 16 bytes worth of elements at a time.
+ *        Not to be used directly.
+**/
+template<std::size_t Width>
+PL_TARGET("ssse3")
+inline void bswap_n_ssse3(
+    byte*       dest,
+    const byte* src,
+    std::size_t count) noexcept
+{
+    const __m128i     mask{bswap_shuffle_mask<Width>()};
+    std::size_t       byte_count{count * Width};
+    const std::size_t block_bytes{16U};
+
+    while (byte_count >= 4U * block_bytes) {
+        const __m128i* const s{reinterpret_cast<const __m128i*>(src)};
+        __m128i* const       d{reinterpret_cast<__m128i*>(dest)};
+        const __m128i        a{_mm_shuffle_epi8(_mm_loadu_si128(s), mask)};
+        const __m128i b{_mm_shuffle_epi8(_mm_loadu_si128(s + 1), mask)};
+        const __m128i c{_mm_shuffle_epi8(_mm_loadu_si128(s + 2), mask)};
+        const __m128i e{_mm_shuffle_epi8(_mm_loadu_si128(s + 3), mask)};
+        _mm_storeu_si128(d, a);
+        _mm_storeu_si128(d + 1, b);
+        _mm_storeu_si128(d + 2, c);
+        _mm_storeu_si128(d + 3, e);
+
+        byte_count -= 4U * block_bytes;
+        src += 4U * block_bytes;
+        dest += 4U * block_bytes;
+    }
+
+    while (byte_count >= block_bytes) {
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(dest),
+            _mm_shuffle_epi8(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)),
+                mask));
+
+        byte_count -= block_bytes;
+        src += block_bytes;
+        dest += block_bytes;
+    }
+
+    bswap_n_scalar<Width>(dest, src, byte_count / Width);
+}
+
+/*!
+ * \brief Reverses the bytes of 32 bytes worth of elements at a time.
+ *        Not to be used directly.
+**/
+template<std::size_t Width>
+PL_TARGET("avx2")
+inline void bswap_n_avx2(
+    byte*       dest,
+    const byte* src,
+    std::size_t count) noexcept
+{
+    // vpshufb shuffles within each 128 bit lane, so both lanes use the
+    // same mask.
+    const __m256i mask{
+        _mm256_broadcastsi128_si256(bswap_shuffle_mask<Width>())};
+    std::size_t       byte_count{count * Width};
+    const std::size_t block_bytes{32U};
+
+    while (byte_count >= 4U * block_bytes) {
+        const __m256i* const s{reinterpret_cast<const __m256i*>(src)};
+        __m256i* const       d{reinterpret_cast<__m256i*>(dest)};
+        const __m256i        a{
+            _mm256_shuffle_epi8(_mm256_loadu_si256(s), mask)};
+        const __m256i b{_mm256_shuffle_epi8(_mm256_loadu_si256(s + 1), mask)};
+        const __m256i c{_mm256_shuffle_epi8(_mm256_loadu_si256(s + 2), mask)};
+        const __m256i e{_mm256_shuffle_epi8(_mm256_loadu_si256(s + 3), mask)};
+        _mm256_storeu_si256(d, a);
+        _mm256_storeu_si256(d + 1, b);
+        _mm256_storeu_si256(d + 2, c);
+        _mm256_storeu_si256(d + 3, e);
+
+        byte_count -= 4U * block_bytes;
+        src += 4U * block_bytes;
+        dest += 4U * block_bytes;
+    }
+
+    while (byte_count >= block_bytes) {
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(dest),
+            _mm256_shuffle_epi8(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)),
+                mask));
+
+        byte_count -= block_bytes;
+        src += block_bytes;
+        dest += block_bytes;
+    }
+
+    bswap_n_ssse3<Width>(dest, src, byte_count / Width);
+}
+#endif // PL_CPU_X86
+
+/*!
+ * \brief Returns the bswap_n kernel for 'level', which must be supported by
+ *        the CPU. Not to be used directly.
+**/
+template<std::size_t Width>
+inline bswap_kernel bswap_kernel_for(simd_level level) noexcept
+{
+#if PL_CPU_X86
+    switch (level) {
+    case simd_level::avx512:
+    case simd_level::avx2: return &bswap_n_avx2<Width>;
+    case simd_level::ssse3: return &bswap_n_ssse3<Width>;
+    case simd_level::sse2:
+    case simd_level::none: break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    return &bswap_n_scalar<Width>;
+}
+
+/*!
+ * \brief Returns the bswap_n kernel for the most capable SIMD instruction
+ *        set supported by the CPU, which is detected once.
+ *        Not to be used directly.
+**/
+template<std::size_t Width>
+inline bswap_kernel best_bswap_kernel() noexcept
+{
+    static const bswap_kernel kernel{
+        bswap_kernel_for<Width>(best_simd_level())};
+    return kernel;
+}
+
+/*!
+ * \brief Copies single byte elements, which have nothing to reverse.
+ *        Not to be used directly.
+**/
+inline void bswap_n_copy(
+    byte*       dest,
+    const byte* src,
+    std::size_t count) noexcept
+{
+    if (dest != src) {
+        std::memmove(dest, src, count);
+    }
+}
+
+template<>
+inline bswap_kernel bswap_kernel_for<1U>(simd_level) noexcept
+{
+    return &bswap_n_copy;
+}
+
+template<>
+inline bswap_kernel best_bswap_kernel<1U>() noexcept
+{
+    return &bswap_n_copy;
+}
+
+/*!
+ * \brief Whether the bytes of arrays of 'Ty' can be reversed by bswap_n.
+ *        Not to be used directly.
+**/
+template<typename Ty>
+struct is_bulk_bswappable
+    : public std::integral_constant<
+          bool,
+          std::is_arithmetic<Ty>::value
+              and ((sizeof(Ty) == 1U) or (sizeof(Ty) == 2U)
+                   or (sizeof(Ty) == 4U) or (sizeof(Ty) == 8U))> {
+};
+} // namespace detail
+
+/*!
+ * \brief Stores the elements of 'source' with their bytes reversed into
+ *        'destination', using the SIMD instruction set given.
+ * \param destination The array to write to. May not be nullptr!
+ *                    May be the same as 'source', but must not overlap
+ *                    with it otherwise.
+ * \param source The array to read from. May not be nullptr!
+ * \param count The amount of elements to process.
+ * \param level The SIMD instruction set to use. Falls back to the most
+ *              capable one supported by the CPU if it is not supported.
+ * \return Pointer one past the last element written to.
+ * \note Only arithmetic types of 1, 2, 4 or 8 bytes are supported.
+**/
+template<typename Ty>
+inline auto bswap_n(
+    PL_OUT Ty* destination,
+    PL_IN const Ty* source,
+    std::size_t     count,
+    simd_level      level)
+    -> std::enable_if_t<detail::is_bulk_bswappable<Ty>::value, Ty*>
+{
+    PL_DBG_CHECK_PRE(destination != nullptr);
+    PL_DBG_CHECK_PRE(source != nullptr);
+
+    detail::bswap_kernel_for<sizeof(Ty)>(supported_simd_level(level))(
+        reinterpret_cast<byte*>(destination),
+        reinterpret_cast<const byte*>(source),
+        count);
+
+    return destination + count;
+}
+
+/*!
+ * \brief Stores the elements of 'source' with their bytes reversed into
+ *        'destination', using the widest vectors supported by the CPU.
+ * \param destination The array to write to. May not be nullptr!
+ *                    May be the same as 'source', but must not overlap
+ *                    with it otherwise.
+ * \param source The array to read from. May not be nullptr!
+ * \param count The amount of elements to process.
+ * \return Pointer one past the last element written to.
+ * \note Only arithmetic types of 1, 2, 4 or 8 bytes are supported.
+ * \note Can be used to convert entire buffers of big endian data to little
+ *       endian and vice versa.
+**/
+template<typename Ty>
+inline auto bswap_n(
+    PL_OUT Ty* destination,
+    PL_IN const Ty* source,
+    std::size_t     count)
+    -> std::enable_if_t<detail::is_bulk_bswappable<Ty>::value, Ty*>
+{
+    PL_DBG_CHECK_PRE(destination != nullptr);
+    PL_DBG_CHECK_PRE(source != nullptr);
+
+    detail::best_bswap_kernel<sizeof(Ty)>()(
+        reinterpret_cast<byte*>(destination),
+        reinterpret_cast<const byte*>(source),
+        count);
+
+    return destination + count;
+}
+
+/*!
+ * \brief Reverses the bytes of each of the 'count' elements pointed to by
+ *        'data' in place.
+ * \param data The array to modify. May not be nullptr!
+ * \param count The amount of elements to process.
+ * \return Pointer one past the last element modified.
+ * \note Only arithmetic types of 1, 2, 4 or 8 bytes are supported.
+**/
+template<typename Ty>
+inline auto bswap_inplace(PL_INOUT Ty* data, std::size_t count)
+    -> std::enable_if_t<detail::is_bulk_bswappable<Ty>::value, Ty*>
+{
+    return ::pl::bswap_n(data, data, count);
+}
+
+/*!
+ * \brief Reverses the bytes of each element of a contiguous container,
+ *        such as a built-in array, std::array or std::vector, in place.
+ * \param container The container to modify.
+ * \return Pointer one past the last element modified.
+ * \note Only arithmetic element types of 1, 2, 4 or 8 bytes are supported.
+**/
+template<typename Container>
+inline auto bswap_inplace(PL_INOUT Container& container) -> decltype(
+    ::pl::bswap_inplace(cont::data(container), cont::size(container)))
+{
+    return ::pl::bswap_inplace(cont::data(container), cont::size(container));
+}
 } // namespace pl
 #endif // INCG_PL_BSWAP_HPP
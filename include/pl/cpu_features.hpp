@@ -0,0 +1,222 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file cpu_features.hpp
+ * \brief Exports functions to detect the SIMD instruction sets supported
+ *        by the CPU at runtime, used to dispatch to vectorized kernels,
+ *        and the size of its last level cache.
+**/
+#ifndef INCG_PL_CPU_FEATURES_HPP
+#define INCG_PL_CPU_FEATURES_HPP
+#include "compiler.hpp" // PL_COMPILER, PL_COMPILER_MSVC, PL_COMPILER_GCC, PL_COMPILER_CLANG
+#include "os.hpp"       // PL_OS, PL_OS_LINUX
+#include <ciso646>      // and
+#include <cstddef>      // std::size_t
+#if PL_OS == PL_OS_LINUX
+#include <unistd.h> // sysconf, _SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE
+#endif
+
+/*!
+ * \def PL_CPU_X86
+ * \brief 1 if compiling for x86 or x86-64, 0 otherwise.
+**/
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) \
+    || defined(_M_IX86)
+#define PL_CPU_X86 1
+#else
+#define PL_CPU_X86 0
+#endif
+
+/*!
+ * \def PL_TARGET(features)
+ * \brief Allows the function it is applied to to use the instruction
+ *        set extensions in the string literal 'features', for instance
+ *        "avx2", regardless of the compiler flags. Such a function must
+ *        only be called if the CPU supports them.
+**/
+#if PL_CPU_X86                           \
+    && ((PL_COMPILER == PL_COMPILER_GCC) \
+        || (PL_COMPILER == PL_COMPILER_CLANG))
+#define PL_TARGET(features) __attribute__((target(features)))
+#else
+#define PL_TARGET(features)
+#endif
+
+#if PL_CPU_X86 && (PL_COMPILER == PL_COMPILER_MSVC)
+#include <intrin.h> // __cpuid, __cpuidex, _xgetbv
+#endif
+
+namespace pl {
+/*!
+ * \brief The SIMD instruction sets that vectorized kernels are available
+ *        for, ordered from least to most capable.
+**/
+enum class simd_level {
+    none,  //!< plain C++, processing a machine word at a time.
+    sse2,  //!< 128 bit vectors.
+    ssse3, //!< 128 bit vectors with byte shuffles.
+    avx2,  //!< 256 bit vectors.
+    avx512 //!< 512 bit vectors, requires AVX-512 F and BW.
+};
+
+/*!
+ * \brief The SIMD instruction set extensions supported by the CPU and the
+ *        operating system.
+**/
+struct cpu_features {
+    bool sse2;
+    bool ssse3;
+    bool sse42;
+    bool avx2;
+    bool avx512f;
+    bool avx512bw;
+};
+
+namespace detail {
+/*!
+ * \brief Queries the CPU. Not to be used directly.
+**/
+inline cpu_features detect_cpu_features() noexcept
+{
+    cpu_features features{false, false, false, false, false, false};
+#if PL_CPU_X86                           \
+    && ((PL_COMPILER == PL_COMPILER_GCC) \
+        || (PL_COMPILER == PL_COMPILER_CLANG))
+    __builtin_cpu_init();
+    features.sse2     = __builtin_cpu_supports("sse2") != 0;
+    features.ssse3    = __builtin_cpu_supports("ssse3") != 0;
+    features.sse42    = __builtin_cpu_supports("sse4.2") != 0;
+    features.avx2     = __builtin_cpu_supports("avx2") != 0;
+    features.avx512f  = __builtin_cpu_supports("avx512f") != 0;
+    features.avx512bw = __builtin_cpu_supports("avx512bw") != 0;
+#elif PL_CPU_X86 && (PL_COMPILER == PL_COMPILER_MSVC)
+    int registers[4]{};
+    __cpuid(registers, 0);
+    const int max_leaf{registers[0]};
+
+    __cpuid(registers, 1);
+    features.sse2  = (registers[3] & (1 << 26)) != 0;
+    features.ssse3 = (registers[2] & (1 << 9)) != 0;
+    features.sse42 = (registers[2] & (1 << 20)) != 0;
+
+    // the OS must save the vector registers on context switches.
+    const bool               osxsave{(registers[2] & (1 << 27)) != 0};
+    const unsigned long long xcr0{osxsave ? _xgetbv(0) : 0ULL};
+    const bool               avx_state{(xcr0 & 0x06ULL) == 0x06ULL};
+    const bool               avx512_state{(xcr0 & 0xE6ULL) == 0xE6ULL};
+
+    if (max_leaf >= 7) {
+        __cpuidex(registers, 7, 0);
+        features.avx2     = avx_state and ((registers[1] & (1 << 5)) != 0);
+        features.avx512f  = avx512_state and ((registers[1] & (1 << 16)) != 0);
+        features.avx512bw = avx512_state and ((registers[1] & (1 << 30)) != 0);
+    }
+#endif
+    return features;
+}
+
+/*!
+ * \brief Queries the size of the largest CPU cache. Not to be used directly.
+**/
+inline std::size_t detect_last_level_cache_size() noexcept
+{
+    long cache_size{0L};
+#if PL_OS == PL_OS_LINUX
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    cache_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    if (cache_size <= 0L) {
+        cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+#endif
+    // assume a typical size if the operating system doesn't tell.
+    return cache_size > 0L ? static_cast<std::size_t>(cache_size)
+                           : std::size_t{8U} * 1024U * 1024U;
+}
+} // namespace detail
+
+/*!
+ * \brief Returns the size in bytes of the last level CPU cache, or 8 MiB
+ *        if the operating system doesn't report it. Detected once.
+**/
+inline std::size_t last_level_cache_size() noexcept
+{
+    static const std::size_t size{detail::detect_last_level_cache_size()};
+    return size;
+}
+
+/*!
+ * \brief Returns the SIMD instruction set extensions supported by the CPU
+ *        this program runs on. Detected once.
+**/
+inline const cpu_features& detected_cpu_features() noexcept
+{
+    static const cpu_features features{detail::detect_cpu_features()};
+    return features;
+}
+
+/*!
+ * \brief Returns the most capable simd_level supported by the CPU this
+ *        program runs on.
+**/
+inline simd_level best_simd_level() noexcept
+{
+    const cpu_features& features{detected_cpu_features()};
+
+    if (features.avx512f and features.avx512bw) {
+        return simd_level::avx512;
+    }
+
+    if (features.avx2) {
+        return simd_level::avx2;
+    }
+
+    if (features.ssse3) {
+        return simd_level::ssse3;
+    }
+
+    if (features.sse2) {
+        return simd_level::sse2;
+    }
+
+    return simd_level::none;
+}
+
+/*!
+ * \brief Returns 'requested' if the CPU supports it, otherwise the most
+ *        capable simd_level it supports.
+ * \param requested The simd_level requested.
+**/
+inline simd_level supported_simd_level(simd_level requested) noexcept
+{
+    const simd_level best{best_simd_level()};
+    return requested < best ? requested : best;
+}
+} // namespace pl
+#endif // INCG_PL_CPU_FEATURES_HPP
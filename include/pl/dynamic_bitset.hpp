@@ -0,0 +1,793 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file dynamic_bitset.hpp
+ * \brief Exports the dynamic_bitset type, a bitset whose size is chosen at
+ *        runtime, with vectorized set operations.
+**/
+#ifndef INCG_PL_DYNAMIC_BITSET_HPP
+#define INCG_PL_DYNAMIC_BITSET_HPP
+#include "aligned_buffer.hpp" // pl::aligned_allocator
+#include "annotations.hpp"    // PL_IN, PL_INOUT
+#include "assert.hpp"         // PL_DBG_CHECK_PRE
+#include "bit.hpp"            // pl::popcount, pl::countr_zero
+#include "cpu_features.hpp"   // pl::simd_level, pl::best_simd_level, PL_TARGET, PL_CPU_X86
+#include <algorithm>          // std::fill, std::equal
+#include <ciso646>            // and, not
+#include <cstddef>            // std::size_t, std::ptrdiff_t
+#include <cstdint>            // std::uint64_t
+#include <utility>            // std::swap
+#include <vector>             // std::vector
+#if PL_CPU_X86
+#include <immintrin.h> // _mm_*, _mm256_*
+#endif
+
+namespace pl {
+namespace detail {
+/*!
+ * \brief The word-parallel operations of dynamic_bitset.
+ *        Not to be used directly.
+**/
+enum class bitset_op {
+    and_assign,    //!< dest &= src
+    or_assign,     //!< dest |= src
+    xor_assign,    //!< dest ^= src
+    and_not_assign //!< dest &= ~src
+};
+
+/*!
+ * \brief The signature of the kernels applying a bitset_op to arrays of
+ *        words. Not to be used directly.
+**/
+using bitset_kernel
+    = void (*)(std::uint64_t*, const std::uint64_t*, std::size_t);
+
+/*!
+ * \brief The signature of the kernels counting the set bits of an array of
+ *        words. Not to be used directly.
+**/
+using bitset_count_kernel = std::size_t (*)(const std::uint64_t*, std::size_t);
+
+/*!
+ * \brief Applies Op to two words. Not to be used directly.
+**/
+template<bitset_op Op>
+constexpr std::uint64_t bitset_apply(std::uint64_t a, std::uint64_t b) noexcept
+{
+    return Op == bitset_op::and_assign
+               ? (a & b)
+               : Op == bitset_op::or_assign
+                     ? (a | b)
+                     : Op == bitset_op::xor_assign ? (a ^ b) : (a & ~b);
+}
+
+/*!
+ * \brief Applies Op one word at a time. Not to be used directly.
+**/
+template<bitset_op Op>
+inline void bitset_words_scalar(
+    std::uint64_t*       dest,
+    const std::uint64_t* src,
+    std::size_t          count) noexcept
+{
+    for (std::size_t i{0U}; i < count; ++i) {
+        dest[i] = bitset_apply<Op>(dest[i], src[i]);
+    }
+}
+
+/*!
+ * \brief Counts the set bits one word at a time. Not to be used directly.
+**/
+inline std::size_t bitset_count_scalar(
+    const std::uint64_t* words,
+    std::size_t          count) noexcept
+{
+    std::size_t result{0U};
+
+    for (std::size_t i{0U}; i < count; ++i) {
+        result += static_cast<std::size_t>(::pl::popcount(words[i]));
+    }
+
+    return result;
+}
+
+#if PL_CPU_X86
+/*!
+ * \brief Applies Op to two 128 bit vectors. Not to be used directly.
+**/
+template<bitset_op Op>
+PL_TARGET("sse2")
+inline __m128i bitset_apply_sse2(__m128i a, __m128i b) noexcept
+{
+    return Op == bitset_op::and_assign
+               ? _mm_and_si128(a, b)
+               : Op == bitset_op::or_assign
+                     ? _mm_or_si128(a, b)
+                     : Op == bitset_op::xor_assign ? _mm_xor_si128(a, b)
+                                                   : _mm_andnot_si128(b, a);
+}
+
+/*!
+ * \brief Applies Op two words at a time. Not to be used directly.
+**/
+template<bitset_op Op>
+PL_TARGET("sse2")
+inline void bitset_words_sse2(
+    std::uint64_t*       dest,
+    const std::uint64_t* src,
+    std::size_t          count) noexcept
+{
+    std::size_t i{0U};
+
+    for (; i + 8U <= count; i += 8U) {
+        __m128i* const       d{reinterpret_cast<__m128i*>(dest + i)};
+        const __m128i* const s{reinterpret_cast<const __m128i*>(src + i)};
+        const __m128i        a{bitset_apply_sse2<Op>(
+            _mm_loadu_si128(d), _mm_loadu_si128(s))};
+        const __m128i b{bitset_apply_sse2<Op>(
+            _mm_loadu_si128(d + 1), _mm_loadu_si128(s + 1))};
+        const __m128i c{bitset_apply_sse2<Op>(
+            _mm_loadu_si128(d + 2), _mm_loadu_si128(s + 2))};
+        const __m128i e{bitset_apply_sse2<Op>(
+            _mm_loadu_si128(d + 3), _mm_loadu_si128(s + 3))};
+        _mm_storeu_si128(d, a);
+        _mm_storeu_si128(d + 1, b);
+        _mm_storeu_si128(d + 2, c);
+        _mm_storeu_si128(d + 3, e);
+    }
+
+    bitset_words_scalar<Op>(dest + i, src + i, count - i);
+}
+
+/*!
+ * \brief Applies Op to two 256 bit vectors. Not to be used directly.
+**/
+template<bitset_op Op>
+PL_TARGET("avx2")
+inline __m256i bitset_apply_avx2(__m256i a, __m256i b) noexcept
+{
+    return Op == bitset_op::and_assign
+               ? _mm256_and_si256(a, b)
+               : Op == bitset_op::or_assign
+                     ? _mm256_or_si256(a, b)
+                     : Op == bitset_op::xor_assign
+                           ? _mm256_xor_si256(a, b)
+                           : _mm256_andnot_si256(b, a);
+}
+
+/*!
+ * \brief Applies Op four words at a time. Not to be used directly.
+**/
+template<bitset_op Op>
+PL_TARGET("avx2")
+inline void bitset_words_avx2(
+    std::uint64_t*       dest,
+    const std::uint64_t* src,
+    std::size_t          count) noexcept
+{
+    std::size_t i{0U};
+
+    for (; i + 16U <= count; i += 16U) {
+        __m256i* const       d{reinterpret_cast<__m256i*>(dest + i)};
+        const __m256i* const s{reinterpret_cast<const __m256i*>(src + i)};
+        const __m256i        a{bitset_apply_avx2<Op>(
+            _mm256_loadu_si256(d), _mm256_loadu_si256(s))};
+        const __m256i b{bitset_apply_avx2<Op>(
+            _mm256_loadu_si256(d + 1), _mm256_loadu_si256(s + 1))};
+        const __m256i c{bitset_apply_avx2<Op>(
+            _mm256_loadu_si256(d + 2), _mm256_loadu_si256(s + 2))};
+        const __m256i e{bitset_apply_avx2<Op>(
+            _mm256_loadu_si256(d + 3), _mm256_loadu_si256(s + 3))};
+        _mm256_storeu_si256(d, a);
+        _mm256_storeu_si256(d + 1, b);
+        _mm256_storeu_si256(d + 2, c);
+        _mm256_storeu_si256(d + 3, e);
+    }
+
+    bitset_words_scalar<Op>(dest + i, src + i, count - i);
+}
+
+/*!
+ * \brief Counts the set bits four words at a time, looking up the counts
+ *        of each nibble with vpshufb. Not to be used directly.
+**/
+PL_TARGET("avx2")
+inline std::size_t bitset_count_avx2(
+    const std::uint64_t* words,
+    std::size_t          count) noexcept
+{
+    const __m256i lookup{_mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4)};
+    const __m256i low_nibbles{_mm256_set1_epi8(0x0F)};
+    const __m256i zero{_mm256_setzero_si256()};
+    __m256i       totals{zero};
+    std::size_t   i{0U};
+
+    for (; i + 4U <= count; i += 4U) {
+        const __m256i value{
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))};
+        const __m256i low{_mm256_and_si256(value, low_nibbles)};
+        const __m256i high{
+            _mm256_and_si256(_mm256_srli_epi16(value, 4), low_nibbles)};
+        const __m256i byte_counts{_mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, low),
+            _mm256_shuffle_epi8(lookup, high))};
+
+        // sum the 8 byte counts of every word into a 64 bit lane.
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(byte_counts, zero));
+    }
+
+    std::uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), totals);
+
+    return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3])
+           + bitset_count_scalar(words + i, count - i);
+}
+#endif // PL_CPU_X86
+
+/*!
+ * \brief Returns the kernel applying Op for the most capable SIMD
+ *        instruction set supported by the CPU, which is detected once.
+ *        Not to be used directly.
+**/
+template<bitset_op Op>
+inline bitset_kernel best_bitset_kernel() noexcept
+{
+#if PL_CPU_X86
+    static const bitset_kernel kernel{
+        best_simd_level() >= simd_level::avx2
+            ? &bitset_words_avx2<Op>
+            : best_simd_level() >= simd_level::sse2 ? &bitset_words_sse2<Op>
+                                                    : &bitset_words_scalar<Op>};
+    return kernel;
+#else
+    return &bitset_words_scalar<Op>;
+#endif
+}
+
+/*!
+ * \brief Returns the kernel counting set bits for the most capable SIMD
+ *        instruction set supported by the CPU, which is detected once.
+ *        Not to be used directly.
+**/
+inline bitset_count_kernel best_bitset_count_kernel() noexcept
+{
+#if PL_CPU_X86
+    static const bitset_count_kernel kernel{
+        best_simd_level() >= simd_level::avx2 ? &bitset_count_avx2
+                                              : &bitset_count_scalar};
+    return kernel;
+#else
+    return &bitset_count_scalar;
+#endif
+}
+} // namespace detail
+
+/*!
+ * \brief A sequence of bits whose size is chosen at runtime, stored in
+ *        64 bit words.
+ * \note The set operations (&=, |=, ^=, and_not) and count process
+ *       whole words using the widest vectors supported by the CPU.
+ * \note Bits of the last word beyond size() are always 0.
+ * \see dynamic_bitset
+**/
+template<typename Allocator = aligned_allocator<std::uint64_t>>
+class basic_dynamic_bitset {
+public:
+    using this_type      = basic_dynamic_bitset;
+    using size_type      = std::size_t;
+    using word_type      = std::uint64_t;
+    using allocator_type = Allocator;
+
+    /*!
+     * \brief The amount of bits stored in a word.
+    **/
+    static constexpr size_type bits_per_word = 64U;
+
+    /*!
+     * \brief Returned by find_first and find_next if no bit is found.
+    **/
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    /*!
+     * \brief Creates an empty basic_dynamic_bitset.
+    **/
+    basic_dynamic_bitset() noexcept : m_words{}, m_size{0U} {}
+
+    /*!
+     * \brief Creates a basic_dynamic_bitset of 'bit_count' bits.
+     * \param bit_count The amount of bits.
+     * \param value The value of every bit.
+    **/
+    explicit basic_dynamic_bitset(size_type bit_count, bool value = false)
+        : m_words(word_count_for(bit_count), value ? ~word_type{0U} : 0U),
+          m_size{bit_count}
+    {
+        clear_unused_bits();
+    }
+
+    /*!
+     * \brief Returns the amount of bits.
+    **/
+    size_type size() const noexcept { return m_size; }
+
+    /*!
+     * \brief Returns whether there are no bits.
+    **/
+    bool empty() const noexcept { return m_size == 0U; }
+
+    /*!
+     * \brief Returns the amount of words used to store the bits.
+    **/
+    size_type word_count() const noexcept { return m_words.size(); }
+
+    /*!
+     * \brief Returns the words storing the bits. Bit i is stored in word
+     *        i / 64 at position i % 64.
+    **/
+    const word_type* data() const noexcept { return m_words.data(); }
+
+    /*!
+     * \brief Changes the amount of bits.
+     * \param bit_count The new amount of bits.
+     * \param value The value of the bits added, if any.
+    **/
+    void resize(size_type bit_count, bool value = false)
+    {
+        const size_type old_size{m_size};
+        m_words.resize(
+            word_count_for(bit_count), value ? ~word_type{0U} : 0U);
+        m_size = bit_count;
+
+        if (value and (bit_count > old_size)) {
+            // the unused bits of the previous last word.
+            set_range(old_size, bit_count);
+        }
+
+        clear_unused_bits();
+    }
+
+    /*!
+     * \brief Appends a bit.
+     * \param value The value of the bit.
+    **/
+    void push_back(bool value)
+    {
+        resize(m_size + 1U);
+        set(m_size - 1U, value);
+    }
+
+    /*!
+     * \brief Removes all bits.
+    **/
+    void clear() noexcept
+    {
+        m_words.clear();
+        m_size = 0U;
+    }
+
+    /*!
+     * \brief Returns the bit at 'pos'.
+     * \param pos The index of the bit. Must be less than size()!
+    **/
+    bool test(size_type pos) const
+    {
+        PL_DBG_CHECK_PRE(pos < m_size);
+        return (*this)[pos];
+    }
+
+    /*!
+     * \brief Returns the bit at 'pos' without checking 'pos'.
+     * \param pos The index of the bit. Must be less than size()!
+    **/
+    bool operator[](size_type pos) const noexcept
+    {
+        return ((m_words[pos / bits_per_word] >> (pos % bits_per_word)) & 1U)
+               != 0U;
+    }
+
+    /*!
+     * \brief Sets the bit at 'pos' to 'value'.
+     * \param pos The index of the bit. Must be less than size()!
+     * \param value The new value of the bit.
+     * \return A reference to this object.
+    **/
+    this_type& set(size_type pos, bool value = true)
+    {
+        PL_DBG_CHECK_PRE(pos < m_size);
+
+        word_type&      word{m_words[pos / bits_per_word]};
+        const word_type bit{word_type{1U} << (pos % bits_per_word)};
+        word = value ? (word | bit) : (word & ~bit);
+        return *this;
+    }
+
+    /*!
+     * \brief Sets the bit at 'pos' to 0.
+     * \param pos The index of the bit. Must be less than size()!
+     * \return A reference to this object.
+    **/
+    this_type& reset(size_type pos) { return set(pos, false); }
+
+    /*!
+     * \brief Toggles the bit at 'pos'.
+     * \param pos The index of the bit. Must be less than size()!
+     * \return A reference to this object.
+    **/
+    this_type& flip(size_type pos)
+    {
+        PL_DBG_CHECK_PRE(pos < m_size);
+
+        m_words[pos / bits_per_word] ^= word_type{1U} << (pos % bits_per_word);
+        return *this;
+    }
+
+    /*!
+     * \brief Sets all bits to 1.
+     * \return A reference to this object.
+    **/
+    this_type& set() noexcept
+    {
+        std::fill(m_words.begin(), m_words.end(), ~word_type{0U});
+        clear_unused_bits();
+        return *this;
+    }
+
+    /*!
+     * \brief Sets all bits to 0.
+     * \return A reference to this object.
+    **/
+    this_type& reset() noexcept
+    {
+        std::fill(m_words.begin(), m_words.end(), word_type{0U});
+        return *this;
+    }
+
+    /*!
+     * \brief Toggles all bits.
+     * \return A reference to this object.
+    **/
+    this_type& flip() noexcept
+    {
+        for (word_type& word : m_words) {
+            word = ~word;
+        }
+
+        clear_unused_bits();
+        return *this;
+    }
+
+    /*!
+     * \brief Sets the bits in ['first', 'last') to 1, a word at a time.
+     * \param first The index of the first bit to set.
+     * \param last The index one past the last bit to set.
+     *             Must not be greater than size()!
+     * \return A reference to this object.
+    **/
+    this_type& set_range(size_type first, size_type last)
+    {
+        PL_DBG_CHECK_PRE(first <= last);
+        PL_DBG_CHECK_PRE(last <= m_size);
+
+        apply_range(first, last, true);
+        return *this;
+    }
+
+    /*!
+     * \brief Sets the bits in ['first', 'last') to 0, a word at a time.
+     * \param first The index of the first bit to clear.
+     * \param last The index one past the last bit to clear.
+     *             Must not be greater than size()!
+     * \return A reference to this object.
+    **/
+    this_type& reset_range(size_type first, size_type last)
+    {
+        PL_DBG_CHECK_PRE(first <= last);
+        PL_DBG_CHECK_PRE(last <= m_size);
+
+        apply_range(first, last, false);
+        return *this;
+    }
+
+    /*!
+     * \brief Counts the bits that are set.
+     * \return The amount of 1 bits.
+    **/
+    size_type count() const noexcept
+    {
+        return detail::best_bitset_count_kernel()(
+            m_words.data(), m_words.size());
+    }
+
+    /*!
+     * \brief Returns whether any bit is set.
+    **/
+    bool any() const noexcept { return find_first() != npos; }
+
+    /*!
+     * \brief Returns whether no bit is set.
+    **/
+    bool none() const noexcept { return not any(); }
+
+    /*!
+     * \brief Returns whether all bits are set, true if there are no bits.
+    **/
+    bool all() const noexcept { return count() == m_size; }
+
+    /*!
+     * \brief Returns the index of the first set bit or npos if none is set.
+    **/
+    size_type find_first() const noexcept { return find_from_word(0U); }
+
+    /*!
+     * \brief Returns the index of the first set bit after 'pos' or npos if
+     *        there is none.
+     * \param pos The index to start searching after, may be npos.
+    **/
+    size_type find_next(size_type pos) const noexcept
+    {
+        // checked before adding 1, which would wrap npos around to 0.
+        if (pos >= m_size) {
+            return npos;
+        }
+
+        const size_type next{pos + 1U};
+
+        if (next == m_size) {
+            return npos;
+        }
+
+        const size_type index{next / bits_per_word};
+        const word_type word{m_words[index] >> (next % bits_per_word)};
+
+        if (word != 0U) {
+            return next + static_cast<size_type>(::pl::countr_zero(word));
+        }
+
+        return find_from_word(index + 1U);
+    }
+
+    /*!
+     * \brief Calls 'function' with the index of every set bit in ascending
+     *        order.
+     * \param function The callable to invoke as function(size_type).
+     * \return 'function'.
+     * \note Faster than a find_first / find_next loop, as every word is
+     *       only loaded once.
+    **/
+    template<typename UnaryFunction>
+    UnaryFunction for_each_set(UnaryFunction function) const
+    {
+        for (size_type index{0U}; index < m_words.size(); ++index) {
+            word_type word{m_words[index]};
+
+            while (word != 0U) {
+                function(
+                    (index * bits_per_word)
+                    + static_cast<size_type>(::pl::countr_zero(word)));
+
+                // clear the lowest set bit.
+                word &= word - 1U;
+            }
+        }
+
+        return function;
+    }
+
+    /*!
+     * \brief Bitwise ANDs the bits of 'other' into this object.
+     * \param other The bitset to AND with. Must have the same size!
+     * \return A reference to this object.
+    **/
+    this_type& operator&=(PL_IN const this_type& other)
+    {
+        return apply<detail::bitset_op::and_assign>(other);
+    }
+
+    /*!
+     * \brief Bitwise ORs the bits of 'other' into this object.
+     * \param other The bitset to OR with. Must have the same size!
+     * \return A reference to this object.
+    **/
+    this_type& operator|=(PL_IN const this_type& other)
+    {
+        return apply<detail::bitset_op::or_assign>(other);
+    }
+
+    /*!
+     * \brief Bitwise XORs the bits of 'other' into this object.
+     * \param other The bitset to XOR with. Must have the same size!
+     * \return A reference to this object.
+    **/
+    this_type& operator^=(PL_IN const this_type& other)
+    {
+        return apply<detail::bitset_op::xor_assign>(other);
+    }
+
+    /*!
+     * \brief Clears the bits that are set in 'other', that is
+     *        *this &= ~other without creating a temporary.
+     * \param other The bits to clear. Must have the same size!
+     * \return A reference to this object.
+    **/
+    this_type& and_not(PL_IN const this_type& other)
+    {
+        return apply<detail::bitset_op::and_not_assign>(other);
+    }
+
+    /*!
+     * \brief Returns a copy with all bits toggled.
+    **/
+    this_type operator~() const
+    {
+        this_type result{*this};
+        result.flip();
+        return result;
+    }
+
+    friend this_type operator&(this_type lhs, PL_IN const this_type& rhs)
+    {
+        lhs &= rhs;
+        return lhs;
+    }
+
+    friend this_type operator|(this_type lhs, PL_IN const this_type& rhs)
+    {
+        lhs |= rhs;
+        return lhs;
+    }
+
+    friend this_type operator^(this_type lhs, PL_IN const this_type& rhs)
+    {
+        lhs ^= rhs;
+        return lhs;
+    }
+
+    friend bool operator==(
+        PL_IN const this_type& lhs,
+        PL_IN const this_type& rhs) noexcept
+    {
+        return (lhs.m_size == rhs.m_size)
+               and std::equal(
+                   lhs.m_words.begin(), lhs.m_words.end(), rhs.m_words.begin());
+    }
+
+    friend bool operator!=(
+        PL_IN const this_type& lhs,
+        PL_IN const this_type& rhs) noexcept
+    {
+        return not(lhs == rhs);
+    }
+
+    /*!
+     * \brief Exchanges the bits of this object and 'other'.
+     * \param other The other basic_dynamic_bitset.
+    **/
+    void swap(PL_INOUT this_type& other) noexcept
+    {
+        using std::swap;
+        swap(m_words, other.m_words);
+        swap(m_size, other.m_size);
+    }
+
+    friend void swap(PL_INOUT this_type& lhs, PL_INOUT this_type& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+
+private:
+    static size_type word_count_for(size_type bit_count) noexcept
+    {
+        return (bit_count + bits_per_word - 1U) / bits_per_word;
+    }
+
+    /*!
+     * \brief Restores the invariant that the bits beyond size() are 0.
+    **/
+    void clear_unused_bits() noexcept
+    {
+        const size_type used_bits{m_size % bits_per_word};
+
+        if (used_bits != 0U) {
+            m_words.back() &= (word_type{1U} << used_bits) - 1U;
+        }
+    }
+
+    size_type find_from_word(size_type index) const noexcept
+    {
+        for (; index < m_words.size(); ++index) {
+            if (m_words[index] != 0U) {
+                return (index * bits_per_word)
+                       + static_cast<size_type>(
+                           ::pl::countr_zero(m_words[index]));
+            }
+        }
+
+        return npos;
+    }
+
+    void apply_range(size_type first, size_type last, bool value) noexcept
+    {
+        if (first == last) {
+            return;
+        }
+
+        const size_type first_word{first / bits_per_word};
+        const size_type last_word{(last - 1U) / bits_per_word};
+        const word_type first_mask{~word_type{0U} << (first % bits_per_word)};
+        const word_type last_mask{~word_type{0U}
+                                  >> (bits_per_word - 1U
+                                      - ((last - 1U) % bits_per_word))};
+
+        if (first_word == last_word) {
+            apply_mask(m_words[first_word], first_mask & last_mask, value);
+            return;
+        }
+
+        apply_mask(m_words[first_word], first_mask, value);
+        std::fill(
+            m_words.begin() + static_cast<std::ptrdiff_t>(first_word + 1U),
+            m_words.begin() + static_cast<std::ptrdiff_t>(last_word),
+            value ? ~word_type{0U} : word_type{0U});
+        apply_mask(m_words[last_word], last_mask, value);
+    }
+
+    static void apply_mask(word_type& word, word_type mask, bool value) noexcept
+    {
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    template<detail::bitset_op Op>
+    this_type& apply(PL_IN const this_type& other)
+    {
+        PL_DBG_CHECK_PRE(m_size == other.m_size);
+
+        detail::best_bitset_kernel<Op>()(
+            m_words.data(), other.m_words.data(), m_words.size());
+        return *this;
+    }
+
+    std::vector<word_type, allocator_type> m_words;
+    size_type                              m_size;
+};
+
+template<typename Allocator>
+constexpr typename basic_dynamic_bitset<Allocator>::size_type
+    basic_dynamic_bitset<Allocator>::bits_per_word;
+
+template<typename Allocator>
+constexpr typename basic_dynamic_bitset<Allocator>::size_type
+    basic_dynamic_bitset<Allocator>::npos;
+
+/*!
+ * \brief A basic_dynamic_bitset storing its words in cache line aligned
+ *        memory.
+**/
+using dynamic_bitset = basic_dynamic_bitset<>;
+} // namespace pl
+#endif // INCG_PL_DYNAMIC_BITSET_HPP
@@ -0,0 +1,288 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file endian.hpp
+ * \brief Exports the big_endian and little_endian class templates that store
+ *        a value in a fixed byte order, for use as the fields of structs that
+ *        describe binary formats, as well as the overlay function template
+ *        to view a received buffer as such a struct.
+**/
+#ifndef INCG_PL_ENDIAN_HPP
+#define INCG_PL_ENDIAN_HPP
+#include "annotations.hpp"            // PL_IN, PL_INOUT
+#include "bswap.hpp"                  // pl::bswap
+#include "byte.hpp"                   // pl::byte
+#include "compiler.hpp"               // PL_COMPILER, PL_COMPILER_MSVC
+#include "unrelated_pointer_cast.hpp" // pl::unrelated_pointer_cast
+#include <ciso646>                    // and, or, not
+#include <cstddef>                    // std::size_t
+#include <cstdint>                    // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <cstring>                    // std::memcpy, std::memcmp
+#include <type_traits>                // std::is_arithmetic, std::is_enum, std::is_trivially_copyable
+
+namespace pl {
+/*!
+ * \brief The byte orders, like std::endian from C++20.
+**/
+enum class endian {
+    little, //!< least significant byte first.
+    big,    //!< most significant byte first.
+#if (PL_COMPILER == PL_COMPILER_MSVC) \
+    or (defined(__BYTE_ORDER__) and (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+    native = little //!< the byte order of the target platform.
+#elif defined(__BYTE_ORDER__) and (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    native = big //!< the byte order of the target platform.
+#else
+#error "Unable to determine the byte order of the target platform."
+#endif
+};
+
+namespace detail {
+/*!
+ * \brief The unsigned integer type with 'Size' bytes.
+ *        Not to be used directly.
+**/
+template<std::size_t Size>
+struct endian_word;
+
+template<>
+struct endian_word<1U> {
+    using type = std::uint8_t;
+};
+
+template<>
+struct endian_word<2U> {
+    using type = std::uint16_t;
+};
+
+template<>
+struct endian_word<4U> {
+    using type = std::uint32_t;
+};
+
+template<>
+struct endian_word<8U> {
+    using type = std::uint64_t;
+};
+} // namespace detail
+
+/*!
+ * \brief Stores a value of type Ty as sizeof(Ty) raw bytes in the byte
+ *        order 'Order', regardless of the byte order of the platform.
+ *        The value is only converted when it is read or written.
+ * \note Has an alignment of 1 and no padding, so it can be used for the
+ *       fields of structs that describe binary formats and that are
+ *       overlaid on a buffer of received bytes using pl::overlay.
+ * \note Ty must be an arithmetic or enumeration type of 1, 2, 4 or 8 bytes.
+ * \see big_endian
+ * \see little_endian
+**/
+template<typename Ty, endian Order>
+class endian_value {
+public:
+    static_assert(
+        std::is_arithmetic<Ty>::value or std::is_enum<Ty>::value,
+        "Ty must be an arithmetic or enumeration type.");
+    static_assert(
+        (sizeof(Ty) == 1U) or (sizeof(Ty) == 2U) or (sizeof(Ty) == 4U)
+            or (sizeof(Ty) == 8U),
+        "Ty must be 1, 2, 4 or 8 bytes large.");
+
+    using this_type  = endian_value;
+    using value_type = Ty;
+
+    static constexpr endian order = Order;
+
+    /*!
+     * \brief Leaves the bytes uninitialized, so that this type is trivial.
+    **/
+    endian_value() noexcept = default;
+
+    /*!
+     * \brief Stores 'value' in the byte order 'Order'.
+     * \param value The value to store.
+    **/
+    explicit endian_value(value_type value) noexcept : m_bytes{}
+    {
+        store(value);
+    }
+
+    /*!
+     * \brief Stores 'value' in the byte order 'Order'.
+     * \param value The value to store.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(value_type value) noexcept
+    {
+        store(value);
+        return *this;
+    }
+
+    /*!
+     * \brief Reads the value, converting it to the native byte order.
+     * \return The value stored.
+    **/
+    value_type value() const noexcept
+    {
+        word_type word;
+        std::memcpy(&word, m_bytes, sizeof(word));
+
+        if (Order != endian::native) {
+            word = ::pl::bswap(word);
+        }
+
+        value_type result;
+        std::memcpy(&result, &word, sizeof(result));
+        return result;
+    }
+
+    /*!
+     * \brief Reads the value, converting it to the native byte order.
+     * \return The value stored.
+    **/
+    operator value_type() const noexcept { return value(); }
+
+    /*!
+     * \brief Returns the raw bytes in the byte order 'Order'.
+    **/
+    byte* data() noexcept { return m_bytes; }
+
+    /*!
+     * \brief Returns the raw bytes in the byte order 'Order'.
+    **/
+    const byte* data() const noexcept { return m_bytes; }
+
+    /*!
+     * \brief Compares the raw bytes, which doesn't need any conversion.
+     * \param lhs The left hand side operand.
+     * \param rhs The right hand side operand.
+     * \return true if both store the same value, false otherwise.
+     * \note For floating point types this compares the representations:
+     *       NaN equals an identical NaN and 0.0 does not equal -0.0.
+    **/
+    friend bool operator==(const this_type& lhs, const this_type& rhs) noexcept
+    {
+        return std::memcmp(lhs.m_bytes, rhs.m_bytes, sizeof(value_type)) == 0;
+    }
+
+    /*!
+     * \brief Compares the raw bytes, which doesn't need any conversion.
+     * \param lhs The left hand side operand.
+     * \param rhs The right hand side operand.
+     * \return true if both store different values, false otherwise.
+    **/
+    friend bool operator!=(const this_type& lhs, const this_type& rhs) noexcept
+    {
+        return not(lhs == rhs);
+    }
+
+private:
+    using word_type = typename detail::endian_word<sizeof(value_type)>::type;
+
+    void store(value_type value) noexcept
+    {
+        word_type word;
+        std::memcpy(&word, &value, sizeof(word));
+
+        if (Order != endian::native) {
+            word = ::pl::bswap(word);
+        }
+
+        std::memcpy(m_bytes, &word, sizeof(word));
+    }
+
+    byte m_bytes[sizeof(value_type)];
+};
+
+template<typename Ty, endian Order>
+constexpr endian endian_value<Ty, Order>::order;
+
+/*!
+ * \brief A value of type Ty stored with the most significant byte first,
+ *        as used by most network protocols.
+**/
+template<typename Ty>
+using big_endian = endian_value<Ty, endian::big>;
+
+/*!
+ * \brief A value of type Ty stored with the least significant byte first.
+**/
+template<typename Ty>
+using little_endian = endian_value<Ty, endian::little>;
+
+/*!
+ * \brief Views the memory pointed to by 'buffer' as an object of type Wire,
+ *        without copying it.
+ * \param buffer The received bytes. May not be nullptr.
+ * \param byte_count The size of 'buffer' in bytes.
+ * \return A pointer to the Wire object or nullptr if 'buffer' is too small.
+ * \note Wire must be trivially copyable and have an alignment of 1,
+ *       typically a struct of big_endian, little_endian and byte array
+ *       fields.
+ *
+ * Fields of the object returned are only converted to the native byte order
+ * when they are read, so fields that aren't accessed cost nothing.
+**/
+template<typename Wire>
+inline Wire* overlay(PL_INOUT void* buffer, std::size_t byte_count) noexcept
+{
+    static_assert(
+        std::is_trivially_copyable<Wire>::value,
+        "Wire must be trivially copyable.");
+    static_assert(alignof(Wire) == 1U, "Wire must have an alignment of 1.");
+
+    return byte_count < sizeof(Wire)
+               ? nullptr
+               : ::pl::unrelated_pointer_cast<Wire*>(buffer);
+}
+
+/*!
+ * \brief Views the memory pointed to by 'buffer' as an object of type Wire,
+ *        without copying it.
+ * \param buffer The received bytes. May not be nullptr.
+ * \param byte_count The size of 'buffer' in bytes.
+ * \return A pointer to the Wire object or nullptr if 'buffer' is too small.
+ * \note Wire must be trivially copyable and have an alignment of 1,
+ *       typically a struct of big_endian, little_endian and byte array
+ *       fields.
+**/
+template<typename Wire>
+inline const Wire* overlay(
+    PL_IN const void* buffer,
+    std::size_t       byte_count) noexcept
+{
+    static_assert(
+        std::is_trivially_copyable<Wire>::value,
+        "Wire must be trivially copyable.");
+    static_assert(alignof(Wire) == 1U, "Wire must have an alignment of 1.");
+
+    return byte_count < sizeof(Wire)
+               ? nullptr
+               : ::pl::unrelated_pointer_cast<const Wire*>(buffer);
+}
+} // namespace pl
+#endif // INCG_PL_ENDIAN_HPP
@@ -28,16 +28,82 @@
  * \file hash.hpp
  * \brief Header file that defines hashing utilities.
  *        So that implementing hash functions for user defined types
- *        becomes easier.
+ *        becomes easier. Also defines fast non-cryptographic hash
+ *        functions for contiguous memory.
 **/
 #ifndef INCG_PL_HASH_HPP
 #define INCG_PL_HASH_HPP
-#include "annotations.hpp"  // PL_IN, PL_INOUT
-#include <cstddef>          // std::size_t
-#include <functional>       // std::hash
-#include <initializer_list> // std::initializer_list
+#include "annotations.hpp"          // PL_IN, PL_INOUT, PL_NODISCARD
+#include "assert.hpp"               // PL_DBG_CHECK_PRE
+#include "byte.hpp"                 // pl::byte
+#include "compiler.hpp"             // PL_COMPILER, PL_COMPILER_MSVC
+#include "cpu_features.hpp"         // pl::detected_cpu_features, PL_TARGET, PL_CPU_X86
+#include "meta/detection_idiom.hpp" // pl::meta::is_detected
+#include "type_traits.hpp"          // pl::remove_cv_t
+#include <ciso646>                  // and, or
+#include <cstddef>                  // std::size_t
+#include <cstdint>                  // std::uint32_t, std::uint64_t
+#include <cstring>                  // std::memcpy
+#include <functional>               // std::hash
+#include <initializer_list>         // std::initializer_list
+#include <iterator>                 // std::iterator_traits, std::begin, std::end, std::contiguous_iterator
+#include <memory>                   // std::addressof
+#include <tuple>                    // std::tuple, std::get
+#include <type_traits>              // std::integral_constant, std::is_integral, std::is_enum, std::is_pointer, std::true_type, std::false_type
+#include <utility>                  // std::declval, std::pair, std::index_sequence, std::index_sequence_for
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version> // __cpp_lib_concepts
+#endif
+#endif
+#if PL_CPU_X86
+#include <immintrin.h> // _mm_crc32_u8, _mm_crc32_u32, _mm_crc32_u64
+#endif
+#if (PL_COMPILER == PL_COMPILER_MSVC) && defined(_M_X64)
+#include <intrin.h> // _umul128
+#endif
 
 namespace pl {
+/*!
+ * \brief Mixes the bits of 'value' so that flipping any input bit flips
+ *        every output bit with a probability of about one half.
+ * \param value The value to mix.
+ * \return The mixed value.
+ *
+ * This is the finalizer of SplitMix64. It is a bijection, so distinct
+ * inputs never produce the same output.
+**/
+inline std::uint64_t mix64(std::uint64_t value) noexcept
+{
+    value ^= value >> 30U;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27U;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31U;
+    return value;
+}
+
+/*!
+ * \brief Combines the hash value 'value' into 'hash_seed'.
+ * \param hash_seed The hash seed to combine 'value' into.
+ * \param value The hash value to combine into 'hash_seed'.
+ *
+ * Unlike the classic seed ^= value + 0x9E3779B9 + (seed << 6) + ...
+ * combiner the result is passed through mix64, so even hash values
+ * that only differ in a few low bits, like the ones std::hash generates
+ * for integers, are spread over all bits of the result.
+ * The order in which values are combined matters.
+**/
+inline void hash_combine(
+    PL_INOUT std::size_t& hash_seed,
+    std::size_t           value) noexcept
+{
+    static constexpr std::uint64_t golden_ratio{0x9E3779B97F4A7C15ULL};
+
+    hash_seed = static_cast<std::size_t>(
+        mix64(std::uint64_t{hash_seed} + golden_ratio + value));
+}
+
 namespace detail {
 /*!
  * \brief Adds the hash generated for hashable to the current hash_seed.
@@ -50,13 +116,307 @@ void add_hash(
     PL_INOUT std::size_t& hash_seed,
     PL_IN const Hashable& hashable) noexcept
 {
-    static constexpr auto shift_right  = 0x2;
-    static constexpr auto shift_left   = 0x6;
-    static constexpr auto golden_ratio = 0x9E3779B9;
-
     std::hash<Hashable> hasher{};
-    hash_seed ^= hasher(hashable) + golden_ratio + (hash_seed << shift_left)
-                 + (hash_seed >> shift_right);
+    hash_combine(hash_seed, hasher(hashable));
+}
+
+/*!
+ * \brief Multiplies 'a' and 'b' to a 128 bit product without using
+ *        compiler extensions. Not to be used directly.
+ * \param a The first factor, receives the low 64 bits of the product.
+ * \param b The second factor, receives the high 64 bits of the product.
+**/
+inline void multiply_128_portable(
+    PL_INOUT std::uint64_t& a,
+    PL_INOUT std::uint64_t& b) noexcept
+{
+    const std::uint64_t a_high{a >> 32U};
+    const std::uint64_t a_low{a & 0xFFFFFFFFULL};
+    const std::uint64_t b_high{b >> 32U};
+    const std::uint64_t b_low{b & 0xFFFFFFFFULL};
+
+    const std::uint64_t high{a_high * b_high};
+    const std::uint64_t middle0{a_high * b_low};
+    const std::uint64_t middle1{b_high * a_low};
+    const std::uint64_t low{a_low * b_low};
+
+    const std::uint64_t partial{low + (middle0 << 32U)};
+    std::uint64_t       carry{partial < low ? 1U : 0U};
+    const std::uint64_t result_low{partial + (middle1 << 32U)};
+    carry += result_low < partial ? 1U : 0U;
+
+    a = result_low;
+    b = high + (middle0 >> 32U) + (middle1 >> 32U) + carry;
+}
+
+/*!
+ * \brief Multiplies 'a' and 'b' to a 128 bit product.
+ *        Not to be used directly.
+ * \param a The first factor, receives the low 64 bits of the product.
+ * \param b The second factor, receives the high 64 bits of the product.
+**/
+inline void multiply_128(
+    PL_INOUT std::uint64_t& a,
+    PL_INOUT std::uint64_t& b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128;
+
+    const uint128 product{static_cast<uint128>(a) * b};
+    a = static_cast<std::uint64_t>(product);
+    b = static_cast<std::uint64_t>(product >> 64U);
+#elif (PL_COMPILER == PL_COMPILER_MSVC) && defined(_M_X64)
+    a = _umul128(a, b, &b);
+#else
+    multiply_128_portable(a, b);
+#endif
+}
+
+/*!
+ * \brief Multiplies 'a' and 'b' and folds the 128 bit product into
+ *        64 bits. Not to be used directly.
+**/
+inline std::uint64_t multiply_mix(std::uint64_t a, std::uint64_t b) noexcept
+{
+    multiply_128(a, b);
+    return a ^ b;
+}
+
+/*!
+ * \brief Reads 8 bytes in native byte order. Not to be used directly.
+**/
+inline std::uint64_t read_u64(const byte* pointer) noexcept
+{
+    std::uint64_t result{};
+    std::memcpy(&result, pointer, sizeof(result));
+    return result;
+}
+
+/*!
+ * \brief Reads 4 bytes in native byte order. Not to be used directly.
+**/
+inline std::uint64_t read_u32(const byte* pointer) noexcept
+{
+    std::uint32_t result{};
+    std::memcpy(&result, pointer, sizeof(result));
+    return result;
+}
+
+/*!
+ * \brief Reads 1 to 3 bytes. Not to be used directly.
+**/
+inline std::uint64_t read_small(const byte* pointer, std::size_t size) noexcept
+{
+    return (std::uint64_t{pointer[0]} << 16U)
+           | (std::uint64_t{pointer[size >> 1U]} << 8U)
+           | std::uint64_t{pointer[size - 1U]};
+}
+
+/*!
+ * \brief The secret constants used by hash_bytes. Not to be used directly.
+**/
+struct hash_bytes_secret {
+    static constexpr std::uint64_t s0{0x2D358DCCAA6C78A5ULL};
+    static constexpr std::uint64_t s1{0x8BB84B93962EACC9ULL};
+    static constexpr std::uint64_t s2{0x4B33A62ED433D4A3ULL};
+    static constexpr std::uint64_t s3{0x4D5A2DA51DE1AA47ULL};
+};
+
+/*!
+ * \brief Mixes the seed of hash_bytes with the secret.
+ *        Not to be used directly.
+**/
+inline std::uint64_t hash_bytes_start(std::uint64_t seed) noexcept
+{
+    using secret = hash_bytes_secret;
+
+    return seed ^ multiply_mix(seed ^ secret::s0, secret::s1);
+}
+
+/*!
+ * \brief Reads the input of hash_bytes of at most 16 bytes into a and b.
+ *        Not to be used directly.
+**/
+inline void hash_bytes_short(
+    const byte*    p,
+    std::size_t    size,
+    std::uint64_t& a,
+    std::uint64_t& b) noexcept
+{
+    if (size >= 4U) {
+        const std::size_t offset{(size >> 3U) << 2U};
+        a = (read_u32(p) << 32U) | read_u32(p + offset);
+        b = (read_u32(p + size - 4U) << 32U) | read_u32(p + size - 4U - offset);
+    }
+    else if (size > 0U) {
+        a = read_small(p, size);
+    }
+}
+
+/*!
+ * \brief Processes 48 bytes of the input of hash_bytes in three lanes.
+ *        Not to be used directly.
+**/
+inline void hash_bytes_round48(
+    const byte*    p,
+    std::uint64_t& seed,
+    std::uint64_t& seed1,
+    std::uint64_t& seed2) noexcept
+{
+    using secret = hash_bytes_secret;
+
+    seed = multiply_mix(read_u64(p) ^ secret::s1, read_u64(p + 8U) ^ seed);
+    seed1
+        = multiply_mix(read_u64(p + 16U) ^ secret::s2, read_u64(p + 24U) ^ seed1);
+    seed2
+        = multiply_mix(read_u64(p + 32U) ^ secret::s3, read_u64(p + 40U) ^ seed2);
+}
+
+/*!
+ * \brief Processes 16 bytes of the input of hash_bytes.
+ *        Not to be used directly.
+**/
+inline std::uint64_t hash_bytes_round16(
+    const byte*   p,
+    std::uint64_t seed) noexcept
+{
+    using secret = hash_bytes_secret;
+
+    return multiply_mix(read_u64(p) ^ secret::s1, read_u64(p + 8U) ^ seed);
+}
+
+/*!
+ * \brief Computes the result of hash_bytes. Not to be used directly.
+**/
+inline std::uint64_t hash_bytes_finish(
+    std::uint64_t a,
+    std::uint64_t b,
+    std::uint64_t seed,
+    std::size_t   size) noexcept
+{
+    using secret = hash_bytes_secret;
+
+    a ^= secret::s1;
+    b ^= seed;
+    multiply_128(a, b);
+
+    return multiply_mix(a ^ secret::s0 ^ size, b ^ secret::s1);
+}
+
+/*!
+ * \brief The signature of the crc32c kernels. Not to be used directly.
+ *
+ * The kernels neither invert the crc on entry nor on exit.
+**/
+using crc32c_kernel = std::uint32_t (*)(std::uint32_t, const byte*, std::size_t);
+
+/*!
+ * \brief The lookup tables of the software crc32c implementation.
+ *        Not to be used directly.
+ *
+ * table[0] is the classic byte at a time table of the reflected
+ * Castagnoli polynomial, table[k] advances a byte that is followed by
+ * k more bytes, which allows processing 8 bytes per step.
+**/
+struct crc32c_tables {
+    constexpr crc32c_tables() noexcept : table{}
+    {
+        for (std::uint32_t i{0U}; i < 256U; ++i) {
+            std::uint32_t crc{i};
+
+            for (int bit{0}; bit < 8; ++bit) {
+                crc = (crc >> 1U) ^ ((crc & 1U) != 0U ? 0x82F63B78U : 0U);
+            }
+
+            table[0][i] = crc;
+        }
+
+        for (std::size_t k{1U}; k < 8U; ++k) {
+            for (std::size_t i{0U}; i < 256U; ++i) {
+                const std::uint32_t previous{table[k - 1U][i]};
+                table[k][i] = (previous >> 8U) ^ table[0][previous & 0xFFU];
+            }
+        }
+    }
+
+    std::uint32_t table[8][256];
+};
+
+/*!
+ * \brief Portable crc32c kernel, processes 8 bytes per step using
+ *        slicing-by-8. Not to be used directly.
+**/
+inline std::uint32_t crc32c_software(
+    std::uint32_t crc,
+    const byte*   data,
+    std::size_t   size) noexcept
+{
+    static constexpr crc32c_tables tables{};
+    const auto&                    t = tables.table;
+
+    for (; size >= 8U; data += 8U, size -= 8U) {
+        crc ^= std::uint32_t{data[0]} | (std::uint32_t{data[1]} << 8U)
+               | (std::uint32_t{data[2]} << 16U)
+               | (std::uint32_t{data[3]} << 24U);
+        crc = t[7][crc & 0xFFU] ^ t[6][(crc >> 8U) & 0xFFU]
+              ^ t[5][(crc >> 16U) & 0xFFU] ^ t[4][crc >> 24U]
+              ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]]
+              ^ t[0][data[7]];
+    }
+
+    for (; size != 0U; ++data, --size) {
+        crc = (crc >> 8U) ^ t[0][(crc ^ data[0]) & 0xFFU];
+    }
+
+    return crc;
+}
+
+#if PL_CPU_X86
+/*!
+ * \brief crc32c kernel using the SSE4.2 crc32 instruction.
+ *        Not to be used directly.
+**/
+PL_TARGET("sse4.2")
+inline std::uint32_t crc32c_sse42(
+    std::uint32_t crc,
+    const byte*   data,
+    std::size_t   size) noexcept
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    std::uint64_t wide_crc{crc};
+
+    for (; size >= 8U; data += 8U, size -= 8U) {
+        wide_crc = _mm_crc32_u64(wide_crc, read_u64(data));
+    }
+
+    crc = static_cast<std::uint32_t>(wide_crc);
+#else
+    for (; size >= 4U; data += 4U, size -= 4U) {
+        crc = _mm_crc32_u32(crc, static_cast<std::uint32_t>(read_u32(data)));
+    }
+#endif
+
+    for (; size != 0U; ++data, --size) {
+        crc = _mm_crc32_u8(crc, data[0]);
+    }
+
+    return crc;
+}
+#endif // PL_CPU_X86
+
+/*!
+ * \brief Returns the fastest crc32c kernel supported by the CPU.
+ *        Not to be used directly.
+**/
+inline crc32c_kernel best_crc32c_kernel() noexcept
+{
+#if PL_CPU_X86
+    static const crc32c_kernel kernel{
+        detected_cpu_features().sse42 ? &crc32c_sse42 : &crc32c_software};
+    return kernel;
+#else
+    return &crc32c_software;
+#endif
 }
 } // namespace detail
 
@@ -78,5 +438,436 @@ std::size_t hash(PL_IN const Args&... args) noexcept
 
     return hash_seed;
 }
+
+/*!
+ * \brief Function object that hashes keys using std::hash, except for
+ *        std::pair and std::tuple keys, whose elements are combined using
+ *        pl::hash, as there is no std::hash for them.
+ *
+ * Example:
+ * \code
+ * std::unordered_map<std::pair<int, std::string>, int,
+ *                    pl::key_hash<std::pair<int, std::string>>> map{};
+ * \endcode
+**/
+template <typename Key>
+struct key_hash : public std::hash<Key> {
+};
+
+/*!
+ * \brief Hashes std::pair keys by combining the hashes of both elements.
+**/
+template <typename First, typename Second>
+struct key_hash<std::pair<First, Second>> {
+    std::size_t operator()(PL_IN const std::pair<First, Second>& key) const
+        noexcept
+    {
+        return ::pl::hash(key.first, key.second);
+    }
+};
+
+/*!
+ * \brief Hashes std::tuple keys by combining the hashes of all elements.
+**/
+template <typename... Types>
+struct key_hash<std::tuple<Types...>> {
+    std::size_t operator()(PL_IN const std::tuple<Types...>& key) const
+        noexcept
+    {
+        return hash_elements(key, std::index_sequence_for<Types...>{});
+    }
+
+private:
+    template <std::size_t... Indices>
+    static std::size_t hash_elements(
+        PL_IN const std::tuple<Types...>& key,
+        std::index_sequence<Indices...>) noexcept
+    {
+        return ::pl::hash(std::get<Indices>(key)...);
+    }
+};
+
+/*!
+ * \brief Computes a fast, non-cryptographic 64 bit hash of 'size' bytes
+ *        beginning at 'data'.
+ * \param data The bytes to hash. May only be nullptr if 'size' is 0.
+ * \param size The amount of bytes to hash.
+ * \param seed The seed to use, different seeds yield unrelated hashes.
+ * \return The hash value.
+ *
+ * Follows the design of wyhash: inputs of up to 16 bytes are hashed
+ * with a single 64x64 -> 128 bit multiplication, longer inputs are
+ * processed in three independent lanes of 16 bytes each.
+ * The bytes are read in native byte order, so the result differs between
+ * little and big endian machines. Not suitable where an attacker controls
+ * the input and must not be able to provoke collisions.
+**/
+inline std::uint64_t hash_bytes(
+    PL_IN const void* data,
+    std::size_t       size,
+    std::uint64_t     seed = 0U)
+{
+    PL_DBG_CHECK_PRE((data != nullptr) or (size == 0U));
+
+    const byte* p{static_cast<const byte*>(data)};
+    seed = detail::hash_bytes_start(seed);
+    std::uint64_t a{0U};
+    std::uint64_t b{0U};
+
+    if (size <= 16U) {
+        detail::hash_bytes_short(p, size, a, b);
+    }
+    else {
+        std::size_t remaining{size};
+
+        if (remaining >= 48U) {
+            std::uint64_t seed1{seed};
+            std::uint64_t seed2{seed};
+
+            do {
+                detail::hash_bytes_round48(p, seed, seed1, seed2);
+                p += 48U;
+                remaining -= 48U;
+            } while (remaining >= 48U);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (remaining > 16U) {
+            seed = detail::hash_bytes_round16(p, seed);
+            p += 16U;
+            remaining -= 16U;
+        }
+
+        a = detail::read_u64(p + remaining - 16U);
+        b = detail::read_u64(p + remaining - 8U);
+    }
+
+    return detail::hash_bytes_finish(a, b, seed, size);
+}
+
+/*!
+ * \brief Computes the CRC-32C (Castagnoli) checksum of 'size' bytes
+ *        beginning at 'data'.
+ * \param data The bytes to checksum. May only be nullptr if 'size' is 0.
+ * \param size The amount of bytes to checksum.
+ * \param crc The crc of the preceding bytes, 0 to start a new checksum.
+ * \return The crc of all the bytes so far.
+ *
+ * The checksum can be computed piecewise: passing the result for the
+ * first part of a message as 'crc' when processing the rest yields the
+ * crc of the entire message.
+ * Uses the crc32 instruction of SSE4.2 if the CPU supports it and
+ * a table driven implementation otherwise.
+**/
+inline std::uint32_t crc32c(
+    PL_IN const void* data,
+    std::size_t       size,
+    std::uint32_t     crc = 0U)
+{
+    PL_DBG_CHECK_PRE((data != nullptr) or (size == 0U));
+
+    return ~detail::best_crc32c_kernel()(
+        ~crc, static_cast<const byte*>(data), size);
+}
+
+/*!
+ * \brief Type trait that tells whether two objects of type Ty compare
+ *        equal if and only if their object representations, that is
+ *        their bytes, are equal.
+ *
+ * Contiguous ranges of such types are hashed by hash_range as a single
+ * block of bytes. This holds for integers, enumerations and pointers, but
+ * not for floating point types (0.0 == -0.0) or types with padding.
+ * May be specialized for user defined types for which it holds, for
+ * instance structs of integers without padding whose operator==
+ * compares all members.
+**/
+template <typename Ty>
+struct is_uniquely_represented
+    : public std::integral_constant<
+          bool,
+          std::is_integral<Ty>::value or std::is_enum<Ty>::value
+              or std::is_pointer<Ty>::value> {
+};
+
+namespace detail {
+/*!
+ * \brief Whether Iterator is known to point to elements stored
+ *        contiguously in memory. Detects all contiguous iterators if
+ *        the standard library provides concepts, otherwise only pointers.
+ *        Not to be used directly.
+**/
+#ifdef __cpp_lib_concepts
+template <typename Iterator>
+struct is_contiguous_iterator
+    : public std::integral_constant<bool,
+                                    std::contiguous_iterator<Iterator>> {
+};
+#else
+template <typename Iterator>
+struct is_contiguous_iterator : public std::is_pointer<Iterator> {
+};
+#endif
+
+/*!
+ * \brief Computes hash_bytes of bytes passed in piecewise, yielding the
+ *        same result as passing them all at once. Not to be used directly.
+ *
+ * Buffers 48 bytes, the block size of hash_bytes, behind the last 16
+ * bytes of the previous block, which the end of hash_bytes may read.
+**/
+class hash_bytes_stream {
+public:
+    hash_bytes_stream() noexcept
+        : m_buffer{},
+          m_fill{0U},
+          m_size{0U},
+          m_seed{hash_bytes_start(0U)},
+          m_seed1{m_seed},
+          m_seed2{m_seed}
+    {
+    }
+
+    void update(const byte* data, std::size_t size) noexcept
+    {
+        m_size += size;
+
+        while (size > 0U) {
+            const std::size_t count{
+                (48U - m_fill) < size ? (48U - m_fill) : size};
+            std::memcpy(m_buffer + 16U + m_fill, data, count);
+            m_fill += count;
+            data += count;
+            size -= count;
+
+            if (m_fill == 48U) {
+                hash_bytes_round48(m_buffer + 16U, m_seed, m_seed1, m_seed2);
+                std::memcpy(m_buffer, m_buffer + 48U, 16U);
+                m_fill = 0U;
+            }
+        }
+    }
+
+    PL_NODISCARD std::uint64_t finish() const noexcept
+    {
+        std::uint64_t seed{m_seed};
+        std::uint64_t a{0U};
+        std::uint64_t b{0U};
+
+        if (m_size <= 16U) {
+            hash_bytes_short(m_buffer + 16U, m_size, a, b);
+        }
+        else {
+            if (m_size >= 48U) {
+                seed ^= m_seed1 ^ m_seed2;
+            }
+
+            const byte* p{m_buffer + 16U};
+            std::size_t remaining{m_fill};
+
+            while (remaining > 16U) {
+                seed = hash_bytes_round16(p, seed);
+                p += 16U;
+                remaining -= 16U;
+            }
+
+            a = read_u64(p + remaining - 16U);
+            b = read_u64(p + remaining - 8U);
+        }
+
+        return hash_bytes_finish(a, b, seed, m_size);
+    }
+
+private:
+    byte          m_buffer[64U];
+    std::size_t   m_fill; //!< the amount of bytes buffered behind the first 16
+    std::size_t   m_size;
+    std::uint64_t m_seed;
+    std::uint64_t m_seed1;
+    std::uint64_t m_seed2;
+};
+
+/*!
+ * \brief Hashes the bytes of elements that are not stored contiguously,
+ *        one element at a time. Not to be used directly.
+**/
+template <typename Iterator>
+std::size_t hash_range_bytes(
+    Iterator first,
+    Iterator last,
+    std::false_type /* is_contiguous_iterator */)
+{
+    using value_type
+        = remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+
+    hash_bytes_stream stream{};
+
+    for (; first != last; ++first) {
+        const value_type value(*first);
+        stream.update(reinterpret_cast<const byte*>(&value), sizeof(value));
+    }
+
+    return static_cast<std::size_t>(stream.finish());
+}
+
+/*!
+ * \brief Hashes the bytes of elements stored contiguously as a single
+ *        block. Not to be used directly.
+**/
+template <typename Iterator>
+std::size_t hash_range_bytes(
+    Iterator first,
+    Iterator last,
+    std::true_type /* is_contiguous_iterator */)
+{
+    using value_type
+        = remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+
+    if (first == last) {
+        return static_cast<std::size_t>(::pl::hash_bytes(nullptr, 0U));
+    }
+
+    return static_cast<std::size_t>(::pl::hash_bytes(
+        std::addressof(*first),
+        static_cast<std::size_t>(last - first) * sizeof(value_type)));
+}
+
+/*!
+ * \brief Hashes the elements one at a time using pl::key_hash.
+ *        Not to be used directly.
+**/
+template <typename Iterator>
+std::size_t hash_range_impl(
+    Iterator first,
+    Iterator last,
+    std::false_type /* is_uniquely_represented */)
+{
+    using value_type
+        = remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+
+    const key_hash<value_type> hasher{};
+    std::size_t                hash_seed{0U};
+    std::size_t                count{0U};
+
+    for (; first != last; ++first, ++count) {
+        hash_combine(hash_seed, hasher(*first));
+    }
+
+    hash_combine(hash_seed, count);
+    return hash_seed;
+}
+
+/*!
+ * \brief Hashes the bytes of the elements. Not to be used directly.
+**/
+template <typename Iterator>
+std::size_t hash_range_impl(
+    Iterator first,
+    Iterator last,
+    std::true_type /* is_uniquely_represented */)
+{
+    return hash_range_bytes(
+        first, last, is_contiguous_iterator<Iterator>{});
+}
+
+/*!
+ * \brief The type of range.data(). Not to be used directly.
+**/
+template <typename Range>
+using range_data_t = decltype(std::declval<const Range&>().data());
+
+/*!
+ * \brief The type of range.size(). Not to be used directly.
+**/
+template <typename Range>
+using range_size_t = decltype(std::declval<const Range&>().size());
+
+/*!
+ * \brief The type of std::begin(range). Not to be used directly.
+**/
+template <typename Range>
+using range_begin_t = decltype(std::begin(std::declval<const Range&>()));
+
+/*!
+ * \brief Whether Range is a range that stores its elements contiguously
+ *        and exposes them through data() and size(), like std::vector.
+ *        Not to be used directly.
+**/
+template <typename Range>
+struct is_contiguous_range
+    : public std::integral_constant<
+          bool,
+          meta::is_detected<range_begin_t, Range>::value
+              and std::is_pointer<
+                      meta::detected_t<range_data_t, Range>>::value
+              and meta::is_detected<range_size_t, Range>::value> {
+};
+
+} // namespace detail
+
+/*!
+ * \brief Computes a hash for the elements of the range [first, last).
+ * \param first Iterator to the first element.
+ * \param last Iterator one past the last element.
+ * \return The computed hash value.
+ *
+ * The result only depends on the elements, not on the kind of iterators
+ * or container. If is_uniquely_represented holds for the elements their
+ * bytes are hashed using hash_bytes, in a single call if the iterators
+ * are contiguous, otherwise pl::key_hash is called for every element and
+ * the results are combined using hash_combine.
+**/
+template <typename Iterator>
+std::size_t hash_range(Iterator first, Iterator last)
+{
+    using value_type
+        = remove_cv_t<typename std::iterator_traits<Iterator>::value_type>;
+
+    return detail::hash_range_impl(
+        first, last, is_uniquely_represented<value_type>{});
+}
+
+namespace detail {
+/*!
+ * \brief Hashes a range that stores its elements contiguously.
+ *        Not to be used directly.
+**/
+template <typename Range>
+std::size_t hash_range_dispatch(PL_IN const Range& range, std::true_type)
+{
+    const auto* const data = range.data();
+    return ::pl::hash_range(data, data + range.size());
+}
+
+/*!
+ * \brief Hashes a range using its iterators. Not to be used directly.
+**/
+template <typename Range>
+std::size_t hash_range_dispatch(PL_IN const Range& range, std::false_type)
+{
+    return ::pl::hash_range(std::begin(range), std::end(range));
+}
+} // namespace detail
+
+/*!
+ * \brief Computes a hash for the elements of a range.
+ * \param range The range to hash, such as a built-in array, a std::vector
+ *              or a std::list.
+ * \return The computed hash value.
+ *
+ * Ranges that store their elements contiguously and provide data() and
+ * size(), like std::vector, std::array or std::string, are hashed like
+ * hash_range(range.data(), range.data() + range.size()), so ranges of
+ * uniquely represented types are hashed as a single block of bytes.
+ * Other ranges are hashed like hash_range(std::begin(range),
+ * std::end(range)).
+**/
+template <typename Range>
+std::size_t hash_range(PL_IN const Range& range)
+{
+    return detail::hash_range_dispatch(
+        range, detail::is_contiguous_range<Range>{});
+}
 } // namespace pl
 #endif // INCG_PL_HASH_HPP
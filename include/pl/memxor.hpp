@@ -26,20 +26,358 @@
 
 /*!
  * \file memxor.hpp
- * \brief Exports the memxor function.
+ * \brief Exports the memxor and memxor_n functions.
 **/
 #ifndef INCG_PL_MEMXOR_HPP
 #define INCG_PL_MEMXOR_HPP
-#include "annotations.hpp" // PL_IN, PL_INOUT
-#include "assert.hpp"      // PL_DBG_CHECK_PRE
-#include "byte.hpp"        // pl::Byte
-#include "restrict.hpp"    // PL_RESTRICT
-#include <cstddef>         // std::size_t
+#include "annotations.hpp"  // PL_IN, PL_OUT, PL_INOUT
+#include "assert.hpp"       // PL_DBG_CHECK_PRE
+#include "byte.hpp"         // pl::Byte
+#include "cpu_features.hpp" // pl::simd_level, pl::best_simd_level, PL_TARGET, PL_CPU_X86
+#include "restrict.hpp"     // PL_RESTRICT
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint64_t, std::uintptr_t
+#include <cstring>          // std::memcpy
+#include <initializer_list> // std::initializer_list
+#if PL_CPU_X86
+#include <immintrin.h> // _mm_*, _mm256_*, _mm512_*
+#endif
 
 namespace pl {
+namespace detail {
+/*!
+ * \brief The signature of the memxor kernels. Not to be used directly.
+**/
+using memxor_kernel
+    = void (*)(byte* PL_RESTRICT, const byte* PL_RESTRICT, std::size_t);
+
+/*!
+ * \brief Returns the amount of bytes to process before 'pointer' is
+ *        aligned to 'alignment', at most 'byte_count'.
+ *        Not to be used directly.
+**/
+inline std::size_t bytes_until_aligned(
+    const void* pointer,
+    std::size_t alignment,
+    std::size_t byte_count) noexcept
+{
+    const std::size_t misalignment{static_cast<std::size_t>(
+        reinterpret_cast<std::uintptr_t>(pointer) & (alignment - 1U))};
+    const std::size_t head{
+        misalignment == 0U ? 0U : (alignment - misalignment)};
+    return head < byte_count ? head : byte_count;
+}
+
+/*!
+ * \brief xors a machine word at a time. Not to be used directly.
+**/
+inline void memxor_words(
+    byte* PL_RESTRICT       dest,
+    const byte* PL_RESTRICT src,
+    std::size_t             byte_count) noexcept
+{
+    while (byte_count >= sizeof(std::uint64_t)) {
+        std::uint64_t dest_word;
+        std::uint64_t src_word;
+        std::memcpy(&dest_word, dest, sizeof(dest_word));
+        std::memcpy(&src_word, src, sizeof(src_word));
+        dest_word ^= src_word;
+        std::memcpy(dest, &dest_word, sizeof(dest_word));
+
+        byte_count -= sizeof(std::uint64_t);
+        dest += sizeof(std::uint64_t);
+        src += sizeof(std::uint64_t);
+    }
+
+    while (byte_count > 0U) {
+        *dest ^= *src;
+
+        --byte_count;
+        ++dest;
+        ++src;
+    }
+}
+
+#if PL_CPU_X86
+/*!
+ * \brief xors 16 bytes at a time. Not to be used directly.
+**/
+PL_TARGET("sse2")
+inline void memxor_sse2(
+    byte* PL_RESTRICT       dest,
+    const byte* PL_RESTRICT src,
+    std::size_t             byte_count) noexcept
+{
+    const std::size_t head{bytes_until_aligned(dest, 16U, byte_count)};
+    memxor_words(dest, src, head);
+    dest += head;
+    src += head;
+    byte_count -= head;
+
+    while (byte_count >= 64U) {
+        __m128i* const       d{reinterpret_cast<__m128i*>(dest)};
+        const __m128i* const s{reinterpret_cast<const __m128i*>(src)};
+        const __m128i        a{
+            _mm_xor_si128(_mm_load_si128(d), _mm_loadu_si128(s))};
+        const __m128i b{
+            _mm_xor_si128(_mm_load_si128(d + 1), _mm_loadu_si128(s + 1))};
+        const __m128i c{
+            _mm_xor_si128(_mm_load_si128(d + 2), _mm_loadu_si128(s + 2))};
+        const __m128i e{
+            _mm_xor_si128(_mm_load_si128(d + 3), _mm_loadu_si128(s + 3))};
+        _mm_store_si128(d, a);
+        _mm_store_si128(d + 1, b);
+        _mm_store_si128(d + 2, c);
+        _mm_store_si128(d + 3, e);
+
+        byte_count -= 64U;
+        dest += 64U;
+        src += 64U;
+    }
+
+    while (byte_count >= 16U) {
+        __m128i* const d{reinterpret_cast<__m128i*>(dest)};
+        _mm_store_si128(
+            d,
+            _mm_xor_si128(
+                _mm_load_si128(d),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(src))));
+
+        byte_count -= 16U;
+        dest += 16U;
+        src += 16U;
+    }
+
+    memxor_words(dest, src, byte_count);
+}
+
+/*!
+ * \brief xors 32 bytes at a time. Not to be used directly.
+**/
+PL_TARGET("avx2")
+inline void memxor_avx2(
+    byte* PL_RESTRICT       dest,
+    const byte* PL_RESTRICT src,
+    std::size_t             byte_count) noexcept
+{
+    const std::size_t head{bytes_until_aligned(dest, 32U, byte_count)};
+    memxor_words(dest, src, head);
+    dest += head;
+    src += head;
+    byte_count -= head;
+
+    while (byte_count >= 128U) {
+        __m256i* const       d{reinterpret_cast<__m256i*>(dest)};
+        const __m256i* const s{reinterpret_cast<const __m256i*>(src)};
+        const __m256i        a{
+            _mm256_xor_si256(_mm256_load_si256(d), _mm256_loadu_si256(s))};
+        const __m256i b{_mm256_xor_si256(
+            _mm256_load_si256(d + 1), _mm256_loadu_si256(s + 1))};
+        const __m256i c{_mm256_xor_si256(
+            _mm256_load_si256(d + 2), _mm256_loadu_si256(s + 2))};
+        const __m256i e{_mm256_xor_si256(
+            _mm256_load_si256(d + 3), _mm256_loadu_si256(s + 3))};
+        _mm256_store_si256(d, a);
+        _mm256_store_si256(d + 1, b);
+        _mm256_store_si256(d + 2, c);
+        _mm256_store_si256(d + 3, e);
+
+        byte_count -= 128U;
+        dest += 128U;
+        src += 128U;
+    }
+
+    while (byte_count >= 32U) {
+        __m256i* const d{reinterpret_cast<__m256i*>(dest)};
+        _mm256_store_si256(
+            d,
+            _mm256_xor_si256(
+                _mm256_load_si256(d),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src))));
+
+        byte_count -= 32U;
+        dest += 32U;
+        src += 32U;
+    }
+
+    memxor_words(dest, src, byte_count);
+}
+
+/*!
+ * \brief Returns a mask selecting the first 'byte_count' bytes of a 512 bit
+ *        vector. Not to be used directly.
+**/
+inline __mmask64 avx512_byte_mask(std::size_t byte_count) noexcept
+{
+    return byte_count >= 64U ? ~__mmask64{0U}
+                             : ((__mmask64{1U} << byte_count) - 1U);
+}
+
+/*!
+ * \brief xors 64 bytes at a time, using masked loads and stores for the
+ *        unaligned head and the tail. Not to be used directly.
+**/
+PL_TARGET("avx512f,avx512bw")
+inline void memxor_avx512(
+    byte* PL_RESTRICT       dest,
+    const byte* PL_RESTRICT src,
+    std::size_t             byte_count) noexcept
+{
+    const std::size_t head{bytes_until_aligned(dest, 64U, byte_count)};
+
+    if (head != 0U) {
+        const __mmask64 mask{avx512_byte_mask(head)};
+        _mm512_mask_storeu_epi8(
+            dest,
+            mask,
+            _mm512_xor_si512(
+                _mm512_maskz_loadu_epi8(mask, dest),
+                _mm512_maskz_loadu_epi8(mask, src)));
+        dest += head;
+        src += head;
+        byte_count -= head;
+    }
+
+    while (byte_count >= 256U) {
+        const __m512i a{_mm512_xor_si512(
+            _mm512_load_si512(dest), _mm512_loadu_si512(src))};
+        const __m512i b{_mm512_xor_si512(
+            _mm512_load_si512(dest + 64U), _mm512_loadu_si512(src + 64U))};
+        const __m512i c{_mm512_xor_si512(
+            _mm512_load_si512(dest + 128U), _mm512_loadu_si512(src + 128U))};
+        const __m512i e{_mm512_xor_si512(
+            _mm512_load_si512(dest + 192U), _mm512_loadu_si512(src + 192U))};
+        _mm512_store_si512(dest, a);
+        _mm512_store_si512(dest + 64U, b);
+        _mm512_store_si512(dest + 128U, c);
+        _mm512_store_si512(dest + 192U, e);
+
+        byte_count -= 256U;
+        dest += 256U;
+        src += 256U;
+    }
+
+    while (byte_count > 0U) {
+        const __mmask64 mask{avx512_byte_mask(byte_count)};
+        _mm512_mask_storeu_epi8(
+            dest,
+            mask,
+            _mm512_xor_si512(
+                _mm512_maskz_loadu_epi8(mask, dest),
+                _mm512_maskz_loadu_epi8(mask, src)));
+
+        const std::size_t processed{byte_count < 64U ? byte_count : 64U};
+        byte_count -= processed;
+        dest += processed;
+        src += processed;
+    }
+}
+#endif // PL_CPU_X86
+
+/*!
+ * \brief Returns the memxor kernel for 'level', which must be supported by
+ *        the CPU. Not to be used directly.
+**/
+inline memxor_kernel memxor_kernel_for(simd_level level) noexcept
+{
+#if PL_CPU_X86
+    switch (level) {
+    case simd_level::avx512: return &memxor_avx512;
+    case simd_level::avx2: return &memxor_avx2;
+    case simd_level::ssse3:
+    case simd_level::sse2: return &memxor_sse2;
+    case simd_level::none: break;
+    }
+#else
+    static_cast<void>(level);
+#endif
+    return &memxor_words;
+}
+
+/*!
+ * \brief Returns the memxor kernel for the most capable SIMD instruction set
+ *        supported by the CPU, which is detected once.
+ *        Not to be used directly.
+**/
+inline memxor_kernel best_memxor_kernel() noexcept
+{
+    static const memxor_kernel kernel{memxor_kernel_for(best_simd_level())};
+    return kernel;
+}
+
+/*!
+ * \brief The amount of bytes of the destination that the multi source
+ *        functions keep in the L1 cache while applying every source to them.
+ *        Not to be used directly.
+**/
+constexpr std::size_t memxor_block_size{4096U};
+
+/*!
+ * \brief xor-assigns the 'source_count' buffers in 'sources' to 'dest'
+ *        one cache sized block at a time, so that 'dest' is only
+ *        transferred from and to memory once. Not to be used directly.
+**/
+inline void memxor_blocked(
+    byte*              dest,
+    const void* const* sources,
+    std::size_t        source_count,
+    std::size_t        byte_count) noexcept
+{
+    const memxor_kernel kernel{best_memxor_kernel()};
+
+    for (std::size_t offset{0U}; offset < byte_count;
+         offset += memxor_block_size) {
+        const std::size_t remaining{byte_count - offset};
+        const std::size_t block_size{
+            remaining < memxor_block_size ? remaining : memxor_block_size};
+
+        for (std::size_t i{0U}; i < source_count; ++i) {
+            kernel(
+                dest + offset,
+                static_cast<const byte*>(sources[i]) + offset,
+                block_size);
+        }
+    }
+}
+} // namespace detail
+
+/*!
+ * \brief Bytewise xor-assigns the memory pointed to by 'destination'
+ *        with the memory pointed to by 'source'.
+ * \param destination The buffer that will be xor-assigned to.
+ *                    May not be nullptr!
+ * \param source The buffer with which 'destination' shall be xored.
+ *               May not be nullptr!
+ * \param byte_count The size in bytes of the source buffer.
+ *                  The destination buffer must be at least as large as
+ *                  'byte_count'. You probably want to use buffers of equal
+ *                  byte size for 'destination' and 'source'.
+ * \param level The SIMD instruction set to use. Falls back to the most
+ *              capable one supported by the CPU if it is not supported.
+ * \return 'destination' is returned.
+ * \warning Make sure 'byte_count' is correct!
+**/
+inline void* memxor(
+    PL_INOUT void* PL_RESTRICT destination,
+    PL_IN const void* PL_RESTRICT source,
+    std::size_t                   byte_count,
+    simd_level                    level)
+{
+    PL_DBG_CHECK_PRE(destination != nullptr);
+    PL_DBG_CHECK_PRE(source != nullptr);
+
+    detail::memxor_kernel_for(supported_simd_level(level))(
+        static_cast<byte*>(destination),
+        static_cast<const byte*>(source),
+        byte_count);
+
+    return destination;
+}
+
 /*!
  * \brief Bytewise xor-assigns the memory pointed to by 'destination'
  *        with the memory pointed to by 'source'.
+ *        Uses the widest vectors supported by the CPU, detected once.
  * \param destination The buffer that will be xor-assigned to.
  *                    May not be nullptr!
  * \param source The buffer with which 'destination' shall be xored.
@@ -59,18 +397,123 @@ inline void* memxor(
     PL_DBG_CHECK_PRE(destination != nullptr);
     PL_DBG_CHECK_PRE(source != nullptr);
 
-    auto dest = static_cast<byte * PL_RESTRICT>(destination);
-    auto src  = static_cast<const byte * PL_RESTRICT>(source);
+    byte* const       dest{static_cast<byte*>(destination)};
+    const byte* const src{static_cast<const byte*>(source)};
 
-    while (byte_count > 0) {
-        *dest ^= *src;
+    // not worth an indirect call.
+    if (byte_count < 64U) {
+        detail::memxor_words(dest, src, byte_count);
+        return destination;
+    }
 
-        --byte_count;
-        ++dest;
-        ++src;
+    detail::best_memxor_kernel()(dest, src, byte_count);
+
+    return destination;
+}
+
+/*!
+ * \brief Stores the bytewise xor of the memory pointed to by 'first' and the
+ *        memory pointed to by 'second' into 'destination'.
+ *        'destination' does not need to be initialized beforehand.
+ * \param destination The buffer to write to. May not be nullptr!
+ *                    May be the same as 'first', but may not overlap
+ *                    with 'second' or partially overlap with 'first'.
+ * \param first The first operand. May not be nullptr!
+ * \param second The second operand. May not be nullptr!
+ * \param byte_count The amount of bytes to process. All three buffers must
+ *                   be at least as large as 'byte_count'.
+ * \return 'destination' is returned.
+ * \warning Make sure 'byte_count' is correct!
+**/
+inline void* memxor(
+    PL_OUT void* destination,
+    PL_IN const void* first,
+    PL_IN const void* second,
+    std::size_t       byte_count)
+{
+    PL_DBG_CHECK_PRE(destination != nullptr);
+    PL_DBG_CHECK_PRE(first != nullptr);
+    PL_DBG_CHECK_PRE(second != nullptr);
+
+    byte* const                 dest{static_cast<byte*>(destination)};
+    const detail::memxor_kernel kernel{
+        byte_count < 64U ? &detail::memxor_words
+                         : detail::best_memxor_kernel()};
+
+    // copy a block of 'first' and xor 'second' into it while it is still
+    // in the L1 cache.
+    for (std::size_t offset{0U}; offset < byte_count;
+         offset += detail::memxor_block_size) {
+        const std::size_t remaining{byte_count - offset};
+        const std::size_t block_size{
+            remaining < detail::memxor_block_size ? remaining
+                                                  : detail::memxor_block_size};
+
+        if (destination != first) {
+            std::memcpy(
+                dest + offset,
+                static_cast<const byte*>(first) + offset,
+                block_size);
+        }
+
+        kernel(
+            dest + offset,
+            static_cast<const byte*>(second) + offset,
+            block_size);
     }
 
     return destination;
 }
+
+/*!
+ * \brief Bytewise xor-assigns every buffer in 'sources' to 'destination'
+ *        in a single cache blocked pass, as used to compute RAID style
+ *        parity. Equivalent to calling memxor for every source in turn,
+ *        but reads and writes 'destination' only once.
+ * \param destination The buffer that will be xor-assigned to.
+ *                    May not be nullptr! May not overlap with any source.
+ * \param sources Pointer to the first of 'source_count' source buffers.
+ *                May only be nullptr if 'source_count' is 0.
+ *                None of the source buffers may be nullptr!
+ * \param source_count The amount of source buffers.
+ * \param byte_count The amount of bytes to process. All buffers must be at
+ *                   least as large as 'byte_count'.
+ * \return 'destination' is returned.
+ * \warning Make sure 'byte_count' is correct!
+**/
+inline void* memxor_n(
+    PL_INOUT void* destination,
+    PL_IN const void* const* sources,
+    std::size_t              source_count,
+    std::size_t              byte_count)
+{
+    PL_DBG_CHECK_PRE(destination != nullptr);
+    PL_DBG_CHECK_PRE((sources != nullptr) or (source_count == 0U));
+
+    detail::memxor_blocked(
+        static_cast<byte*>(destination), sources, source_count, byte_count);
+
+    return destination;
+}
+
+/*!
+ * \brief Bytewise xor-assigns every buffer in 'sources' to 'destination'
+ *        in a single cache blocked pass, as used to compute RAID style
+ *        parity.
+ * \param destination The buffer that will be xor-assigned to.
+ *                    May not be nullptr! May not overlap with any source.
+ * \param sources The source buffers. None of them may be nullptr!
+ * \param byte_count The amount of bytes to process. All buffers must be at
+ *                   least as large as 'byte_count'.
+ * \return 'destination' is returned.
+ * \warning Make sure 'byte_count' is correct!
+**/
+inline void* memxor_n(
+    PL_INOUT void* destination,
+    std::initializer_list<const void*> sources,
+    std::size_t                        byte_count)
+{
+    return memxor_n(destination, sources.begin(), sources.size(), byte_count);
+}
 } // namespace pl
 #endif // INCG_PL_MEMXOR_HPP
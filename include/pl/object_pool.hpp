@@ -0,0 +1,743 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file object_pool.hpp
+ * \brief Exports the object_pool type, a thread safe allocator for objects
+ *        of a fixed size, and the object_pool_allocator STL allocator
+ *        adapter.
+**/
+#ifndef INCG_PL_OBJECT_POOL_HPP
+#define INCG_PL_OBJECT_POOL_HPP
+#include "annotations.hpp" // PL_IN, PL_NODISCARD
+#include "assert.hpp"      // PL_DBG_CHECK_PRE
+#include <atomic>          // std::atomic
+#include <ciso646>         // not, and
+#include <cstddef>         // std::size_t, std::ptrdiff_t, std::max_align_t
+#include <limits>          // std::numeric_limits
+#include <memory>          // std::shared_ptr, std::weak_ptr, std::make_shared, std::unique_ptr
+#include <mutex>           // std::mutex, std::lock_guard
+#include <new>             // ::operator new, ::operator delete, std::bad_alloc
+#include <utility>         // std::forward
+#include <vector>          // std::vector
+
+namespace pl {
+/*!
+ * \brief Configuration of an object_pool.
+**/
+struct object_pool_options {
+    std::size_t objects_per_slab = 256U; /*!< the amount of objects allocated
+                                          *   from the heap at once.
+                                         **/
+    std::size_t batch_size = 32U;        /*!< the amount of objects moved
+                                          *   between a thread cache and the
+                                          *   depot at once.
+                                         **/
+    bool thread_caches = true;           /*!< if false every allocation
+                                          *   locks the depot.
+                                         **/
+};
+
+namespace detail {
+/*!
+ * \brief A free slot of a pool, the next pointer is stored in the memory
+ *        of the slot itself. Not to be used directly.
+**/
+struct pool_slot {
+    pool_slot* next;
+};
+
+/*!
+ * \brief A chain of free slots. Not to be used directly.
+**/
+struct pool_batch {
+    pool_slot*  head;
+    std::size_t count;
+};
+
+/*!
+ * \brief The global free list of a pool, owns the slabs.
+ *        Owned by the pool alone, the thread caches only observe it, so
+ *        that the slabs are freed as soon as the pool is destroyed.
+ *        Not to be used directly.
+**/
+class pool_depot {
+public:
+    using this_type = pool_depot;
+
+    pool_depot(
+        std::size_t                slot_size,
+        const object_pool_options& options)
+        : m_slot_size{slot_size},
+          m_objects_per_slab{options.objects_per_slab},
+          m_batch_size{options.batch_size},
+          m_mutex{},
+          m_batches{},
+          m_loose{nullptr},
+          m_slabs{}
+    {
+    }
+
+    pool_depot(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    ~pool_depot()
+    {
+        for (void* slab : m_slabs) {
+            ::operator delete(slab);
+        }
+    }
+
+    PL_NODISCARD std::size_t batch_size() const noexcept
+    {
+        return m_batch_size;
+    }
+
+    PL_NODISCARD std::size_t slab_count() const
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return m_slabs.size();
+    }
+
+    /*!
+     * \brief Takes a batch of free slots, allocating a new slab if there
+     *        are none.
+    **/
+    PL_NODISCARD pool_batch take_batch()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        return take_batch_locked();
+    }
+
+    /*!
+     * \brief Returns a batch of free slots.
+    **/
+    void give_batch(pool_batch batch)
+    {
+        if (batch.count == 0U) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{m_mutex};
+        m_batches.push_back(batch);
+    }
+
+    /*!
+     * \brief Allocates a single slot, used without thread caches.
+    **/
+    PL_NODISCARD void* allocate_slot()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+
+        if (m_loose == nullptr) {
+            m_loose = take_batch_locked().head;
+        }
+
+        pool_slot* const slot{m_loose};
+        m_loose             = slot->next;
+        return slot;
+    }
+
+    /*!
+     * \brief Frees a single slot, used without thread caches.
+    **/
+    void deallocate_slot(void* pointer) noexcept
+    {
+        pool_slot* const            slot{static_cast<pool_slot*>(pointer)};
+        std::lock_guard<std::mutex> lock{m_mutex};
+        slot->next = m_loose;
+        m_loose    = slot;
+    }
+
+private:
+    pool_batch take_batch_locked()
+    {
+        if (m_batches.empty()) {
+            add_slab();
+        }
+
+        const pool_batch batch{m_batches.back()};
+        m_batches.pop_back();
+        return batch;
+    }
+
+    /*!
+     * \brief Allocates a slab and carves it into batches.
+    **/
+    void add_slab()
+    {
+        m_slabs.reserve(m_slabs.size() + 1U);
+        char* const slab{static_cast<char*>(
+            ::operator new(m_slot_size * m_objects_per_slab))};
+        m_slabs.push_back(slab);
+
+        for (std::size_t first{0U}; first < m_objects_per_slab;
+             first += m_batch_size) {
+            const std::size_t count{
+                (m_objects_per_slab - first) < m_batch_size
+                    ? (m_objects_per_slab - first)
+                    : m_batch_size};
+            pool_slot* head{nullptr};
+
+            for (std::size_t i{first + count}; i > first; --i) {
+                pool_slot* const slot{
+                    reinterpret_cast<pool_slot*>(slab + ((i - 1U) * m_slot_size))};
+                slot->next = head;
+                head       = slot;
+            }
+
+            m_batches.push_back(pool_batch{head, count});
+        }
+    }
+
+    const std::size_t       m_slot_size;
+    const std::size_t       m_objects_per_slab;
+    const std::size_t       m_batch_size;
+    mutable std::mutex      m_mutex;
+    std::vector<pool_batch> m_batches; //!< the free slots
+    pool_slot*              m_loose;   //!< free slots without thread caches
+    std::vector<void*>      m_slabs;
+};
+
+/*!
+ * \brief The free slots of one pool cached by one thread.
+ *        Not to be used directly.
+**/
+class pool_thread_cache {
+public:
+    using this_type = pool_thread_cache;
+
+    explicit pool_thread_cache(
+        PL_IN const std::shared_ptr<pool_depot>& depot) noexcept
+        : m_depot{depot.get()},
+          m_owner{depot},
+          m_batch_size{depot->batch_size()},
+          m_head{nullptr},
+          m_count{0U}
+    {
+    }
+
+    pool_thread_cache(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Returns the cached slots to the depot, unless the pool was
+     *        destroyed, which freed them along with its slabs.
+    **/
+    ~pool_thread_cache()
+    {
+        const std::shared_ptr<pool_depot> depot{m_owner.lock()};
+
+        if (depot != nullptr) {
+            depot->give_batch(pool_batch{m_head, m_count});
+        }
+    }
+
+    /*!
+     * \brief Returns whether the pool of this cache has been destroyed.
+    **/
+    PL_NODISCARD bool is_expired() const noexcept { return m_owner.expired(); }
+
+    /*!
+     * \brief Returns whether this is the cache of depot. A destroyed depot
+     *        never matches, even if a new one took its address.
+    **/
+    PL_NODISCARD bool is_for(const pool_depot* depot) const noexcept
+    {
+        return (m_depot == depot) and (not is_expired());
+    }
+
+    PL_NODISCARD void* allocate()
+    {
+        if (m_head == nullptr) {
+            const pool_batch batch{m_depot->take_batch()};
+            m_head  = batch.head;
+            m_count = batch.count;
+        }
+
+        pool_slot* const slot{m_head};
+        m_head = slot->next;
+        --m_count;
+        return slot;
+    }
+
+    /*!
+     * \brief Caches the slot. Once twice the batch size is cached, a batch
+     *        is returned to the depot, so that slots freed by a different
+     *        thread than the one that allocated them flow back.
+    **/
+    void deallocate(void* pointer)
+    {
+        pool_slot* const slot{static_cast<pool_slot*>(pointer)};
+        slot->next = m_head;
+        m_head     = slot;
+        ++m_count;
+
+        if (m_count >= (2U * m_batch_size)) {
+            pool_slot* last{m_head};
+
+            for (std::size_t i{1U}; i < m_batch_size; ++i) {
+                last = last->next;
+            }
+
+            const pool_batch batch{m_head, m_batch_size};
+            m_head     = last->next;
+            last->next = nullptr;
+            m_count -= m_batch_size;
+            m_depot->give_batch(batch);
+        }
+    }
+
+private:
+    pool_depot* const         m_depot; //!< only used while the pool is alive
+    std::weak_ptr<pool_depot> m_owner;
+    const std::size_t         m_batch_size;
+    pool_slot*                m_head;
+    std::size_t               m_count;
+};
+
+/*!
+ * \brief Returns the thread cache of the calling thread for depot.
+ *        Not to be used directly.
+**/
+inline pool_thread_cache& thread_cache_for(
+    PL_IN const std::shared_ptr<pool_depot>& depot)
+{
+    thread_local std::vector<std::unique_ptr<pool_thread_cache>> caches{};
+    thread_local pool_thread_cache* last{nullptr};
+
+    if ((last != nullptr) and last->is_for(depot.get())) {
+        return *last;
+    }
+
+    for (const std::unique_ptr<pool_thread_cache>& cache : caches) {
+        if (cache->is_for(depot.get())) {
+            last = cache.get();
+            return *last;
+        }
+    }
+
+    // drop the caches of destroyed pools.
+    std::vector<std::unique_ptr<pool_thread_cache>>::iterator it{
+        caches.begin()};
+
+    while (it != caches.end()) {
+        if ((*it)->is_expired()) {
+            it = caches.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    last = nullptr;
+
+    caches.push_back(std::unique_ptr<pool_thread_cache>{
+        new pool_thread_cache{depot}});
+    last = caches.back().get();
+    return *last;
+}
+
+/*!
+ * \brief A thread safe pool of slots of a fixed size.
+ *        Not to be used directly.
+**/
+class fixed_size_pool {
+public:
+    using this_type = fixed_size_pool;
+
+    static std::size_t slot_size_for(std::size_t size) noexcept
+    {
+        static constexpr std::size_t alignment{alignof(std::max_align_t)};
+        const std::size_t            slot_size{
+            size < sizeof(pool_slot) ? sizeof(pool_slot) : size};
+        return ((slot_size + alignment - 1U) / alignment) * alignment;
+    }
+
+    fixed_size_pool(std::size_t size, const object_pool_options& options)
+        : m_slot_size{slot_size_for(size)},
+          m_thread_caches{options.thread_caches},
+          // not std::make_shared, the weak_ptrs of the thread caches
+          // would keep the memory of the depot alive.
+          m_depot{new pool_depot{m_slot_size, options}}
+    {
+        PL_DBG_CHECK_PRE(
+            (options.objects_per_slab != 0U) and (options.batch_size != 0U));
+    }
+
+    fixed_size_pool(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    PL_NODISCARD std::size_t slot_size() const noexcept
+    {
+        return m_slot_size;
+    }
+
+    PL_NODISCARD std::size_t slab_count() const
+    {
+        return m_depot->slab_count();
+    }
+
+    PL_NODISCARD void* allocate()
+    {
+        if (m_thread_caches) {
+            return thread_cache_for(m_depot).allocate();
+        }
+
+        return m_depot->allocate_slot();
+    }
+
+    void deallocate(void* pointer)
+    {
+        if (m_thread_caches) {
+            thread_cache_for(m_depot).deallocate(pointer);
+        }
+        else {
+            m_depot->deallocate_slot(pointer);
+        }
+    }
+
+private:
+    const std::size_t           m_slot_size;
+    const bool                  m_thread_caches;
+    std::shared_ptr<pool_depot> m_depot;
+};
+
+/*!
+ * \brief The fixed_size_pools shared by copies of an object_pool_allocator,
+ *        one per slot size. The pools are created on first use and
+ *        published through a table of atomic pointers, so that finding the
+ *        pool for a size does not need to lock. Not to be used directly.
+**/
+class pool_group {
+public:
+    using this_type = pool_group;
+
+    explicit pool_group(const object_pool_options& options) noexcept
+        : m_options{options}, m_pools{}
+    {
+    }
+
+    pool_group(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    ~pool_group()
+    {
+        for (std::atomic<fixed_size_pool*>& pool : m_pools) {
+            delete pool.load(std::memory_order_relaxed);
+        }
+    }
+
+    /*!
+     * \brief Returns whether objects of the given size are allocated from
+     *        a pool, larger ones use the heap.
+    **/
+    PL_NODISCARD static bool is_pooled(std::size_t size) noexcept
+    {
+        return size <= max_pooled_size;
+    }
+
+    /*!
+     * \brief Returns the pool for objects of the given size, creating it
+     *        if it does not exist yet.
+     * \warning is_pooled(size) must be true.
+    **/
+    PL_NODISCARD fixed_size_pool& pool_for(std::size_t size)
+    {
+        const std::size_t slot_size{fixed_size_pool::slot_size_for(size)};
+        std::atomic<fixed_size_pool*>& entry{
+            m_pools[(slot_size / alignof(std::max_align_t)) - 1U]};
+        fixed_size_pool* pool{entry.load(std::memory_order_acquire)};
+
+        if (pool != nullptr) {
+            return *pool;
+        }
+
+        std::unique_ptr<fixed_size_pool> created{
+            new fixed_size_pool{slot_size, m_options}};
+
+        // another thread may have won the race to create the pool.
+        if (entry.compare_exchange_strong(
+                pool,
+                created.get(),
+                std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            return *created.release();
+        }
+
+        return *pool;
+    }
+
+private:
+    static constexpr std::size_t max_pooled_size{1024U};
+
+    const object_pool_options     m_options;
+    std::atomic<fixed_size_pool*> m_pools
+        [max_pooled_size / alignof(std::max_align_t)];
+};
+} // namespace detail
+
+/*!
+ * \brief A thread safe allocator for objects of type Type.
+ *
+ * Memory is allocated from the heap in slabs of many objects. Free objects
+ * are kept in intrusive free lists, which store the link in the memory of
+ * the free object itself. By default every thread caches a few free
+ * objects, so that most allocations and deallocations do not need to
+ * synchronize at all. A thread cache exchanges batches of objects with the
+ * global depot when it runs empty or has accumulated twice the batch size,
+ * which rebalances objects freed by other threads than the ones that
+ * allocated them.
+ *
+ * Example:
+ * \code
+ * pl::object_pool<node> pool{};
+ * node* n{pool.create(1, 2)};
+ * pool.destroy(n);
+ * \endcode
+ * \warning All the objects must be deallocated before the pool is
+ *          destroyed.
+ * \note Memory is only returned to the heap once the pool is destroyed,
+ *       which frees all of it, even if other threads still cache some of
+ *       the free objects.
+**/
+template <typename Type>
+class object_pool {
+public:
+    using this_type  = object_pool;
+    using value_type = Type;
+
+    static_assert(
+        alignof(Type) <= alignof(std::max_align_t),
+        "Over-aligned types are not supported by object_pool.");
+
+    /*!
+     * \brief Creates an empty object_pool.
+     * \param options The configuration to use.
+     * \throws pl::precondition_violation_exception if objects_per_slab or
+     *         batch_size is 0 (debug mode only).
+    **/
+    explicit object_pool(
+        const object_pool_options& options = object_pool_options{})
+        : m_pool{sizeof(Type), options}
+    {
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    object_pool(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Allocates uninitialized memory for one object.
+     * \return Pointer to the memory.
+     * \throws std::bad_alloc if a new slab could not be allocated.
+    **/
+    PL_NODISCARD void* allocate() { return m_pool.allocate(); }
+
+    /*!
+     * \brief Frees memory returned by allocate.
+     * \param pointer The memory to free.
+    **/
+    void deallocate(void* pointer) { m_pool.deallocate(pointer); }
+
+    /*!
+     * \brief Allocates and constructs an object.
+     * \param args The arguments to forward to the constructor.
+     * \return Pointer to the object created.
+    **/
+    template <typename... Args>
+    PL_NODISCARD Type* create(Args&&... args)
+    {
+        void* const memory{allocate()};
+
+        try {
+            return ::new (memory) Type(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            deallocate(memory);
+            throw;
+        }
+    }
+
+    /*!
+     * \brief Destroys and frees an object returned by create.
+     * \param object The object to destroy, may be nullptr.
+    **/
+    void destroy(Type* object)
+    {
+        if (object != nullptr) {
+            object->~Type();
+            deallocate(object);
+        }
+    }
+
+    /*!
+     * \brief Returns the amount of slabs allocated from the heap.
+    **/
+    PL_NODISCARD std::size_t slab_count() const { return m_pool.slab_count(); }
+
+private:
+    detail::fixed_size_pool m_pool;
+};
+
+/*!
+ * \brief An STL compatible allocator that allocates single objects from
+ *        pools, one per object size, shared by all of its copies, including
+ *        rebound ones. Allocations of more than one object and of objects
+ *        larger than 1024 bytes use the heap.
+ *
+ * Suits node based containers such as std::list and std::map, as well as
+ * std::allocate_shared, which allocate one object at a time.
+ *
+ * Example:
+ * \code
+ * std::list<int, pl::object_pool_allocator<int>> list{};
+ * \endcode
+**/
+template <typename Type>
+class object_pool_allocator {
+public:
+    template <typename Other>
+    friend class object_pool_allocator;
+
+    using this_type       = object_pool_allocator;
+    using value_type      = Type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    template <typename Other>
+    struct rebind {
+        using other = object_pool_allocator<Other>;
+    };
+
+    /*!
+     * \brief Creates an object_pool_allocator with new pools.
+     * \param options The configuration of the pools.
+    **/
+    explicit object_pool_allocator(
+        const object_pool_options& options = object_pool_options{})
+        : m_group{std::make_shared<detail::pool_group>(options)}
+    {
+    }
+
+    /*!
+     * \brief Creates an object_pool_allocator sharing the pools of other.
+    **/
+    object_pool_allocator(PL_IN const this_type& other) noexcept = default;
+
+    /*!
+     * \brief Creates an object_pool_allocator sharing the pools of other.
+    **/
+    template <typename Other>
+    object_pool_allocator(
+        PL_IN const object_pool_allocator<Other>& other) noexcept
+        : m_group{other.m_group}
+    {
+    }
+
+    /*!
+     * \brief Makes this object_pool_allocator share the pools of other.
+    **/
+    this_type& operator=(PL_IN const this_type& other) noexcept = default;
+
+    /*!
+     * \brief Allocates memory for count objects of type Type.
+     * \param count The amount of objects.
+     * \return Pointer to the uninitialized memory.
+     * \throws std::bad_alloc if the memory could not be allocated.
+    **/
+    PL_NODISCARD Type* allocate(size_type count)
+    {
+        if (uses_pool(count)) {
+            return static_cast<Type*>(
+                m_group->pool_for(sizeof(Type)).allocate());
+        }
+
+        if (count > (std::numeric_limits<size_type>::max() / sizeof(Type))) {
+            throw std::bad_alloc{};
+        }
+
+        return static_cast<Type*>(::operator new(count * sizeof(Type)));
+    }
+
+    /*!
+     * \brief Frees memory returned by allocate.
+     * \param pointer The memory to free.
+     * \param count The count passed to allocate.
+    **/
+    void deallocate(Type* pointer, size_type count)
+    {
+        if (uses_pool(count)) {
+            m_group->pool_for(sizeof(Type)).deallocate(pointer);
+        }
+        else {
+            ::operator delete(pointer);
+        }
+    }
+
+    /*!
+     * \brief Two object_pool_allocators compare equal if they share their
+     *        pools.
+    **/
+    template <typename Other>
+    PL_NODISCARD bool operator==(
+        PL_IN const object_pool_allocator<Other>& other) const noexcept
+    {
+        return m_group == other.m_group;
+    }
+
+    /*!
+     * \brief Two object_pool_allocators compare equal if they share their
+     *        pools.
+    **/
+    template <typename Other>
+    PL_NODISCARD bool operator!=(
+        PL_IN const object_pool_allocator<Other>& other) const noexcept
+    {
+        return not(*this == other);
+    }
+
+private:
+    static bool uses_pool(size_type count) noexcept
+    {
+        return (count == 1U) and (alignof(Type) <= alignof(std::max_align_t))
+               and detail::pool_group::is_pooled(sizeof(Type));
+    }
+
+    std::shared_ptr<detail::pool_group> m_group;
+};
+} // namespace pl
+#endif // INCG_PL_OBJECT_POOL_HPP
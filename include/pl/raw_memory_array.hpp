@@ -26,21 +26,36 @@
 
 /*!
  * \file raw_memory_array.hpp
- * \brief Exports the raw_memory_array template type.
+ * \brief Exports the raw_memory_array template type and the default_init_t
+ *        type.
 **/
 #ifndef INCG_PL_RAW_MEMORY_ARRAY_HPP
 #define INCG_PL_RAW_MEMORY_ARRAY_HPP
 #include "algo/destroy.hpp" // pl::algo::destroy
 #include "annotations.hpp"  // PL_NODISCARD, PL_OUT, PL_IN
 #include "assert.hpp"       // PL_DBG_CHECK_PRE
-#include <algorithm> // std::fill, std::equal, std::lexicographical_compare
-#include <ciso646>   // not
-#include <cstddef>   // std::size_t, std::ptrdiff_t
-#include <iterator>  // std::reverse_iterator
-#include <memory>    // std::uninitialized_fill
-#include <stdexcept> // std::out_of_range
+#include <algorithm>        // std::fill, std::equal, std::lexicographical_compare
+#include <ciso646>          // not
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <iterator>         // std::reverse_iterator
+#include <memory>           // std::uninitialized_fill
+#include <new>              // new
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>      // std::is_trivially_destructible, std::is_trivially_default_constructible, std::true_type, std::false_type
 
 namespace pl {
+/*!
+ * \brief The default_init_t tag type, used to default initialize the
+ *        elements of raw_memory_array objects rather than copying a value
+ *        into them. Elements of trivial types are left uninitialized.
+**/
+struct default_init_t {
+    /*!
+     * \brief Default constructs a default_init_t object.
+    **/
+    explicit default_init_t() = default;
+};
+
 /*!
  * \brief Type that can be used to treat some raw memory as a fixed size array.
 **/
@@ -96,12 +111,41 @@ public:
         std::uninitialized_fill(begin(), end(), initial_value);
     }
 
+    /*!
+     * \brief Creates a raw_memory_array by default initializing the
+     *        elements in the raw memory passed in. No work is done for
+     *        trivially default constructible types, whose elements are left
+     *        uninitialized, for instance for buffers that are about to be
+     *        overwritten.
+     * \param raw_memory Pointer to the first (0th) byte of the raw memory
+     *                   that shall be treated as an array.
+     * \param byte_count The size of the raw memory pointed to by 'raw_memory'
+     *                   in bytes. May not be incorrect!
+     * \warning The same requirements on the raw memory apply as for the
+     *          other constructor.
+     *          Reading an uninitialized element is undefined behavior.
+    **/
+    raw_memory_array(
+        PL_OUT void* raw_memory,
+        size_type    byte_count,
+        default_init_t)
+        : m_data{static_cast<pointer>(raw_memory)}
+        , m_size{byte_count / sizeof(value_type)}
+    {
+        default_initialize(
+            std::is_trivially_default_constructible<value_type>{});
+    }
+
     /*!
      * \brief Destroys the raw_memory_array by calling the destructors
      *        of all the elements that were placement new'ed into the raw
-     *        memory.
+     *        memory. Does nothing for trivially destructible types.
     **/
-    ~raw_memory_array() { ::pl::algo::destroy(begin(), end()); }
+    ~raw_memory_array()
+    {
+        destroy_elements(std::is_trivially_destructible<value_type>{});
+    }
+
     /*!
      * \brief This type is non-copyable.
     **/
@@ -437,6 +481,28 @@ public:
     **/
     this_type& assign(PL_IN const_reference value) { return fill(value); }
 private:
+    void default_initialize(std::true_type) noexcept {}
+    void default_initialize(std::false_type)
+    {
+        size_type constructed{0U};
+
+        try {
+            for (; constructed < m_size; ++constructed) {
+                ::new (static_cast<void*>(m_data + constructed)) value_type;
+            }
+        }
+        catch (...) {
+            ::pl::algo::destroy(m_data, m_data + constructed);
+            throw;
+        }
+    }
+
+    void destroy_elements(std::true_type) noexcept {}
+    void destroy_elements(std::false_type) noexcept
+    {
+        ::pl::algo::destroy(begin(), end());
+    }
+
     pointer   m_data; /*!< Pointer to the raw memory interpreted as 'Ty'. */
     size_type m_size; /*!< The amount of elements that fit in the raw memory */
 };
@@ -0,0 +1,894 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file small_vector.hpp
+ * \brief Exports the small_vector template type, a vector that stores a
+ *        few elements inline.
+**/
+#ifndef INCG_PL_SMALL_VECTOR_HPP
+#define INCG_PL_SMALL_VECTOR_HPP
+#include "algo/destroy.hpp" // pl::algo::destroy
+#include "annotations.hpp"  // PL_NODISCARD, PL_IN, PL_INOUT
+#include "assert.hpp"       // PL_DBG_CHECK_PRE
+#include <algorithm>        // std::equal, std::lexicographical_compare, std::rotate, std::move
+#include <ciso646>          // not, and
+#include <cstddef>          // std::size_t, std::ptrdiff_t, std::max_align_t
+#include <cstring>          // std::memcpy
+#include <initializer_list> // std::initializer_list
+#include <iterator>         // std::reverse_iterator, std::iterator_traits
+#include <limits>           // std::numeric_limits
+#include <new>              // ::operator new, ::operator delete, std::bad_alloc
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>      // std::is_trivially_copyable, std::is_nothrow_move_constructible
+#include <utility>          // std::move, std::forward, std::move_if_noexcept
+
+namespace pl {
+/*!
+ * \brief Trait to determine whether objects of type Ty can be moved to a
+ *        different address by copying their bytes, after which the source
+ *        is not destroyed.
+ *
+ * True for trivially copyable types. May be specialized for types that
+ * do not refer to their own address, such as most smart pointers.
+**/
+template <typename Ty>
+struct is_trivially_relocatable
+    : public std::integral_constant<
+          bool,
+          std::is_trivially_copyable<Ty>::value> {
+};
+
+/*!
+ * \brief A sequence container, like std::vector, that stores up to
+ *        InlineCapacity elements in the object itself and only allocates
+ *        from the heap once it grows larger than that.
+ *
+ * Moving a small_vector that has spilled to the heap steals the heap
+ * buffer. Elements of types that are is_trivially_relocatable are moved
+ * around with std::memcpy when the small_vector grows or is moved.
+ * \warning Unlike std::vector, moving a small_vector invalidates the
+ *          iterators to the elements if they are stored inline.
+**/
+template <typename Ty, std::size_t InlineCapacity>
+class small_vector {
+public:
+    using this_type              = small_vector;
+    using value_type             = Ty;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = pointer;
+    using const_iterator         = const_pointer;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static_assert(
+        alignof(value_type) <= alignof(std::max_align_t),
+        "Over-aligned types are not supported by small_vector.");
+
+    /*!
+     * \brief The amount of elements that can be stored without allocating.
+    **/
+    static constexpr size_type inline_capacity = InlineCapacity;
+
+    /*!
+     * \brief Creates an empty small_vector.
+    **/
+    small_vector() noexcept
+        : m_data{m_inline.m_elements},
+          m_size{0U},
+          m_capacity{inline_capacity},
+          m_inline{}
+    {
+    }
+
+    /*!
+     * \brief Creates a small_vector of count value initialized elements.
+     * \param count The amount of elements.
+    **/
+    explicit small_vector(size_type count) : small_vector{}
+    {
+        resize(count);
+    }
+
+    /*!
+     * \brief Creates a small_vector of count copies of value.
+     * \param count The amount of elements.
+     * \param value The value to copy.
+    **/
+    small_vector(size_type count, PL_IN const_reference value) : small_vector{}
+    {
+        resize(count, value);
+    }
+
+    /*!
+     * \brief Creates a small_vector from the elements of the range
+     *        ['first', 'last').
+     * \param first The begin iterator of the range to copy.
+     * \param last The end iterator of the range to copy.
+    **/
+    template <
+        typename InputIterator,
+        typename = typename std::iterator_traits<
+            InputIterator>::iterator_category>
+    small_vector(InputIterator first, InputIterator last) : small_vector{}
+    {
+        append(first, last);
+    }
+
+    /*!
+     * \brief Creates a small_vector from the elements of list.
+     * \param list The elements to copy.
+    **/
+    small_vector(std::initializer_list<value_type> list) : small_vector{}
+    {
+        append(list.begin(), list.end());
+    }
+
+    /*!
+     * \brief Creates a copy of other.
+     * \param other The small_vector to copy.
+    **/
+    small_vector(PL_IN const this_type& other) : small_vector{}
+    {
+        append(other.begin(), other.end());
+    }
+
+    /*!
+     * \brief Creates a small_vector from the elements of other.
+     *        Steals the heap buffer of other, if it has one, otherwise
+     *        moves the elements one by one.
+     * \param other The small_vector to move from, will be empty afterwards.
+    **/
+    small_vector(PL_INOUT this_type&& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value)
+        : small_vector{}
+    {
+        take(other);
+    }
+
+    /*!
+     * \brief Destroys the elements and frees the heap buffer, if any.
+    **/
+    ~small_vector()
+    {
+        clear();
+        free_heap();
+    }
+
+    /*!
+     * \brief Replaces the elements with copies of the elements of other.
+     * \param other The small_vector to copy.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(PL_IN const this_type& other)
+    {
+        if (this != &other) {
+            clear();
+            append(other.begin(), other.end());
+        }
+
+        return *this;
+    }
+
+    /*!
+     * \brief Replaces the elements with the elements of other.
+     *        Steals the heap buffer of other, if it has one, otherwise
+     *        moves the elements one by one.
+     * \param other The small_vector to move from, will be empty afterwards.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(PL_INOUT this_type&& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value)
+    {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+
+        return *this;
+    }
+
+    /*!
+     * \brief Replaces the elements with copies of the elements of list.
+     * \param list The elements to copy.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(std::initializer_list<value_type> list)
+    {
+        clear();
+        append(list.begin(), list.end());
+        return *this;
+    }
+
+    /*!
+     * \brief Returns a reference to the element at 'pos', with bounds
+     *        checking.
+     * \param pos Position of the element to return.
+     * \return Reference to the requested element.
+     * \throws std::out_of_range if 'pos' is not less than size().
+    **/
+    PL_NODISCARD reference at(size_type pos)
+    {
+        if (not(pos < size())) {
+            throw std::out_of_range{
+                "pos in pl::small_vector::at was out of bounds!"};
+        }
+
+        return (*this)[pos];
+    }
+
+    /*!
+     * \brief Returns a reference to the element at 'pos', with bounds
+     *        checking.
+     * \param pos Position of the element to return.
+     * \return Reference to the requested element.
+     * \throws std::out_of_range if 'pos' is not less than size().
+    **/
+    PL_NODISCARD const_reference at(size_type pos) const
+    {
+        return const_cast<this_type*>(this)->at(pos);
+    }
+
+    /*!
+     * \brief Returns a reference to the element at 'pos'.
+     *        No bounds checking is performed!
+     * \param pos Position of the element to return.
+     * \return Reference to the requested element.
+    **/
+    PL_NODISCARD reference operator[](size_type pos) noexcept
+    {
+        return m_data[pos];
+    }
+
+    /*!
+     * \brief Returns a reference to the element at 'pos'.
+     *        No bounds checking is performed!
+     * \param pos Position of the element to return.
+     * \return Reference to the requested element.
+    **/
+    PL_NODISCARD const_reference operator[](size_type pos) const noexcept
+    {
+        return m_data[pos];
+    }
+
+    /*!
+     * \brief Returns a reference to the first element.
+     * \warning Calling front on an empty small_vector is undefined.
+    **/
+    PL_NODISCARD reference front()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        return *begin();
+    }
+
+    /*!
+     * \brief Returns a reference to the first element.
+     * \warning Calling front on an empty small_vector is undefined.
+    **/
+    PL_NODISCARD const_reference front() const
+    {
+        return const_cast<this_type*>(this)->front();
+    }
+
+    /*!
+     * \brief Returns a reference to the last element.
+     * \warning Calling back on an empty small_vector is undefined.
+    **/
+    PL_NODISCARD reference back()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        return *(end() - 1);
+    }
+
+    /*!
+     * \brief Returns a reference to the last element.
+     * \warning Calling back on an empty small_vector is undefined.
+    **/
+    PL_NODISCARD const_reference back() const
+    {
+        return const_cast<this_type*>(this)->back();
+    }
+
+    /*!
+     * \brief Returns a pointer to the underlying element storage.
+    **/
+    PL_NODISCARD pointer data() noexcept { return m_data; }
+    /*!
+     * \brief Returns a pointer to the underlying element storage.
+    **/
+    PL_NODISCARD const_pointer data() const noexcept { return m_data; }
+    /*!
+     * \brief Returns an iterator to the first element.
+    **/
+    PL_NODISCARD iterator begin() noexcept { return m_data; }
+    /*!
+     * \brief Returns an iterator to the first element.
+    **/
+    PL_NODISCARD const_iterator begin() const noexcept { return m_data; }
+    /*!
+     * \brief Returns an iterator to the first element.
+    **/
+    PL_NODISCARD const_iterator cbegin() const noexcept { return begin(); }
+    /*!
+     * \brief Returns an iterator to the element following the last element.
+    **/
+    PL_NODISCARD iterator end() noexcept { return m_data + m_size; }
+    /*!
+     * \brief Returns an iterator to the element following the last element.
+    **/
+    PL_NODISCARD const_iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+    /*!
+     * \brief Returns an iterator to the element following the last element.
+    **/
+    PL_NODISCARD const_iterator cend() const noexcept { return end(); }
+    /*!
+     * \brief Returns a reverse iterator to the last element.
+    **/
+    PL_NODISCARD reverse_iterator rbegin() noexcept
+    {
+        return reverse_iterator{end()};
+    }
+
+    /*!
+     * \brief Returns a reverse iterator to the last element.
+    **/
+    PL_NODISCARD const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator{end()};
+    }
+
+    /*!
+     * \brief Returns a reverse iterator to the last element.
+    **/
+    PL_NODISCARD const_reverse_iterator crbegin() const noexcept
+    {
+        return rbegin();
+    }
+
+    /*!
+     * \brief Returns a reverse iterator to the element preceding the first
+     *        element.
+    **/
+    PL_NODISCARD reverse_iterator rend() noexcept
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /*!
+     * \brief Returns a reverse iterator to the element preceding the first
+     *        element.
+    **/
+    PL_NODISCARD const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator{begin()};
+    }
+
+    /*!
+     * \brief Returns a reverse iterator to the element preceding the first
+     *        element.
+    **/
+    PL_NODISCARD const_reverse_iterator crend() const noexcept
+    {
+        return rend();
+    }
+
+    /*!
+     * \brief Checks if the small_vector has no elements.
+    **/
+    PL_NODISCARD bool empty() const noexcept { return m_size == 0U; }
+    /*!
+     * \brief Returns the number of elements.
+    **/
+    PL_NODISCARD size_type size() const noexcept { return m_size; }
+    /*!
+     * \brief Returns the maximum number of elements.
+    **/
+    PL_NODISCARD size_type max_size() const noexcept
+    {
+        return std::numeric_limits<size_type>::max() / sizeof(value_type);
+    }
+
+    /*!
+     * \brief Returns the number of elements that can be held without
+     *        allocating.
+    **/
+    PL_NODISCARD size_type capacity() const noexcept { return m_capacity; }
+    /*!
+     * \brief Checks whether the elements are stored inline, rather than in
+     *        a heap buffer.
+    **/
+    PL_NODISCARD bool is_inline() const noexcept
+    {
+        return m_data == inline_data();
+    }
+
+    /*!
+     * \brief Makes sure that at least new_capacity elements can be held
+     *        without allocating.
+     * \param new_capacity The capacity to reserve.
+     * \throws std::bad_alloc if the memory could not be allocated.
+    **/
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity > m_capacity) {
+            reallocate(new_capacity);
+        }
+    }
+
+    /*!
+     * \brief Moves the elements back inline if they fit, or into a heap
+     *        buffer of exactly size() elements otherwise.
+    **/
+    void shrink_to_fit()
+    {
+        if (is_inline() or (m_size == m_capacity)) {
+            return;
+        }
+
+        if (m_size <= inline_capacity) {
+            pointer const old_data{m_data};
+            relocate(old_data, m_size, inline_data());
+            ::operator delete(old_data);
+            m_data     = inline_data();
+            m_capacity = inline_capacity;
+        }
+        else {
+            reallocate(m_size);
+        }
+    }
+
+    /*!
+     * \brief Destroys all the elements. Keeps the capacity.
+    **/
+    void clear() noexcept
+    {
+        ::pl::algo::destroy(begin(), end());
+        m_size = 0U;
+    }
+
+    /*!
+     * \brief Appends a copy of value.
+     * \param value The value to append, may refer to an element.
+    **/
+    void push_back(PL_IN const_reference value) { emplace_back(value); }
+    /*!
+     * \brief Appends value by moving it.
+     * \param value The value to append, may refer to an element.
+    **/
+    void push_back(PL_INOUT value_type&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    /*!
+     * \brief Constructs an element at the end in place.
+     * \param args The arguments to forward to the constructor, may refer to
+     *             elements.
+     * \return A reference to the element created.
+    **/
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (m_size == m_capacity) {
+            return emplace_back_grow(std::forward<Args>(args)...);
+        }
+
+        ::new (static_cast<void*>(m_data + m_size))
+            value_type(std::forward<Args>(args)...);
+        ++m_size;
+        return back();
+    }
+
+    /*!
+     * \brief Destroys the last element.
+     * \warning Calling pop_back on an empty small_vector is undefined.
+    **/
+    void pop_back()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        --m_size;
+        m_data[m_size].~value_type();
+    }
+
+    /*!
+     * \brief Inserts value before pos.
+     * \param pos The position to insert before.
+     * \param value The value to insert.
+     * \return Iterator to the element inserted.
+    **/
+    iterator insert(const_iterator pos, PL_IN const_reference value)
+    {
+        return emplace(pos, value);
+    }
+
+    /*!
+     * \brief Inserts value before pos by moving it.
+     * \param pos The position to insert before.
+     * \param value The value to insert.
+     * \return Iterator to the element inserted.
+    **/
+    iterator insert(const_iterator pos, PL_INOUT value_type&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    /*!
+     * \brief Constructs an element before pos.
+     * \param pos The position to insert before.
+     * \param args The arguments to forward to the constructor.
+     * \return Iterator to the element inserted.
+    **/
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const difference_type index{pos - cbegin()};
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    /*!
+     * \brief Removes the element at pos.
+     * \param pos The element to remove.
+     * \return Iterator following the element removed.
+    **/
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    /*!
+     * \brief Removes the elements in the range ['first', 'last').
+     * \param first The begin iterator of the elements to remove.
+     * \param last The end iterator of the elements to remove.
+     * \return Iterator following the last element removed.
+    **/
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const iterator target{begin() + (first - cbegin())};
+
+        if (first != last) {
+            const iterator new_end{
+                std::move(begin() + (last - cbegin()), end(), target)};
+            ::pl::algo::destroy(new_end, end());
+            m_size = static_cast<size_type>(new_end - begin());
+        }
+
+        return target;
+    }
+
+    /*!
+     * \brief Resizes to count elements, appending value initialized
+     *        elements if needed.
+     * \param count The new size.
+    **/
+    void resize(size_type count)
+    {
+        shrink_or_reserve(count);
+
+        while (m_size < count) {
+            ::new (static_cast<void*>(m_data + m_size)) value_type();
+            ++m_size;
+        }
+    }
+
+    /*!
+     * \brief Resizes to count elements, appending copies of value if
+     *        needed.
+     * \param count The new size.
+     * \param value The value to copy.
+    **/
+    void resize(size_type count, PL_IN const_reference value)
+    {
+        if (count > m_capacity) {
+            // value may refer to an element.
+            const value_type copy(value);
+            reserve(count);
+            append_copies(count, copy);
+        }
+        else {
+            shrink_or_reserve(count);
+            append_copies(count, value);
+        }
+    }
+
+    /*!
+     * \brief Exchanges the elements of this small_vector with the ones of
+     *        other.
+     * \param other The other small_vector.
+    **/
+    void swap(PL_INOUT this_type& other)
+    {
+        this_type temporary{std::move(other)};
+        other = std::move(*this);
+        *this = std::move(temporary);
+    }
+
+private:
+    PL_NODISCARD pointer inline_data() noexcept { return m_inline.m_elements; }
+    PL_NODISCARD const_pointer inline_data() const noexcept
+    {
+        return m_inline.m_elements;
+    }
+
+    PL_NODISCARD static pointer allocate(size_type count)
+    {
+        if (count > (std::numeric_limits<size_type>::max()
+                     / sizeof(value_type))) {
+            throw std::bad_alloc{};
+        }
+
+        return static_cast<pointer>(::operator new(count * sizeof(value_type)));
+    }
+
+    void free_heap() noexcept
+    {
+        if (not is_inline()) {
+            ::operator delete(m_data);
+        }
+    }
+
+    /*!
+     * \brief Moves count elements from source to the uninitialized memory
+     *        at destination, destroying the elements at source.
+    **/
+    static void relocate(pointer source, size_type count, pointer destination)
+    {
+        if (is_trivially_relocatable<value_type>::value) {
+            if (count != 0U) {
+                std::memcpy(
+                    static_cast<void*>(destination),
+                    static_cast<const void*>(source),
+                    count * sizeof(value_type));
+            }
+
+            return;
+        }
+
+        size_type constructed{0U};
+
+        try {
+            for (; constructed < count; ++constructed) {
+                ::new (static_cast<void*>(destination + constructed))
+                    value_type(std::move_if_noexcept(source[constructed]));
+            }
+        }
+        catch (...) {
+            ::pl::algo::destroy(destination, destination + constructed);
+            throw;
+        }
+
+        ::pl::algo::destroy(source, source + count);
+    }
+
+    PL_NODISCARD size_type grown_capacity(size_type minimum) const noexcept
+    {
+        const size_type doubled{m_capacity * 2U};
+        return doubled < minimum ? minimum : doubled;
+    }
+
+    void reallocate(size_type new_capacity)
+    {
+        const pointer new_data{allocate(new_capacity)};
+
+        try {
+            relocate(m_data, m_size, new_data);
+        }
+        catch (...) {
+            ::operator delete(new_data);
+            throw;
+        }
+
+        free_heap();
+        m_data     = new_data;
+        m_capacity = new_capacity;
+    }
+
+    /*!
+     * \brief Constructs the new element before relocating the existing
+     *        ones, as the arguments may refer to them.
+    **/
+    template <typename... Args>
+    reference emplace_back_grow(Args&&... args)
+    {
+        const size_type new_capacity{grown_capacity(m_size + 1U)};
+        const pointer   new_data{allocate(new_capacity)};
+
+        try {
+            ::new (static_cast<void*>(new_data + m_size))
+                value_type(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            ::operator delete(new_data);
+            throw;
+        }
+
+        try {
+            relocate(m_data, m_size, new_data);
+        }
+        catch (...) {
+            new_data[m_size].~value_type();
+            ::operator delete(new_data);
+            throw;
+        }
+
+        free_heap();
+        m_data     = new_data;
+        m_capacity = new_capacity;
+        ++m_size;
+        return back();
+    }
+
+    /*!
+     * \brief Takes the elements of other, which must be different from
+     *        this small_vector. This small_vector must be empty.
+    **/
+    void take(PL_INOUT this_type& other)
+    {
+        if (not other.is_inline()) {
+            free_heap();
+            m_data           = other.m_data;
+            m_capacity       = other.m_capacity;
+            m_size           = other.m_size;
+            other.m_data     = other.inline_data();
+            other.m_capacity = inline_capacity;
+            other.m_size     = 0U;
+            return;
+        }
+
+        // other's elements fit inline, so they also fit into our buffer.
+        if (is_trivially_relocatable<value_type>::value) {
+            relocate(other.m_data, other.m_size, m_data);
+            m_size       = other.m_size;
+            other.m_size = 0U;
+            return;
+        }
+
+        for (reference element : other) {
+            ::new (static_cast<void*>(m_data + m_size))
+                value_type(std::move(element));
+            ++m_size;
+        }
+
+        other.clear();
+    }
+
+    template <typename InputIterator>
+    void append(InputIterator first, InputIterator last)
+    {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void append_copies(size_type count, PL_IN const_reference value)
+    {
+        while (m_size < count) {
+            ::new (static_cast<void*>(m_data + m_size)) value_type(value);
+            ++m_size;
+        }
+    }
+
+    void shrink_or_reserve(size_type count)
+    {
+        if (count < m_size) {
+            ::pl::algo::destroy(begin() + count, end());
+            m_size = count;
+        }
+        else {
+            reserve(count);
+        }
+    }
+
+    /*!
+     * \brief Uninitialized storage for the inline elements.
+    **/
+    union inline_storage {
+        inline_storage() noexcept : m_unused{} {}
+
+        inline_storage(const inline_storage&) = delete;
+
+        inline_storage& operator=(const inline_storage&) = delete;
+
+        ~inline_storage() {}
+
+        char       m_unused;
+        value_type m_elements[inline_capacity == 0U ? 1U : inline_capacity];
+    };
+
+    pointer        m_data;     //!< either m_inline or a heap buffer.
+    size_type      m_size;     //!< the amount of elements.
+    size_type      m_capacity; //!< the amount of elements that fit into m_data.
+    inline_storage m_inline;   //!< the inline storage.
+};
+
+template <typename Ty, std::size_t InlineCapacity>
+constexpr typename small_vector<Ty, InlineCapacity>::size_type
+    small_vector<Ty, InlineCapacity>::inline_capacity;
+
+/*!
+ * \brief Checks if 'lhs' and 'rhs' have the same elements.
+ * \param lhs The object to compare with 'rhs'.
+ * \param rhs The object to compare with 'lhs'.
+ * \return true if the elements are equal, false otherwise.
+**/
+template <typename Ty, std::size_t InlineCapacity>
+bool operator==(
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& lhs,
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& rhs)
+{
+    return (lhs.size() == rhs.size())
+           and std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+/*!
+ * \brief Checks if 'lhs' and 'rhs' do not have the same elements.
+ * \param lhs The object to compare with 'rhs'.
+ * \param rhs The object to compare with 'lhs'.
+ * \return true if the elements are not equal, false otherwise.
+**/
+template <typename Ty, std::size_t InlineCapacity>
+bool operator!=(
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& lhs,
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& rhs)
+{
+    return not(lhs == rhs);
+}
+
+/*!
+ * \brief Compares the elements of 'lhs' and 'rhs' lexicographically.
+ * \param lhs The first operand.
+ * \param rhs The second operand.
+ * \return true if 'lhs' is lexicographically less than 'rhs'.
+**/
+template <typename Ty, std::size_t InlineCapacity>
+bool operator<(
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& lhs,
+    PL_IN const ::pl::small_vector<Ty, InlineCapacity>& rhs)
+{
+    return std::lexicographical_compare(
+        lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+/*!
+ * \brief Exchanges the elements of 'lhs' and 'rhs'.
+ * \param lhs The first operand.
+ * \param rhs The second operand.
+**/
+template <typename Ty, std::size_t InlineCapacity>
+void swap(
+    PL_INOUT ::pl::small_vector<Ty, InlineCapacity>& lhs,
+    PL_INOUT ::pl::small_vector<Ty, InlineCapacity>& rhs)
+{
+    lhs.swap(rhs);
+}
+} // namespace pl
+#endif // INCG_PL_SMALL_VECTOR_HPP
@@ -0,0 +1,739 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file soa_vector.hpp
+ * \brief Exports the soa_vector template type, a vector of records that
+ *        stores each field in its own array, and the column_span template
+ *        type.
+**/
+#ifndef INCG_PL_SOA_VECTOR_HPP
+#define INCG_PL_SOA_VECTOR_HPP
+#include "algo/destroy.hpp"    // pl::algo::destroy
+#include "algo/destroy_at.hpp" // pl::algo::destroy_at
+#include "aligned_buffer.hpp"  // pl::aligned_buffer, pl::cache_line_size
+#include "annotations.hpp"     // PL_NODISCARD, PL_IN, PL_INOUT
+#include "assert.hpp"          // PL_DBG_CHECK_PRE
+#include <algorithm>           // std::move
+#include <array>               // std::array
+#include <ciso646>             // not
+#include <cstddef>             // std::size_t, std::ptrdiff_t
+#include <initializer_list>    // std::initializer_list
+#include <iterator>            // std::input_iterator_tag
+#include <limits>              // std::numeric_limits
+#include <new>                 // new, std::bad_alloc
+#include <stdexcept>           // std::out_of_range
+#include <tuple>               // std::tuple, std::tuple_element, std::get
+#include <type_traits>         // std::remove_const, std::conditional
+#include <utility>             // std::index_sequence, std::forward, std::move, std::move_if_noexcept
+
+namespace pl {
+/*!
+ * \brief A non-owning view of a contiguous array, such as a column of a
+ *        soa_vector. Usable with the algorithms from ranged_algorithms.hpp.
+**/
+template <typename Ty>
+class column_span {
+public:
+    using this_type       = column_span;
+    using value_type      = typename std::remove_const<Ty>::type;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = Ty&;
+    using pointer         = Ty*;
+    using iterator        = Ty*;
+
+    /*!
+     * \brief Creates a column_span of the size elements at data.
+    **/
+    constexpr column_span(pointer data, size_type size) noexcept
+        : m_data{data}, m_size{size}
+    {
+    }
+
+    /*!
+     * \brief Returns a reference to the element at 'pos'.
+     *        No bounds checking is performed!
+    **/
+    PL_NODISCARD constexpr reference operator[](size_type pos) const noexcept
+    {
+        return m_data[pos];
+    }
+
+    /*!
+     * \brief Returns a pointer to the first element.
+    **/
+    PL_NODISCARD constexpr pointer data() const noexcept { return m_data; }
+    /*!
+     * \brief Returns the number of elements.
+    **/
+    PL_NODISCARD constexpr size_type size() const noexcept { return m_size; }
+    /*!
+     * \brief Checks if the column_span has no elements.
+    **/
+    PL_NODISCARD constexpr bool empty() const noexcept { return m_size == 0U; }
+    /*!
+     * \brief Returns an iterator to the first element.
+    **/
+    PL_NODISCARD constexpr iterator begin() const noexcept { return m_data; }
+    /*!
+     * \brief Returns an iterator to the element following the last element.
+    **/
+    PL_NODISCARD constexpr iterator end() const noexcept
+    {
+        return m_data + m_size;
+    }
+
+private:
+    pointer   m_data;
+    size_type m_size;
+};
+
+/*!
+ * \brief A sequence container of records with the fields Fields that
+ *        stores each field in its own contiguous, cache line aligned array
+ *        (structure of arrays).
+ *
+ * Loops that only access a few of the fields of every record only load
+ * those fields into the cache, rather than the whole records, and can
+ * process the columns with SIMD instructions.
+ * Rows are accessed through proxy references, which are std::tuples of
+ * references to the fields. Columns are accessed through column_spans.
+ *
+ * Example:
+ * \code
+ * pl::soa_vector<int, double> particles{};
+ * particles.push_back(1, 2.0);
+ * std::get<1>(particles[0]) += 1.0;
+ * pl::algo::fill(particles.column<1>(), 0.0);
+ * \endcode
+ * \note If a field is not nothrow move constructible and copying it
+ *       throws while growing, the elements of the other fields may have
+ *       been moved from.
+**/
+template <typename... Fields>
+class soa_vector {
+public:
+    static_assert(sizeof...(Fields) != 0U, "soa_vector needs fields.");
+
+    using this_type       = soa_vector;
+    using value_type      = std::tuple<Fields...>;
+    using reference       = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /*!
+     * \brief The type of the field at index Index.
+    **/
+    template <std::size_t Index>
+    using field_type = typename std::tuple_element<Index, value_type>::type;
+
+    /*!
+     * \brief The amount of fields.
+    **/
+    static constexpr std::size_t field_count = sizeof...(Fields);
+
+    /*!
+     * \brief Iterator over the rows, dereferences to proxy references.
+    **/
+    template <bool IsConst>
+    class row_iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = typename soa_vector::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename std::
+            conditional<IsConst, const_reference, soa_vector::reference>::type;
+        using pointer   = void;
+        using container = typename std::
+            conditional<IsConst, const soa_vector, soa_vector>::type;
+
+        row_iterator(container* vector, size_type row) noexcept
+            : m_vector{vector}, m_row{row}
+        {
+        }
+
+        PL_NODISCARD reference operator*() const { return (*m_vector)[m_row]; }
+        row_iterator&          operator++() noexcept
+        {
+            ++m_row;
+            return *this;
+        }
+
+        row_iterator operator++(int) noexcept
+        {
+            row_iterator copy{*this};
+            ++m_row;
+            return copy;
+        }
+
+        PL_NODISCARD friend bool operator==(
+            PL_IN const row_iterator& lhs,
+            PL_IN const row_iterator& rhs) noexcept
+        {
+            return lhs.m_row == rhs.m_row;
+        }
+
+        PL_NODISCARD friend bool operator!=(
+            PL_IN const row_iterator& lhs,
+            PL_IN const row_iterator& rhs) noexcept
+        {
+            return lhs.m_row != rhs.m_row;
+        }
+
+    private:
+        container* m_vector;
+        size_type  m_row;
+    };
+
+    using iterator       = row_iterator<false>;
+    using const_iterator = row_iterator<true>;
+
+    /*!
+     * \brief Creates an empty soa_vector.
+    **/
+    soa_vector() noexcept : m_columns{}, m_size{0U}, m_capacity{0U} {}
+    /*!
+     * \brief Creates a soa_vector of count value initialized records.
+     * \param count The amount of records.
+    **/
+    explicit soa_vector(size_type count) : soa_vector{} { resize(count); }
+    /*!
+     * \brief Creates a soa_vector from the records of list.
+     * \param list The records to copy.
+    **/
+    soa_vector(std::initializer_list<value_type> list) : soa_vector{}
+    {
+        reserve(list.size());
+
+        for (const value_type& record : list) {
+            push_back_tuple(record, std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    /*!
+     * \brief Creates a copy of other.
+     * \param other The soa_vector to copy.
+    **/
+    soa_vector(PL_IN const this_type& other) : soa_vector{}
+    {
+        reserve(other.size());
+
+        for (size_type row{0U}; row < other.size(); ++row) {
+            push_back_tuple(other[row], std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    /*!
+     * \brief Takes the records of other, leaving it empty.
+     * \param other The soa_vector to move from.
+    **/
+    soa_vector(PL_INOUT this_type&& other) noexcept
+        : m_columns{std::move(other.m_columns)},
+          m_size{other.m_size},
+          m_capacity{other.m_capacity}
+    {
+        other.m_size     = 0U;
+        other.m_capacity = 0U;
+    }
+
+    /*!
+     * \brief Replaces the records with copies of the records of other.
+     * \param other The soa_vector to copy.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(PL_IN const this_type& other)
+    {
+        if (this != &other) {
+            this_type copy{other};
+            swap(copy);
+        }
+
+        return *this;
+    }
+
+    /*!
+     * \brief Replaces the records with the records of other, leaving it
+     *        empty.
+     * \param other The soa_vector to move from.
+     * \return A reference to this object.
+    **/
+    this_type& operator=(PL_INOUT this_type&& other) noexcept
+    {
+        this_type temporary{std::move(other)};
+        swap(temporary);
+        return *this;
+    }
+
+    /*!
+     * \brief Destroys the records.
+    **/
+    ~soa_vector() { clear(); }
+    /*!
+     * \brief Returns a proxy reference to the record at 'pos'.
+     *        No bounds checking is performed!
+     * \param pos Position of the record to return.
+     * \return A std::tuple of references to the fields of the record.
+    **/
+    PL_NODISCARD reference operator[](size_type pos) noexcept
+    {
+        return row(pos, std::index_sequence_for<Fields...>{});
+    }
+
+    /*!
+     * \brief Returns a proxy reference to the record at 'pos'.
+     *        No bounds checking is performed!
+     * \param pos Position of the record to return.
+     * \return A std::tuple of references to the fields of the record.
+    **/
+    PL_NODISCARD const_reference operator[](size_type pos) const noexcept
+    {
+        return row(pos, std::index_sequence_for<Fields...>{});
+    }
+
+    /*!
+     * \brief Returns a proxy reference to the record at 'pos', with bounds
+     *        checking.
+     * \param pos Position of the record to return.
+     * \return A std::tuple of references to the fields of the record.
+     * \throws std::out_of_range if 'pos' is not less than size().
+    **/
+    PL_NODISCARD reference at(size_type pos)
+    {
+        check_bounds(pos);
+        return (*this)[pos];
+    }
+
+    /*!
+     * \brief Returns a proxy reference to the record at 'pos', with bounds
+     *        checking.
+     * \param pos Position of the record to return.
+     * \return A std::tuple of references to the fields of the record.
+     * \throws std::out_of_range if 'pos' is not less than size().
+    **/
+    PL_NODISCARD const_reference at(size_type pos) const
+    {
+        check_bounds(pos);
+        return (*this)[pos];
+    }
+
+    /*!
+     * \brief Returns a proxy reference to the first record.
+     * \warning Calling front on an empty soa_vector is undefined.
+    **/
+    PL_NODISCARD reference front()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        return (*this)[0U];
+    }
+
+    /*!
+     * \brief Returns a proxy reference to the last record.
+     * \warning Calling back on an empty soa_vector is undefined.
+    **/
+    PL_NODISCARD reference back()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        return (*this)[m_size - 1U];
+    }
+
+    /*!
+     * \brief Returns the array of the field at index Index.
+     * \return A column_span of size() elements, aligned to at least a
+     *         cache line.
+    **/
+    template <std::size_t Index>
+    PL_NODISCARD column_span<field_type<Index>> column() noexcept
+    {
+        return column_span<field_type<Index>>{data<Index>(), m_size};
+    }
+
+    /*!
+     * \brief Returns the array of the field at index Index.
+     * \return A column_span of size() elements, aligned to at least a
+     *         cache line.
+    **/
+    template <std::size_t Index>
+    PL_NODISCARD column_span<const field_type<Index>> column() const noexcept
+    {
+        return column_span<const field_type<Index>>{data<Index>(), m_size};
+    }
+
+    /*!
+     * \brief Returns a pointer to the array of the field at index Index.
+    **/
+    template <std::size_t Index>
+    PL_NODISCARD field_type<Index>* data() noexcept
+    {
+        return static_cast<field_type<Index>*>(m_columns[Index].data());
+    }
+
+    /*!
+     * \brief Returns a pointer to the array of the field at index Index.
+    **/
+    template <std::size_t Index>
+    PL_NODISCARD const field_type<Index>* data() const noexcept
+    {
+        return static_cast<const field_type<Index>*>(m_columns[Index].data());
+    }
+
+    /*!
+     * \brief Returns an iterator to the first record.
+    **/
+    PL_NODISCARD iterator begin() noexcept { return iterator{this, 0U}; }
+    /*!
+     * \brief Returns an iterator to the first record.
+    **/
+    PL_NODISCARD const_iterator begin() const noexcept
+    {
+        return const_iterator{this, 0U};
+    }
+
+    /*!
+     * \brief Returns an iterator to the record following the last record.
+    **/
+    PL_NODISCARD iterator end() noexcept { return iterator{this, m_size}; }
+    /*!
+     * \brief Returns an iterator to the record following the last record.
+    **/
+    PL_NODISCARD const_iterator end() const noexcept
+    {
+        return const_iterator{this, m_size};
+    }
+
+    /*!
+     * \brief Checks if the soa_vector has no records.
+    **/
+    PL_NODISCARD bool empty() const noexcept { return m_size == 0U; }
+    /*!
+     * \brief Returns the number of records.
+    **/
+    PL_NODISCARD size_type size() const noexcept { return m_size; }
+    /*!
+     * \brief Returns the number of records that can be held without
+     *        allocating.
+    **/
+    PL_NODISCARD size_type capacity() const noexcept { return m_capacity; }
+    /*!
+     * \brief Makes sure that at least new_capacity records can be held
+     *        without allocating.
+     * \param new_capacity The capacity to reserve.
+     * \throws std::bad_alloc if the memory could not be allocated.
+    **/
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity > m_capacity) {
+            reallocate(new_capacity, std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    /*!
+     * \brief Destroys all the records. Keeps the capacity.
+    **/
+    void clear() noexcept
+    {
+        destroy_rows(0U, std::index_sequence_for<Fields...>{});
+        m_size = 0U;
+    }
+
+    /*!
+     * \brief Appends a record constructing each field from the
+     *        corresponding argument.
+     * \param args One argument per field, may refer to records.
+    **/
+    template <typename... Args>
+    void push_back(Args&&... args)
+    {
+        static_assert(
+            sizeof...(Args) == field_count,
+            "push_back needs one argument per field.");
+
+        if (m_size == m_capacity) {
+            // the arguments may refer to records, so copy them first.
+            value_type record(std::forward<Args>(args)...);
+            reserve(grown_capacity(m_size + 1U));
+            construct_row_from(
+                m_size, record, std::index_sequence_for<Fields...>{});
+        }
+        else {
+            construct_row(
+                m_size,
+                std::index_sequence_for<Fields...>{},
+                std::forward<Args>(args)...);
+        }
+
+        ++m_size;
+    }
+
+    /*!
+     * \brief Destroys the last record.
+     * \warning Calling pop_back on an empty soa_vector is undefined.
+    **/
+    void pop_back()
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        destroy_rows(m_size - 1U, std::index_sequence_for<Fields...>{});
+        --m_size;
+    }
+
+    /*!
+     * \brief Removes the record at 'pos', moving the following records
+     *        forward.
+     * \param pos The position of the record to remove.
+    **/
+    void erase(size_type pos)
+    {
+        PL_DBG_CHECK_PRE(pos < m_size);
+        erase_row(pos, std::index_sequence_for<Fields...>{});
+        pop_back();
+    }
+
+    /*!
+     * \brief Resizes to count records, appending value initialized records
+     *        if needed.
+     * \param count The new size.
+    **/
+    void resize(size_type count)
+    {
+        if (count < m_size) {
+            destroy_rows(count, std::index_sequence_for<Fields...>{});
+            m_size = count;
+            return;
+        }
+
+        reserve(count);
+
+        while (m_size < count) {
+            construct_row(
+                m_size, std::index_sequence_for<Fields...>{}, Fields()...);
+            ++m_size;
+        }
+    }
+
+    /*!
+     * \brief Exchanges the records of this soa_vector with the ones of
+     *        other.
+     * \param other The other soa_vector.
+    **/
+    void swap(PL_INOUT this_type& other) noexcept
+    {
+        using std::swap;
+        swap(m_columns, other.m_columns);
+        swap(m_size, other.m_size);
+        swap(m_capacity, other.m_capacity);
+    }
+
+private:
+    template <std::size_t... Indices>
+    PL_NODISCARD reference
+    row(size_type pos, std::index_sequence<Indices...>) noexcept
+    {
+        return reference{data<Indices>()[pos]...};
+    }
+
+    template <std::size_t... Indices>
+    PL_NODISCARD const_reference
+    row(size_type pos, std::index_sequence<Indices...>) const noexcept
+    {
+        return const_reference{data<Indices>()[pos]...};
+    }
+
+    void check_bounds(size_type pos) const
+    {
+        if (not(pos < m_size)) {
+            throw std::out_of_range{
+                "pos in pl::soa_vector::at was out of bounds!"};
+        }
+    }
+
+    PL_NODISCARD size_type grown_capacity(size_type minimum) const noexcept
+    {
+        const size_type doubled{m_capacity * 2U};
+        return doubled < minimum ? minimum : doubled;
+    }
+
+    template <std::size_t Index>
+    PL_NODISCARD static aligned_buffer allocate_column(size_type capacity)
+    {
+        using type = field_type<Index>;
+
+        if (capacity > (std::numeric_limits<size_type>::max() / sizeof(type))) {
+            throw std::bad_alloc{};
+        }
+
+        return aligned_buffer{
+            capacity * sizeof(type),
+            alignof(type) < cache_line_size ? cache_line_size : alignof(type)};
+    }
+
+    /*!
+     * \brief Moves the records of the column at index Index into the
+     *        uninitialized column.
+    **/
+    template <std::size_t Index>
+    void relocate_column(PL_INOUT aligned_buffer& column)
+    {
+        using type = field_type<Index>;
+        type* const source{data<Index>()};
+        type* const destination{static_cast<type*>(column.data())};
+        size_type   constructed{0U};
+
+        try {
+            for (; constructed < m_size; ++constructed) {
+                ::new (static_cast<void*>(destination + constructed))
+                    type(std::move_if_noexcept(source[constructed]));
+            }
+        }
+        catch (...) {
+            ::pl::algo::destroy(destination, destination + constructed);
+            throw;
+        }
+    }
+
+    template <std::size_t... Indices>
+    void reallocate(size_type new_capacity, std::index_sequence<Indices...>)
+    {
+        std::array<aligned_buffer, field_count> columns{
+            {allocate_column<Indices>(new_capacity)...}};
+        std::size_t relocated{0U};
+
+        try {
+            (void)std::initializer_list<int>{
+                ((void)relocate_column<Indices>(columns[Indices]),
+                 (void)++relocated,
+                 0)...};
+        }
+        catch (...) {
+            (void)std::initializer_list<int>{
+                ((void)(Indices < relocated
+                            ? ::pl::algo::destroy(
+                                  static_cast<field_type<Indices>*>(
+                                      columns[Indices].data()),
+                                  static_cast<field_type<Indices>*>(
+                                      columns[Indices].data())
+                                      + m_size)
+                            : void()),
+                 0)...};
+            throw;
+        }
+
+        destroy_rows(0U, std::index_sequence<Indices...>{});
+        m_columns.swap(columns);
+        m_capacity = new_capacity;
+    }
+
+    /*!
+     * \brief Constructs the fields of the record at row, destroying the
+     *        fields constructed so far if constructing one throws.
+    **/
+    template <std::size_t... Indices, typename... Args>
+    void construct_row(
+        size_type row,
+        std::index_sequence<Indices...>,
+        Args&&... args)
+    {
+        std::size_t constructed{0U};
+
+        try {
+            (void)std::initializer_list<int>{
+                ((void)::new (static_cast<void*>(data<Indices>() + row))
+                     field_type<Indices>(std::forward<Args>(args)),
+                 (void)++constructed,
+                 0)...};
+        }
+        catch (...) {
+            (void)std::initializer_list<int>{
+                ((void)(Indices < constructed
+                            ? ::pl::algo::destroy_at(data<Indices>() + row)
+                            : void()),
+                 0)...};
+            throw;
+        }
+    }
+
+    template <std::size_t... Indices>
+    void construct_row_from(
+        size_type         row,
+        PL_INOUT value_type& record,
+        std::index_sequence<Indices...> sequence)
+    {
+        construct_row(row, sequence, std::move(std::get<Indices>(record))...);
+    }
+
+    template <typename Tuple, std::size_t... Indices>
+    void push_back_tuple(
+        PL_IN const Tuple& record,
+        std::index_sequence<Indices...>)
+    {
+        push_back(std::get<Indices>(record)...);
+    }
+
+    /*!
+     * \brief Destroys the records from first to the end.
+    **/
+    template <std::size_t... Indices>
+    void destroy_rows(size_type first, std::index_sequence<Indices...>) noexcept
+    {
+        (void)std::initializer_list<int>{
+            ((void)::pl::algo::destroy(
+                 data<Indices>() + first, data<Indices>() + m_size),
+             0)...};
+    }
+
+    template <std::size_t... Indices>
+    void erase_row(size_type pos, std::index_sequence<Indices...>)
+    {
+        (void)std::initializer_list<int>{
+            ((void)std::move(
+                 data<Indices>() + pos + 1U,
+                 data<Indices>() + m_size,
+                 data<Indices>() + pos),
+             0)...};
+    }
+
+    std::array<aligned_buffer, field_count> m_columns; //!< one per field.
+    size_type                               m_size;
+    size_type                               m_capacity;
+};
+
+template <typename... Fields>
+constexpr std::size_t soa_vector<Fields...>::field_count;
+
+/*!
+ * \brief Exchanges the records of 'lhs' and 'rhs'.
+ * \param lhs The first operand.
+ * \param rhs The second operand.
+**/
+template <typename... Fields>
+void swap(
+    PL_INOUT soa_vector<Fields...>& lhs,
+    PL_INOUT soa_vector<Fields...>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+} // namespace pl
+#endif // INCG_PL_SOA_VECTOR_HPP
@@ -37,12 +37,14 @@
 #include <algorithm>   // std::min, std::copy_n
 #include <ciso646>     // and, not
 #include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <cstdint>     // std::uint64_t
+#include <functional>  // std::hash
 #include <ios>         // std::streamsize
 #include <iterator>    // std::reverse_iterator
 #include <ostream>     // std::basic_ostream
 #include <stdexcept>   // std::out_of_range
 #include <string>      // std::char_Traits, std::basic_string
-#include <type_traits> // std::is_same, std::is_pointer
+#include <type_traits> // std::is_same, std::is_pointer, std::make_unsigned
 
 #if PL_COMPILER == PL_COMPILER_MSVC
 #pragma warning(push)
@@ -826,6 +828,48 @@ using u16string_view = basic_string_view<char16_t>;
 using u32string_view = basic_string_view<char32_t>;
 using wstring_view   = basic_string_view<wchar_t>;
 
+/*!
+ * \brief Computes the 64 bit FNV-1a hash of a string view.
+ * \param string The string view to hash.
+ * \return The hash value.
+ * \note Characters wider than a byte are hashed one byte at a time,
+ *       least significant byte first, so the result doesn't depend on
+ *       the byte order of the machine.
+ *       Using msvc this function will only be a constexpr function
+ *       if msvc17 or newer is used.
+ *
+ * This is the hash used by std::hash<pl::basic_string_view> and by the
+ * _h literal, so it can be used to switch over strings:
+ * switch (std::hash<pl::string_view>{}(key)) { case "alpha"_h: ... }
+**/
+template <typename CharT, typename Traits>
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+constexpr
+#else
+inline
+#endif
+    std::uint64_t
+    fnv1a(basic_string_view<CharT, Traits> string) noexcept
+{
+    using unsigned_char_type = typename std::make_unsigned<CharT>::type;
+    constexpr std::uint64_t offset_basis{0xCBF29CE484222325ULL};
+    constexpr std::uint64_t prime{0x100000001B3ULL};
+
+    std::uint64_t hash{offset_basis};
+
+    for (const CharT character : string) {
+        const auto value = static_cast<unsigned_char_type>(character);
+
+        for (std::size_t byte{0U}; byte < sizeof(CharT); ++byte) {
+            hash ^= static_cast<std::uint64_t>(value >> (byte * 8U)) & 0xFFU;
+            hash *= prime;
+        }
+    }
+
+    return hash;
+}
+
 inline namespace literals {
 inline namespace string_view_literals {
 constexpr string_view operator""_sv(
@@ -856,8 +900,105 @@ constexpr wstring_view operator""_sv(
     return wstring_view{string, size};
 }
 } // inline namespace string_view_literals
+
+inline namespace hash_literals {
+/*!
+ * \brief Hashes a string literal at compile time.
+ * \return The same value as std::hash<pl::string_view> yields for the
+ *         literal at runtime.
+**/
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+constexpr
+#else
+inline
+#endif
+    std::size_t
+    operator""_h(
+        PL_IN       PL_NULL_TERMINATED(const char*) string,
+        std::size_t size) noexcept
+{
+    return static_cast<std::size_t>(fnv1a(string_view{string, size}));
+}
+
+/*!
+ * \brief Hashes a string literal at compile time.
+ * \return The same value as std::hash<pl::u16string_view> yields for the
+ *         literal at runtime.
+**/
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+constexpr
+#else
+inline
+#endif
+    std::size_t
+    operator""_h(
+        PL_IN       PL_NULL_TERMINATED(const char16_t*) string,
+        std::size_t size) noexcept
+{
+    return static_cast<std::size_t>(fnv1a(u16string_view{string, size}));
+}
+
+/*!
+ * \brief Hashes a string literal at compile time.
+ * \return The same value as std::hash<pl::u32string_view> yields for the
+ *         literal at runtime.
+**/
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+constexpr
+#else
+inline
+#endif
+    std::size_t
+    operator""_h(
+        PL_IN       PL_NULL_TERMINATED(const char32_t*) string,
+        std::size_t size) noexcept
+{
+    return static_cast<std::size_t>(fnv1a(u32string_view{string, size}));
+}
+
+/*!
+ * \brief Hashes a string literal at compile time.
+ * \return The same value as std::hash<pl::wstring_view> yields for the
+ *         literal at runtime.
+**/
+#if (PL_COMPILER != PL_COMPILER_MSVC) \
+    || (PL_COMPILER_VERSION >= PL_COMPILER_VERSION_CHECK(19, 11, 0))
+constexpr
+#else
+inline
+#endif
+    std::size_t
+    operator""_h(
+        PL_IN       PL_NULL_TERMINATED(const wchar_t*) string,
+        std::size_t size) noexcept
+{
+    return static_cast<std::size_t>(fnv1a(wstring_view{string, size}));
+}
+} // inline namespace hash_literals
 } // inline namespace literals
 } // namespace pl
+
+namespace std {
+/*!
+ * \brief Hashes string views using pl::fnv1a.
+ *        Like for std::basic_string_view only std::char_traits is
+ *        supported, as fnv1a ignores Traits::eq.
+**/
+template <typename CharT>
+struct hash<::pl::basic_string_view<CharT, std::char_traits<CharT>>> {
+    using argument_type
+        = ::pl::basic_string_view<CharT, std::char_traits<CharT>>;
+    using result_type   = std::size_t;
+
+    result_type operator()(argument_type view) const noexcept
+    {
+        return static_cast<result_type>(::pl::fnv1a(view));
+    }
+};
+} // namespace std
 #if PL_COMPILER == PL_COMPILER_MSVC
 #pragma warning(pop)
 #endif // PL_COMPILER == PL_COMPILER_MSVC
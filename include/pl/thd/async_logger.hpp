@@ -0,0 +1,535 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file async_logger.hpp
+ * \brief Defines the async_logger class, an asynchronous printf-style
+ *        logger whose messages are written by a background thread.
+**/
+#ifndef INCG_PL_THD_ASYNC_LOGGER_HPP
+#define INCG_PL_THD_ASYNC_LOGGER_HPP
+#include "../annotations.hpp"     // PL_IN, PL_FMT_STR, PL_PRINTF_FUNCTION, PL_NODISCARD
+#include "../assert.hpp"          // PL_DBG_CHECK_PRE
+#include "../os.hpp"              // PL_OS, PL_OS_WINDOWS
+#include "counting_semaphore.hpp" // pl::thd::counting_semaphore
+#include "futex.hpp"              // pl::thd::futex_wait, pl::thd::futex_wake_one, pl::thd::futex_wake_all
+#include <atomic>                 // std::atomic
+#include <cerrno>                 // errno, EINTR
+#include <ciso646>                // not, and
+#include <cstdarg>                // std::va_list, va_start, va_end
+#include <cstddef>                // std::size_t, std::ptrdiff_t
+#include <cstdint>                // std::uint32_t, std::uint64_t
+#include <cstdio>                 // std::vsnprintf
+#include <memory>                 // std::unique_ptr
+#include <thread>                 // std::thread
+#include <vector>                 // std::vector
+#if PL_OS == PL_OS_WINDOWS
+#include <io.h> // _write
+#else
+#include <climits>   // IOV_MAX
+#include <sys/uio.h> // writev, iovec
+#include <unistd.h>  // ssize_t
+#endif
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief What an async_logger does when all its buffers are in use.
+**/
+enum class log_overflow_policy {
+    block, //!< the logging thread waits for the writer to free a buffer.
+    drop   //!< the message is discarded and counted as dropped.
+};
+
+/*!
+ * \brief Configuration of an async_logger.
+**/
+struct async_logger_options {
+    std::size_t buffer_count = 256U;  /*!< the amount of message buffers,
+                                       *   rounded up to a power of two.
+                                      **/
+    std::size_t buffer_size = 512U;   /*!< the size of a message buffer.
+                                       *   Longer messages are truncated.
+                                      **/
+    log_overflow_policy overflow_policy
+        = log_overflow_policy::block; //!< used if all buffers are in use.
+};
+
+namespace detail {
+/*!
+ * \brief A bounded lock-free multi-producer multi-consumer queue using
+ *        sequence numbers per cell (after Dmitry Vyukov).
+ *        Not to be used directly.
+**/
+template <typename Type>
+class bounded_mpmc_queue {
+public:
+    using this_type = bounded_mpmc_queue;
+
+    explicit bounded_mpmc_queue(std::size_t capacity)
+        : m_cells{new cell[capacity]},
+          m_mask{capacity - 1U},
+          m_enqueue_pos{0U},
+          m_dequeue_pos{0U}
+    {
+        PL_DBG_CHECK_PRE(
+            (capacity != 0U) and ((capacity & (capacity - 1U)) == 0U));
+
+        for (std::size_t i{0U}; i < capacity; ++i) {
+            m_cells[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bounded_mpmc_queue(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    PL_NODISCARD bool try_push(Type value) noexcept
+    {
+        std::size_t pos{m_enqueue_pos.load(std::memory_order_relaxed)};
+        cell*       current{nullptr};
+
+        for (;;) {
+            current = &m_cells[pos & m_mask];
+            const std::size_t sequence{
+                current->m_sequence.load(std::memory_order_acquire)};
+
+            if (sequence == pos) {
+                if (m_enqueue_pos.compare_exchange_weak(
+                        pos, pos + 1U, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (sequence < pos) {
+                return false;
+            }
+            else {
+                pos = m_enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        current->m_value = value;
+        current->m_sequence.store(pos + 1U, std::memory_order_release);
+        return true;
+    }
+
+    PL_NODISCARD bool try_pop(Type& value) noexcept
+    {
+        std::size_t pos{m_dequeue_pos.load(std::memory_order_relaxed)};
+        cell*       current{nullptr};
+
+        for (;;) {
+            current = &m_cells[pos & m_mask];
+            const std::size_t sequence{
+                current->m_sequence.load(std::memory_order_acquire)};
+
+            if (sequence == pos + 1U) {
+                if (m_dequeue_pos.compare_exchange_weak(
+                        pos, pos + 1U, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (sequence < pos + 1U) {
+                return false;
+            }
+            else {
+                pos = m_dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = current->m_value;
+        current->m_sequence.store(pos + m_mask + 1U, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct cell {
+        cell() : m_sequence{0U}, m_value{} {}
+
+        std::atomic<std::size_t> m_sequence;
+        Type                     m_value;
+    };
+
+    std::unique_ptr<cell[]>              m_cells;
+    const std::size_t                    m_mask;
+    alignas(64) std::atomic<std::size_t> m_enqueue_pos;
+    alignas(64) std::atomic<std::size_t> m_dequeue_pos;
+};
+
+/*!
+ * \brief A message buffer of an async_logger.
+ *        Not to be used directly.
+**/
+struct async_log_buffer {
+    char*       data; //!< points into the storage of the logger.
+    std::size_t size; //!< the length of the message.
+};
+
+inline std::size_t round_up_to_power_of_two(std::size_t value) noexcept
+{
+    std::size_t result{1U};
+
+    while (result < value) {
+        result <<= 1U;
+    }
+
+    return result;
+}
+} // namespace detail
+
+/*!
+ * \brief An asynchronous printf-style logger.
+ *
+ * All the memory is allocated up front: a fixed amount of fixed size
+ * message buffers. A logging thread checks out a free buffer, formats the
+ * message directly into it and hands it over to the background writer
+ * thread through a lock-free queue. The writer gathers as many ready
+ * buffers as are available and writes them using a single writev(2)
+ * call, then returns them to the free queue. If all buffers are in use,
+ * logging threads either wait or drop the message, depending on the
+ * overflow policy.
+ *
+ * Example:
+ * \code
+ * pl::thd::async_logger logger{};
+ * logger.log("%s: %d\n", "answer", 42);
+ * \endcode
+**/
+class async_logger {
+public:
+    using this_type = async_logger;
+
+    /*!
+     * \brief Creates an async_logger writing to the file descriptor given.
+     * \param file_descriptor The file descriptor to write to, must remain
+     *                        open for the lifetime of the async_logger.
+     *                        Defaults to stderr.
+     * \param options The configuration to use.
+     * \throws pl::precondition_violation_exception if buffer_count or
+     *         buffer_size is 0 (debug mode only).
+    **/
+    explicit async_logger(
+        int                  file_descriptor = 2,
+        async_logger_options options         = async_logger_options{})
+        : m_fd{file_descriptor},
+          m_overflow_policy{options.overflow_policy},
+          m_buffer_size{options.buffer_size},
+          m_storage{},
+          m_buffers{},
+          m_free{detail::round_up_to_power_of_two(options.buffer_count)},
+          m_ready{detail::round_up_to_power_of_two(options.buffer_count)},
+          m_free_count{0},
+          m_is_done{false},
+          m_submitted{0U},
+          m_written{0U},
+          m_written_epoch{0U},
+          m_flush_waiters{0U},
+          m_writer_sleeping{0U},
+          m_dropped{0U},
+          m_writer{}
+    {
+        PL_DBG_CHECK_PRE(
+            (options.buffer_count != 0U) and (options.buffer_size != 0U));
+        const std::size_t buffer_count{
+            detail::round_up_to_power_of_two(options.buffer_count)};
+        m_storage.reset(new char[buffer_count * m_buffer_size]);
+        m_buffers.resize(buffer_count);
+
+        for (std::size_t i{0U}; i < buffer_count; ++i) {
+            m_buffers[i].data = m_storage.get() + (i * m_buffer_size);
+            m_buffers[i].size = 0U;
+            (void)m_free.try_push(&m_buffers[i]);
+        }
+
+        m_free_count.release(static_cast<std::ptrdiff_t>(buffer_count));
+        m_writer = std::thread{[this] { write_loop(); }};
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    async_logger(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Writes all the messages logged and joins the writer thread.
+     * \warning No thread may be logging concurrently.
+    **/
+    ~async_logger()
+    {
+        m_is_done.store(true);
+        wake_writer();
+        m_writer.join();
+    }
+
+    /*!
+     * \brief Formats a message and queues it for writing.
+     * \param format_string A null-terminated printf-style format string.
+     * \return true if the message was queued; false if it was dropped.
+     * \note Messages longer than the buffer size are truncated.
+    **/
+    PL_PRINTF_FUNCTION(2, 3)
+    bool log(PL_IN PL_FMT_STR(const char*) format_string, ...)
+    {
+        std::va_list args{};
+        va_start(args, format_string);
+        const bool result{vlog(format_string, args)};
+        va_end(args);
+        return result;
+    }
+
+    /*!
+     * \brief Like log, but takes a std::va_list.
+     * \param format_string A null-terminated printf-style format string.
+     * \param args The arguments for the format string.
+     * \return true if the message was queued; false if it was dropped.
+    **/
+    PL_PRINTF_FUNCTION(2, 0)
+    bool vlog(PL_IN PL_FMT_STR(const char*) format_string, std::va_list args)
+    {
+        detail::async_log_buffer* buffer{acquire_buffer()};
+
+        if (buffer == nullptr) {
+            return false;
+        }
+
+        const int length{
+            std::vsnprintf(buffer->data, m_buffer_size, format_string, args)};
+
+        if (length <= 0) {
+            buffer->size = 0U;
+        }
+        else if (static_cast<std::size_t>(length) >= m_buffer_size) {
+            buffer->size = m_buffer_size - 1U;
+        }
+        else {
+            buffer->size = static_cast<std::size_t>(length);
+        }
+
+        m_submitted.fetch_add(1U);
+        (void)m_ready.try_push(buffer);
+        wake_writer();
+        return true;
+    }
+
+    /*!
+     * \brief Blocks until all the messages queued by now have been written.
+    **/
+    void flush()
+    {
+        const std::uint64_t target{m_submitted.load()};
+
+        for (;;) {
+            const std::uint32_t epoch{m_written_epoch.load()};
+
+            if (m_written.load() >= target) {
+                return;
+            }
+
+            m_flush_waiters.fetch_add(1U);
+            futex_wait(m_written_epoch, epoch);
+            m_flush_waiters.fetch_sub(1U);
+        }
+    }
+
+    /*!
+     * \brief Returns the amount of messages dropped because all buffers
+     *        were in use.
+    **/
+    PL_NODISCARD std::uint64_t dropped() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    detail::async_log_buffer* acquire_buffer()
+    {
+        if (m_overflow_policy == log_overflow_policy::drop) {
+            if (not m_free_count.try_acquire()) {
+                m_dropped.fetch_add(1U, std::memory_order_relaxed);
+                return nullptr;
+            }
+        }
+        else {
+            m_free_count.acquire();
+        }
+
+        detail::async_log_buffer* buffer{nullptr};
+
+        // a buffer is guaranteed to be available, but may not be visible
+        // in the queue yet if it is being returned right now.
+        while (not m_free.try_pop(buffer)) {
+            std::this_thread::yield();
+        }
+
+        return buffer;
+    }
+
+    /*!
+     * \brief Wakes the writer thread if it is sleeping. Only the first
+     *        caller after the writer went to sleep issues a system call.
+    **/
+    void wake_writer() noexcept
+    {
+        if (m_writer_sleeping.exchange(0U) == 1U) {
+            futex_wake_one(m_writer_sleeping);
+        }
+    }
+
+    void write_loop()
+    {
+        std::vector<detail::async_log_buffer*> batch{};
+        batch.reserve(max_batch_size());
+        detail::async_log_buffer* buffer{nullptr};
+
+        for (;;) {
+            while ((batch.size() < max_batch_size())
+                   and m_ready.try_pop(buffer)) {
+                batch.push_back(buffer);
+            }
+
+            if (batch.empty()) {
+                // announce going to sleep, then check again, as a message
+                // may have been queued by a thread that did not see the
+                // announcement yet.
+                (void)m_writer_sleeping.exchange(1U);
+
+                if (m_ready.try_pop(buffer)) {
+                    m_writer_sleeping.store(0U);
+                    batch.push_back(buffer);
+                }
+                else if (m_is_done.load()) {
+                    return;
+                }
+                else {
+                    futex_wait(m_writer_sleeping, 1U);
+                    continue;
+                }
+            }
+
+            write_batch(batch);
+
+            for (detail::async_log_buffer* written : batch) {
+                (void)m_free.try_push(written);
+            }
+
+            m_free_count.release(static_cast<std::ptrdiff_t>(batch.size()));
+            m_written.fetch_add(batch.size());
+            m_written_epoch.fetch_add(1U);
+
+            if (m_flush_waiters.load() != 0U) {
+                futex_wake_all(m_written_epoch);
+            }
+
+            batch.clear();
+        }
+    }
+
+    /*!
+     * \brief The maximum amount of messages written with a single call.
+    **/
+    static constexpr std::size_t max_batch_size() noexcept { return 64U; }
+
+#if PL_OS == PL_OS_WINDOWS
+    void write_batch(const std::vector<detail::async_log_buffer*>& batch)
+    {
+        for (const detail::async_log_buffer* buffer : batch) {
+            (void)::_write(
+                m_fd, buffer->data, static_cast<unsigned int>(buffer->size));
+        }
+    }
+#else
+    static_assert(IOV_MAX >= 64, "writev must accept a batch of iovecs");
+
+    void write_batch(const std::vector<detail::async_log_buffer*>& batch)
+    {
+        ::iovec     iov[max_batch_size()];
+        std::size_t count{0U};
+
+        for (const detail::async_log_buffer* buffer : batch) {
+            if (buffer->size != 0U) {
+                iov[count].iov_base = buffer->data;
+                iov[count].iov_len  = buffer->size;
+                ++count;
+            }
+        }
+
+        ::iovec* current{iov};
+
+        while (count != 0U) {
+            const ::ssize_t written{
+                ::writev(m_fd, current, static_cast<int>(count))};
+
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return;
+            }
+
+            // advance past what has been written for partial writes.
+            std::size_t remaining{static_cast<std::size_t>(written)};
+
+            while ((count != 0U) and (remaining >= current->iov_len)) {
+                remaining -= current->iov_len;
+                ++current;
+                --count;
+            }
+
+            if (count != 0U) {
+                current->iov_base = static_cast<char*>(current->iov_base)
+                                    + remaining;
+                current->iov_len -= remaining;
+            }
+        }
+    }
+#endif
+
+    const int                                             m_fd;
+    const log_overflow_policy                             m_overflow_policy;
+    const std::size_t                                     m_buffer_size;
+    std::unique_ptr<char[]>                               m_storage;
+    std::vector<detail::async_log_buffer>                 m_buffers;
+    detail::bounded_mpmc_queue<detail::async_log_buffer*> m_free;
+    detail::bounded_mpmc_queue<detail::async_log_buffer*> m_ready;
+    counting_semaphore<>                                  m_free_count;
+    std::atomic<bool>                                     m_is_done;
+    std::atomic<std::uint64_t>                            m_submitted;
+    std::atomic<std::uint64_t>                            m_written;
+    std::atomic<std::uint32_t>                            m_written_epoch;
+    std::atomic<std::uint32_t>                            m_flush_waiters;
+    std::atomic<std::uint32_t>                            m_writer_sleeping;
+    std::atomic<std::uint64_t>                            m_dropped;
+    std::thread                                           m_writer;
+};
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_ASYNC_LOGGER_HPP
@@ -0,0 +1,202 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file barrier.hpp
+ * \brief Defines the barrier class template from C++20.
+**/
+#ifndef INCG_PL_THD_BARRIER_HPP
+#define INCG_PL_THD_BARRIER_HPP
+#include "../annotations.hpp" // PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include "futex.hpp"          // pl::thd::futex_wait, pl::thd::futex_wake_all
+#include <atomic>             // std::atomic
+#include <ciso646>            // and
+#include <cstddef>            // std::ptrdiff_t
+#include <cstdint>            // std::uint32_t, std::int32_t
+#include <limits>             // std::numeric_limits
+#include <utility>            // std::move
+
+namespace pl {
+namespace thd {
+namespace detail {
+/*!
+ * \brief The completion function used by default, does nothing.
+**/
+class barrier_empty_completion {
+public:
+    void operator()() const noexcept {}
+};
+} // namespace detail
+
+/*!
+ * \brief A reusable barrier for a group of threads. Each phase completes
+ *        once the expected amount of arrivals has been reached, whereupon
+ *        the completion function is run by the last thread to arrive and
+ *        the waiting threads are unblocked.
+ *
+ * Implemented over atomics, waiting threads block on the phase counter
+ * using futex_wait. Arrivals only issue a wake up if threads are actually
+ * waiting.
+ *
+ * Example:
+ * \code
+ * pl::thd::barrier<> barrier{thread_count};
+ * // in each thread
+ * for (int round{0}; round < rounds; ++round) {
+ *     do_work(round);
+ *     barrier.arrive_and_wait();
+ * }
+ * \endcode
+**/
+template <typename CompletionFunction = detail::barrier_empty_completion>
+class barrier {
+public:
+    using this_type = barrier;
+
+    /*!
+     * \brief Returned by arrive, identifies the phase to wait for.
+    **/
+    class arrival_token {
+    public:
+        friend class barrier;
+
+    private:
+        explicit arrival_token(std::uint32_t phase) noexcept : m_phase{phase}
+        {
+        }
+
+        std::uint32_t m_phase;
+    };
+
+    /*!
+     * \brief Returns the maximum expected count.
+    **/
+    static constexpr std::ptrdiff_t max() noexcept
+    {
+        return std::numeric_limits<std::int32_t>::max();
+    }
+
+    /*!
+     * \brief Creates a barrier.
+     * \param expected The amount of arrivals per phase.
+     * \param completion The function to call when a phase completes.
+     * \throws pl::precondition_violation_exception if expected is not in
+     *         [0, max()] (debug mode only).
+    **/
+    explicit barrier(
+        std::ptrdiff_t     expected,
+        CompletionFunction completion = CompletionFunction{})
+        : m_completion{std::move(completion)},
+          m_expected{expected},
+          m_remaining{expected},
+          m_phase{0U},
+          m_waiters{0U}
+    {
+        PL_DBG_CHECK_PRE((expected >= 0) and (expected <= max()));
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    barrier(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Arrives at the current phase update times.
+     * \param update The amount of arrivals.
+     * \return A token to wait for the current phase to complete with.
+     * \throws pl::precondition_violation_exception if update is not
+     *         positive (debug mode only).
+    **/
+    PL_NODISCARD arrival_token arrive(std::ptrdiff_t update = 1)
+    {
+        PL_DBG_CHECK_PRE(update > 0);
+        const std::uint32_t phase{m_phase.load(std::memory_order_acquire)};
+
+        if (m_remaining.fetch_sub(update, std::memory_order_acq_rel)
+            == update) {
+            complete_phase();
+        }
+
+        return arrival_token{phase};
+    }
+
+    /*!
+     * \brief Blocks until the phase identified by token has completed.
+     * \param token The token returned by arrive.
+    **/
+    void wait(arrival_token&& token) const
+    {
+        while (m_phase.load(std::memory_order_acquire) == token.m_phase) {
+            m_waiters.fetch_add(1U);
+            futex_wait(m_phase, token.m_phase);
+            m_waiters.fetch_sub(1U);
+        }
+    }
+
+    /*!
+     * \brief Arrives at the current phase and blocks until it completes.
+    **/
+    void arrive_and_wait() { wait(arrive()); }
+
+    /*!
+     * \brief Arrives at the current phase and decrements the expected count
+     *        of the following phases by one.
+    **/
+    void arrive_and_drop()
+    {
+        m_expected.fetch_sub(1, std::memory_order_relaxed);
+        (void)arrive();
+    }
+
+private:
+    void complete_phase()
+    {
+        m_completion();
+        m_remaining.store(
+            m_expected.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+        m_phase.fetch_add(1U);
+
+        if (m_waiters.load() != 0U) {
+            futex_wake_all(m_phase);
+        }
+    }
+
+    CompletionFunction                 m_completion; //!< run per phase.
+    std::atomic<std::ptrdiff_t>        m_expected;   //!< of the next phase.
+    std::atomic<std::ptrdiff_t>        m_remaining;  //!< arrivals missing.
+    std::atomic<std::uint32_t>         m_phase;      //!< the futex word.
+    mutable std::atomic<std::uint32_t> m_waiters;    //!< threads in wait.
+};
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_BARRIER_HPP
@@ -0,0 +1,322 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file concurrent_hash_map.hpp
+ * \brief Defines the concurrent_hash_map class template, a thread safe
+ *        hash map using lock striping.
+**/
+#ifndef INCG_PL_THD_CONCURRENT_HASH_MAP_HPP
+#define INCG_PL_THD_CONCURRENT_HASH_MAP_HPP
+#include "../aligned_buffer.hpp" // pl::aligned_allocator, pl::cache_line_size
+#include "../annotations.hpp"    // PL_IN, PL_OUT, PL_NODISCARD
+#include "../assert.hpp"         // PL_DBG_CHECK_PRE
+#include "../hash.hpp"           // pl::key_hash
+#include <ciso646>               // and
+#include <cstddef>               // std::size_t
+#include <cstdint>               // std::uint64_t
+#include <functional>            // std::equal_to
+#include <mutex>                 // std::unique_lock
+#include <shared_mutex>          // std::shared_timed_mutex, std::shared_lock
+#include <unordered_map>         // std::unordered_map
+#include <utility>               // std::move
+#include <vector>                // std::vector
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief A thread safe hash map.
+ * \tparam Key The type of the keys.
+ * \tparam Value The type of the mapped values.
+ * \tparam Hash The hash function object. The default, pl::key_hash, uses
+ *              std::hash, or pl::hash for std::pair and std::tuple keys.
+ * \tparam KeyEqual The function object to compare keys.
+ *
+ * The elements are distributed among a fixed amount of shards, each of
+ * which is a std::unordered_map guarded by its own reader-writer lock.
+ * Operations on different shards never contend, lookups on the same shard
+ * only take a shared lock, so that reads scale with the amount of threads.
+ * Every shard occupies its own cache lines, so that taking the lock of one
+ * shard doesn't invalidate the cache line holding the lock of another.
+ * The shard of a key is selected using the upper bits of its mixed hash,
+ * the shard's unordered_map uses the unmixed hash.
+**/
+template <
+    typename Key,
+    typename Value,
+    typename Hash     = key_hash<Key>,
+    typename KeyEqual = std::equal_to<Key>>
+class concurrent_hash_map {
+public:
+    using this_type   = concurrent_hash_map;
+    using key_type    = Key;
+    using mapped_type = Value;
+    using hasher      = Hash;
+    using key_equal   = KeyEqual;
+    using size_type   = std::size_t;
+
+    /*!
+     * \brief The amount of shards used by default.
+    **/
+    static constexpr size_type default_shard_count() noexcept { return 64U; }
+
+    /*!
+     * \brief Creates an empty concurrent_hash_map.
+     * \param shard_count The amount of shards, must be a power of two.
+     *                    More shards reduce contention between writers.
+     * \param hash The hash function object to use.
+     * \param equal The key comparison function object to use.
+     * \throws pl::precondition_violation_exception if shard_count is not a
+     *         power of two (debug mode only).
+    **/
+    explicit concurrent_hash_map(
+        size_type shard_count = default_shard_count(),
+        const Hash&     hash  = Hash{},
+        const KeyEqual& equal = KeyEqual{})
+        : m_shards(shard_count),
+          m_hash{hash},
+          m_shard_count{shard_count},
+          m_shard_shift{64U}
+    {
+        PL_DBG_CHECK_PRE(
+            (shard_count != 0U) and ((shard_count & (shard_count - 1U)) == 0U));
+
+        for (size_type count{shard_count}; count > 1U; count >>= 1U) {
+            --m_shard_shift;
+        }
+
+        if (m_shard_shift == 64U) {
+            m_shard_shift = 0U; // a single shard, the mask selects it.
+        }
+
+        for (size_type i{0U}; i < shard_count; ++i) {
+            m_shards[i].map = map_type{0U, hash, equal};
+        }
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    concurrent_hash_map(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Looks up the value mapped to key.
+     * \param key The key to look for.
+     * \param value Receives a copy of the value if key was found.
+     * \return true if key was found.
+    **/
+    bool find(PL_IN const Key& key, PL_OUT Value& value) const
+    {
+        return visit(key, [&value](const Value& found) { value = found; });
+    }
+
+    /*!
+     * \brief Checks whether the map contains key.
+     * \param key The key to look for.
+     * \return true if key was found.
+    **/
+    PL_NODISCARD bool contains(PL_IN const Key& key) const
+    {
+        const shard&                              s{shard_for(key)};
+        std::shared_lock<std::shared_timed_mutex> lock{s.mutex};
+        return s.map.find(key) != s.map.end();
+    }
+
+    /*!
+     * \brief Invokes callable with the value mapped to key while holding
+     *        a shared lock, avoiding the copy made by find.
+     * \param key The key to look for.
+     * \param callable Called with a const reference to the value.
+     * \return true if key was found.
+     * \warning callable must not access this concurrent_hash_map.
+    **/
+    template <typename Callable>
+    bool visit(PL_IN const Key& key, PL_IN Callable&& callable) const
+    {
+        const shard&                              s{shard_for(key)};
+        std::shared_lock<std::shared_timed_mutex> lock{s.mutex};
+        const auto                                it = s.map.find(key);
+
+        if (it == s.map.end()) {
+            return false;
+        }
+
+        callable(it->second);
+        return true;
+    }
+
+    /*!
+     * \brief Maps key to value, replacing the value mapped to key if any.
+     * \param key The key.
+     * \param value The value to map key to.
+     * \return true if key was inserted; false if its value was replaced.
+    **/
+    bool insert_or_assign(Key key, Value value)
+    {
+        shard&                                    s{shard_for(key)};
+        std::unique_lock<std::shared_timed_mutex> lock{s.mutex};
+        const auto                                it = s.map.find(key);
+
+        if (it != s.map.end()) {
+            it->second = std::move(value);
+            return false;
+        }
+
+        s.map.emplace(std::move(key), std::move(value));
+        return true;
+    }
+
+    /*!
+     * \brief Invokes callable with the value mapped to key while holding
+     *        an exclusive lock, allowing it to modify the value in place.
+     * \param key The key to look for.
+     * \param callable Called with a non-const reference to the value.
+     * \return true if key was found.
+     * \warning callable must not access this concurrent_hash_map.
+    **/
+    template <typename Callable>
+    bool update(PL_IN const Key& key, PL_IN Callable&& callable)
+    {
+        shard&                                    s{shard_for(key)};
+        std::unique_lock<std::shared_timed_mutex> lock{s.mutex};
+        const auto                                it = s.map.find(key);
+
+        if (it == s.map.end()) {
+            return false;
+        }
+
+        callable(it->second);
+        return true;
+    }
+
+    /*!
+     * \brief Removes the element with key, if any.
+     * \param key The key of the element to remove.
+     * \return true if an element was removed.
+    **/
+    bool erase(PL_IN const Key& key)
+    {
+        shard&                                    s{shard_for(key)};
+        std::unique_lock<std::shared_timed_mutex> lock{s.mutex};
+        return s.map.erase(key) != 0U;
+    }
+
+    /*!
+     * \brief Returns the amount of elements.
+     * \note The shards are counted one after another, so the result is
+     *       only exact if the map is not modified concurrently.
+    **/
+    PL_NODISCARD size_type size() const
+    {
+        size_type result{0U};
+
+        for (size_type i{0U}; i < m_shard_count; ++i) {
+            std::shared_lock<std::shared_timed_mutex> lock{m_shards[i].mutex};
+            result += m_shards[i].map.size();
+        }
+
+        return result;
+    }
+
+    /*!
+     * \brief Checks whether the map is empty, see size.
+    **/
+    PL_NODISCARD bool empty() const { return size() == 0U; }
+
+    /*!
+     * \brief Removes all elements.
+    **/
+    void clear()
+    {
+        for (size_type i{0U}; i < m_shard_count; ++i) {
+            std::unique_lock<std::shared_timed_mutex> lock{m_shards[i].mutex};
+            m_shards[i].map.clear();
+        }
+    }
+
+    /*!
+     * \brief Invokes callable with each key and value. Each shard is locked
+     *        shared while it is being visited.
+     * \param callable Called with the key and a const reference to the
+     *                 value of each element.
+     * \warning callable must not access this concurrent_hash_map.
+    **/
+    template <typename Callable>
+    void for_each(PL_IN Callable&& callable) const
+    {
+        for (size_type i{0U}; i < m_shard_count; ++i) {
+            std::shared_lock<std::shared_timed_mutex> lock{m_shards[i].mutex};
+
+            for (const auto& element : m_shards[i].map) {
+                callable(element.first, element.second);
+            }
+        }
+    }
+
+    /*!
+     * \brief Returns the amount of shards.
+    **/
+    PL_NODISCARD size_type shard_count() const noexcept
+    {
+        return m_shard_count;
+    }
+
+private:
+    using map_type = std::unordered_map<Key, Value, Hash, KeyEqual>;
+
+    struct alignas(cache_line_size) shard {
+        shard() : mutex{}, map{} {}
+
+        mutable std::shared_timed_mutex mutex;
+        map_type                        map;
+    };
+
+    shard& shard_for(PL_IN const Key& key) const
+    {
+        // std::hash of integers is the identity on common implementations,
+        // so the hash is mixed before its upper bits select the shard.
+        static constexpr std::uint64_t golden_ratio{0x9E3779B97F4A7C15U};
+        const std::uint64_t            mixed{
+            static_cast<std::uint64_t>(m_hash(key)) * golden_ratio};
+        return m_shards[static_cast<size_type>(mixed >> m_shard_shift)
+                        & (m_shard_count - 1U)];
+    }
+
+    using shard_vector = std::vector<shard, aligned_allocator<shard>>;
+
+    mutable shard_vector m_shards; //!< each shard is guarded by its mutex.
+    Hash                 m_hash;
+    size_type            m_shard_count;
+    unsigned             m_shard_shift; //!< 64 - log2(shard_count)
+};
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_CONCURRENT_HASH_MAP_HPP
@@ -0,0 +1,196 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file counting_semaphore.hpp
+ * \brief Defines the counting_semaphore class template and the
+ *        binary_semaphore type alias from C++20.
+**/
+#ifndef INCG_PL_THD_COUNTING_SEMAPHORE_HPP
+#define INCG_PL_THD_COUNTING_SEMAPHORE_HPP
+#include "../annotations.hpp" // PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include "futex.hpp"          // pl::thd::futex_wait, pl::thd::futex_wait_for, pl::thd::futex_wake_one, pl::thd::futex_wake_all
+#include <atomic>             // std::atomic
+#include <chrono>             // std::chrono::duration, std::chrono::time_point, std::chrono::steady_clock
+#include <ciso646>            // and, not
+#include <cstddef>            // std::ptrdiff_t
+#include <cstdint>            // std::uint32_t, std::int32_t
+#include <limits>             // std::numeric_limits
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief A semaphore with a non-negative resource count.
+ * \tparam LeastMaxValue The maximum value the count can reach.
+ *
+ * Implemented over an atomic counter. acquire blocks on the counter using
+ * futex_wait if no resource is available, release only issues a wake up if
+ * threads are actually waiting.
+**/
+template <std::ptrdiff_t LeastMaxValue = std::numeric_limits<std::int32_t>::max()>
+class counting_semaphore {
+public:
+    using this_type = counting_semaphore;
+
+    static_assert(
+        (LeastMaxValue >= 0)
+            and (LeastMaxValue <= std::numeric_limits<std::int32_t>::max()),
+        "LeastMaxValue must be in [0, INT32_MAX]");
+
+    /*!
+     * \brief Returns the maximum value of the count.
+    **/
+    static constexpr std::ptrdiff_t max() noexcept { return LeastMaxValue; }
+
+    /*!
+     * \brief Creates a counting_semaphore.
+     * \param desired The initial count.
+     * \throws pl::precondition_violation_exception if desired is not in
+     *         [0, max()] (debug mode only).
+    **/
+    explicit counting_semaphore(std::ptrdiff_t desired)
+        : m_count{static_cast<std::uint32_t>(desired)}, m_waiters{0U}
+    {
+        PL_DBG_CHECK_PRE((desired >= 0) and (desired <= max()));
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    counting_semaphore(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Increments the count by update, unblocking waiting threads.
+     * \param update The value to increment the count by.
+     * \throws pl::precondition_violation_exception if update is negative
+     *         (debug mode only).
+    **/
+    void release(std::ptrdiff_t update = 1)
+    {
+        PL_DBG_CHECK_PRE(update >= 0);
+        m_count.fetch_add(static_cast<std::uint32_t>(update));
+
+        if (m_waiters.load() != 0U) {
+            if (update == 1) {
+                futex_wake_one(m_count);
+            }
+            else {
+                futex_wake_all(m_count);
+            }
+        }
+    }
+
+    /*!
+     * \brief Decrements the count, blocking until it is greater than zero.
+    **/
+    void acquire()
+    {
+        while (not try_acquire()) {
+            m_waiters.fetch_add(1U);
+            futex_wait(m_count, 0U);
+            m_waiters.fetch_sub(1U);
+        }
+    }
+
+    /*!
+     * \brief Decrements the count if it is greater than zero.
+     * \return true if the count was decremented.
+    **/
+    PL_NODISCARD bool try_acquire() noexcept
+    {
+        std::uint32_t count{m_count.load(std::memory_order_relaxed)};
+
+        while (count != 0U) {
+            if (m_count.compare_exchange_weak(
+                    count,
+                    count - 1U,
+                    std::memory_order_acquire,
+                    std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /*!
+     * \brief Like acquire, but gives up after rel_time.
+     * \param rel_time The maximum duration to block for.
+     * \return true if the count was decremented.
+    **/
+    template <typename Rep, typename Period>
+    PL_NODISCARD bool try_acquire_for(
+        const std::chrono::duration<Rep, Period>& rel_time)
+    {
+        return try_acquire_until(std::chrono::steady_clock::now() + rel_time);
+    }
+
+    /*!
+     * \brief Like acquire, but gives up once abs_time has been reached.
+     * \param abs_time The point in time to give up at.
+     * \return true if the count was decremented.
+    **/
+    template <typename Clock, typename Duration>
+    PL_NODISCARD bool try_acquire_until(
+        const std::chrono::time_point<Clock, Duration>& abs_time)
+    {
+        while (not try_acquire()) {
+            const auto remaining = abs_time - Clock::now();
+
+            if (remaining <= Clock::duration::zero()) {
+                return false;
+            }
+
+            m_waiters.fetch_add(1U);
+            futex_wait_for(
+                m_count,
+                0U,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    remaining));
+            m_waiters.fetch_sub(1U);
+        }
+
+        return true;
+    }
+
+private:
+    std::atomic<std::uint32_t> m_count;   //!< the futex word.
+    std::atomic<std::uint32_t> m_waiters; //!< threads blocked in acquire.
+};
+
+/*!
+ * \brief A semaphore with only two states.
+**/
+using binary_semaphore = counting_semaphore<1>;
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_COUNTING_SEMAPHORE_HPP
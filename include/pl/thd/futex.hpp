@@ -0,0 +1,237 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file futex.hpp
+ * \brief Defines functions to block on and wake threads waiting on an atomic
+ *        32 bit word. Uses futexes on Linux and falls back to a table of
+ *        condition variables on other operating systems.
+**/
+#ifndef INCG_PL_THD_FUTEX_HPP
+#define INCG_PL_THD_FUTEX_HPP
+#include "../os.hpp" // PL_OS, PL_OS_LINUX
+#include <atomic>    // std::atomic, ATOMIC_INT_LOCK_FREE
+#include <chrono>    // std::chrono::nanoseconds
+#include <ciso646>   // and
+#include <cstdint>   // std::uint32_t, std::uintptr_t
+#if PL_OS == PL_OS_LINUX
+#include <climits>       // INT_MAX
+#include <time.h>        // timespec, time_t
+#include <linux/futex.h> // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h> // SYS_futex
+#include <unistd.h>      // syscall
+#else
+#include <condition_variable> // std::condition_variable
+#include <mutex>              // std::mutex, std::unique_lock
+#endif
+
+namespace pl {
+namespace thd {
+static_assert(
+    (sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t))
+        and (ATOMIC_INT_LOCK_FREE == 2),
+    "std::atomic<std::uint32_t> must be a lock free plain 32 bit word.");
+
+#if PL_OS == PL_OS_LINUX
+namespace detail {
+inline std::uint32_t* futex_address(
+    const std::atomic<std::uint32_t>& word) noexcept
+{
+    return const_cast<std::uint32_t*>(
+        reinterpret_cast<const std::uint32_t*>(&word));
+}
+
+inline void futex_wake(const std::atomic<std::uint32_t>& word, int count)
+    noexcept
+{
+    (void)::syscall(
+        SYS_futex,
+        futex_address(word),
+        FUTEX_WAKE_PRIVATE,
+        count,
+        nullptr,
+        nullptr,
+        0);
+}
+} // namespace detail
+
+/*!
+ * \brief Blocks the calling thread as long as word holds expected, until it
+ *        is woken by futex_wake_one or futex_wake_all.
+ * \param word The word to wait on.
+ * \param expected The value that word is expected to hold.
+ * \note May return spuriously, callers have to check their condition in
+ *       a loop.
+**/
+inline void futex_wait(
+    const std::atomic<std::uint32_t>& word,
+    std::uint32_t                     expected) noexcept
+{
+    (void)::syscall(
+        SYS_futex,
+        detail::futex_address(word),
+        FUTEX_WAIT_PRIVATE,
+        expected,
+        nullptr,
+        nullptr,
+        0);
+}
+
+/*!
+ * \brief Like futex_wait, but returns after timeout at the latest.
+ * \param word The word to wait on.
+ * \param expected The value that word is expected to hold.
+ * \param timeout The maximum duration to block for.
+**/
+inline void futex_wait_for(
+    const std::atomic<std::uint32_t>& word,
+    std::uint32_t                     expected,
+    std::chrono::nanoseconds          timeout) noexcept
+{
+    if (timeout <= std::chrono::nanoseconds::zero()) {
+        return;
+    }
+
+    const std::chrono::seconds seconds{
+        std::chrono::duration_cast<std::chrono::seconds>(timeout)};
+    ::timespec relative{};
+    relative.tv_sec  = static_cast<::time_t>(seconds.count());
+    relative.tv_nsec = static_cast<long>((timeout - seconds).count());
+    (void)::syscall(
+        SYS_futex,
+        detail::futex_address(word),
+        FUTEX_WAIT_PRIVATE,
+        expected,
+        &relative,
+        nullptr,
+        0);
+}
+
+/*!
+ * \brief Wakes one of the threads blocked on word, if any.
+ * \param word The word the threads are waiting on.
+**/
+inline void futex_wake_one(const std::atomic<std::uint32_t>& word) noexcept
+{
+    detail::futex_wake(word, 1);
+}
+
+/*!
+ * \brief Wakes all the threads blocked on word.
+ * \param word The word the threads are waiting on.
+**/
+inline void futex_wake_all(const std::atomic<std::uint32_t>& word) noexcept
+{
+    detail::futex_wake(word, INT_MAX);
+}
+#else
+namespace detail {
+/*!
+ * \brief A condition variable shared by all the words hashing to it.
+ *        Not to be used directly.
+**/
+class futex_bucket {
+public:
+    futex_bucket() : m_mutex{}, m_cv{} {}
+
+    std::mutex              m_mutex;
+    std::condition_variable m_cv;
+};
+
+inline futex_bucket& futex_bucket_for(
+    const std::atomic<std::uint32_t>& word) noexcept
+{
+    static constexpr std::uintptr_t bucket_count{64U};
+    static futex_bucket             buckets[bucket_count];
+    return buckets
+        [(reinterpret_cast<std::uintptr_t>(&word) >> 4U) % bucket_count];
+}
+} // namespace detail
+
+/*!
+ * \brief Blocks the calling thread as long as word holds expected, until it
+ *        is woken by futex_wake_one or futex_wake_all.
+ * \param word The word to wait on.
+ * \param expected The value that word is expected to hold.
+ * \note May return spuriously, callers have to check their condition in
+ *       a loop.
+**/
+inline void futex_wait(
+    const std::atomic<std::uint32_t>& word,
+    std::uint32_t                     expected)
+{
+    detail::futex_bucket&        bucket{detail::futex_bucket_for(word)};
+    std::unique_lock<std::mutex> lock{bucket.m_mutex};
+
+    if (word.load(std::memory_order_acquire) == expected) {
+        bucket.m_cv.wait(lock);
+    }
+}
+
+/*!
+ * \brief Like futex_wait, but returns after timeout at the latest.
+ * \param word The word to wait on.
+ * \param expected The value that word is expected to hold.
+ * \param timeout The maximum duration to block for.
+**/
+inline void futex_wait_for(
+    const std::atomic<std::uint32_t>& word,
+    std::uint32_t                     expected,
+    std::chrono::nanoseconds          timeout)
+{
+    detail::futex_bucket&        bucket{detail::futex_bucket_for(word)};
+    std::unique_lock<std::mutex> lock{bucket.m_mutex};
+
+    if (word.load(std::memory_order_acquire) == expected) {
+        (void)bucket.m_cv.wait_for(lock, timeout);
+    }
+}
+
+/*!
+ * \brief Wakes one of the threads blocked on word, if any.
+ * \param word The word the threads are waiting on.
+ * \note Wakes all the threads waiting on the bucket of word, as other
+ *       words may share it.
+**/
+inline void futex_wake_one(const std::atomic<std::uint32_t>& word)
+{
+    detail::futex_bucket& bucket{detail::futex_bucket_for(word)};
+    { std::lock_guard<std::mutex> lock{bucket.m_mutex}; }
+    bucket.m_cv.notify_all();
+}
+
+/*!
+ * \brief Wakes all the threads blocked on word.
+ * \param word The word the threads are waiting on.
+**/
+inline void futex_wake_all(const std::atomic<std::uint32_t>& word)
+{
+    futex_wake_one(word);
+}
+#endif
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_FUTEX_HPP
@@ -0,0 +1,574 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file hazard_pointer.hpp
+ * \brief Defines hazard pointers for safe memory reclamation in lock-free
+ *        data structures, modeled after std::hazard_pointer from C++26.
+**/
+#ifndef INCG_PL_THD_HAZARD_POINTER_HPP
+#define INCG_PL_THD_HAZARD_POINTER_HPP
+#include "../annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include <algorithm>          // std::sort, std::binary_search
+#include <atomic>             // std::atomic, std::atomic_thread_fence
+#include <ciso646>            // not
+#include <cstddef>            // std::size_t, std::nullptr_t
+#include <memory>             // std::default_delete
+#include <utility>            // std::move, std::swap
+#include <vector>             // std::vector
+
+namespace pl {
+namespace thd {
+class hazard_pointer_domain;
+
+hazard_pointer_domain& hazard_pointer_default_domain() noexcept;
+
+namespace detail {
+/*!
+ * \brief A hazard pointer slot. Slots are owned by a hazard_pointer_domain
+ *        and are reused by hazard_pointers once released.
+ *        Not to be used directly.
+**/
+class hazard_pointer_record {
+public:
+    explicit hazard_pointer_record(hazard_pointer_record* next) noexcept
+        : m_ptr{nullptr}, m_is_active{true}, m_next{next}
+    {
+    }
+
+    std::atomic<const void*> m_ptr;       //!< the protected object.
+    std::atomic<bool>        m_is_active; //!< owned by a hazard_pointer.
+    hazard_pointer_record*   m_next;      //!< immutable once published.
+};
+
+/*!
+ * \brief Type erased base of the objects retired to a hazard_pointer_domain.
+ *        Not to be used directly.
+**/
+class hazard_pointer_retired {
+public:
+    using reclaim_function = void (*)(hazard_pointer_retired*);
+
+    hazard_pointer_retired() noexcept
+        : m_object{nullptr}, m_reclaim{nullptr}, m_next_retired{nullptr}
+    {
+    }
+
+    hazard_pointer_retired(const hazard_pointer_retired&) noexcept
+        : hazard_pointer_retired{}
+    {
+    }
+
+    hazard_pointer_retired& operator=(const hazard_pointer_retired&) noexcept
+    {
+        return *this;
+    }
+
+    const void*             m_object;       //!< address compared to hazards.
+    reclaim_function        m_reclaim;      //!< deletes the object.
+    hazard_pointer_retired* m_next_retired; //!< next in the retire list.
+
+protected:
+    ~hazard_pointer_retired() = default;
+};
+} // namespace detail
+
+/*!
+ * \brief A set of hazard pointer slots and the objects retired to them.
+ *
+ * Retired objects are collected in a lock-free list. Once the list has
+ * grown to a threshold proportional to the amount of slots the retiring
+ * thread scans the slots and reclaims every object that is not protected,
+ * so that the cost of a scan is amortized over many retirements.
+ * Most code will just use the default domain.
+**/
+class hazard_pointer_domain {
+public:
+    using this_type = hazard_pointer_domain;
+
+    /*!
+     * \brief The minimum size of the retire list to trigger a scan.
+    **/
+    static constexpr std::size_t min_scan_threshold{64U};
+
+    /*!
+     * \brief Creates an empty hazard_pointer_domain.
+    **/
+    hazard_pointer_domain() noexcept
+        : m_records{nullptr},
+          m_record_count{0U},
+          m_retired{nullptr},
+          m_retired_count{0U}
+    {
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    hazard_pointer_domain(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Reclaims all the objects still retired and frees the slots.
+     * \warning No hazard_pointer of this domain may exist any longer.
+    **/
+    ~hazard_pointer_domain()
+    {
+        detail::hazard_pointer_retired* retired{
+            m_retired.exchange(nullptr, std::memory_order_acquire)};
+
+        while (retired != nullptr) {
+            detail::hazard_pointer_retired* const next{retired->m_next_retired};
+            retired->m_reclaim(retired);
+            retired = next;
+        }
+
+        detail::hazard_pointer_record* record{
+            m_records.load(std::memory_order_acquire)};
+
+        while (record != nullptr) {
+            detail::hazard_pointer_record* const next{record->m_next};
+            delete record;
+            record = next;
+        }
+    }
+
+    /*!
+     * \brief Reclaims all retired objects that are not currently protected.
+    **/
+    void reclaim() { scan(); }
+
+    /*!
+     * \brief Queries the amount of objects retired but not yet reclaimed.
+     * \return The amount of objects in the retire list.
+    **/
+    PL_NODISCARD std::size_t retired_count() const noexcept
+    {
+        return m_retired_count.load(std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Acquires a slot, reusing a released one if possible.
+     *        Not to be used directly, use make_hazard_pointer instead.
+    **/
+    PL_NODISCARD detail::hazard_pointer_record* acquire_record()
+    {
+        for (detail::hazard_pointer_record* record{
+                 m_records.load(std::memory_order_acquire)};
+             record != nullptr;
+             record = record->m_next) {
+            bool expected{false};
+
+            if ((not record->m_is_active.load(std::memory_order_relaxed))
+                and record->m_is_active.compare_exchange_strong(
+                        expected, true, std::memory_order_acquire)) {
+                return record;
+            }
+        }
+
+        detail::hazard_pointer_record* const record{
+            new detail::hazard_pointer_record{
+                m_records.load(std::memory_order_relaxed)}};
+
+        while (not m_records.compare_exchange_weak(
+            record->m_next, record, std::memory_order_release)) {
+        }
+
+        m_record_count.fetch_add(1U, std::memory_order_relaxed);
+        return record;
+    }
+
+    /*!
+     * \brief Releases a slot acquired with acquire_record.
+     *        Not to be used directly.
+    **/
+    static void release_record(PL_INOUT detail::hazard_pointer_record* record)
+        noexcept
+    {
+        record->m_ptr.store(nullptr, std::memory_order_release);
+        record->m_is_active.store(false, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Adds an object to the retire list. Scans if the retire list
+     *        has reached the threshold.
+     *        Not to be used directly, use hazard_pointer_obj_base::retire.
+    **/
+    void push_retired(PL_INOUT detail::hazard_pointer_retired* retired)
+    {
+        push_retired_list(retired, retired, 1U);
+
+        const std::size_t threshold{
+            2U * m_record_count.load(std::memory_order_relaxed)};
+        const std::size_t count{
+            m_retired_count.load(std::memory_order_relaxed)};
+
+        if ((count >= min_scan_threshold) and (count >= threshold)) {
+            scan();
+        }
+    }
+
+private:
+    void push_retired_list(
+        PL_INOUT detail::hazard_pointer_retired* first,
+        PL_INOUT detail::hazard_pointer_retired* last,
+        std::size_t                              count) noexcept
+    {
+        last->m_next_retired = m_retired.load(std::memory_order_relaxed);
+
+        while (not m_retired.compare_exchange_weak(
+            last->m_next_retired, first, std::memory_order_release)) {
+        }
+
+        m_retired_count.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /*!
+     * \brief Takes the entire retire list, reclaims the objects that are not
+     *        protected by any slot and puts the others back.
+    **/
+    void scan()
+    {
+        detail::hazard_pointer_retired* retired{
+            m_retired.exchange(nullptr, std::memory_order_acquire)};
+
+        if (retired == nullptr) {
+            return;
+        }
+
+        // pairs with the seq_cst store and load in
+        // hazard_pointer::try_protect:
+        // either the protecting thread sees the object unlinked or we see
+        // its hazard.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        std::vector<const void*> hazards{};
+        hazards.reserve(m_record_count.load(std::memory_order_relaxed));
+
+        for (detail::hazard_pointer_record* record{
+                 m_records.load(std::memory_order_acquire)};
+             record != nullptr;
+             record = record->m_next) {
+            const void* const ptr{record->m_ptr.load(std::memory_order_acquire)};
+
+            if (ptr != nullptr) {
+                hazards.push_back(ptr);
+            }
+        }
+
+        std::sort(hazards.begin(), hazards.end());
+
+        detail::hazard_pointer_retired* kept_first{nullptr};
+        detail::hazard_pointer_retired* kept_last{nullptr};
+        std::size_t                     taken{0U};
+        std::size_t                     kept{0U};
+
+        while (retired != nullptr) {
+            detail::hazard_pointer_retired* const next{retired->m_next_retired};
+            ++taken;
+
+            if (std::binary_search(
+                    hazards.begin(), hazards.end(), retired->m_object)) {
+                retired->m_next_retired = kept_first;
+                kept_first              = retired;
+
+                if (kept_last == nullptr) {
+                    kept_last = retired;
+                }
+
+                ++kept;
+            }
+            else {
+                retired->m_reclaim(retired);
+            }
+
+            retired = next;
+        }
+
+        m_retired_count.fetch_sub(taken, std::memory_order_relaxed);
+
+        if (kept_first != nullptr) {
+            push_retired_list(kept_first, kept_last, kept);
+        }
+    }
+
+    std::atomic<detail::hazard_pointer_record*>  m_records;
+    std::atomic<std::size_t>                     m_record_count;
+    std::atomic<detail::hazard_pointer_retired*> m_retired;
+    std::atomic<std::size_t>                     m_retired_count;
+};
+
+/*!
+ * \brief Returns the hazard_pointer_domain used by default.
+ * \return The default hazard_pointer_domain.
+**/
+inline hazard_pointer_domain& hazard_pointer_default_domain() noexcept
+{
+    static hazard_pointer_domain domain{};
+    return domain;
+}
+
+/*!
+ * \brief Base class of objects that can be protected by hazard pointers.
+ *        Type must derive from hazard_pointer_obj_base<Type, Deleter>.
+ *
+ * Example:
+ * \code
+ * struct node : pl::thd::hazard_pointer_obj_base<node> {
+ *     int value;
+ * };
+ * \endcode
+**/
+template <typename Type, typename Deleter = std::default_delete<Type>>
+class hazard_pointer_obj_base : private detail::hazard_pointer_retired {
+public:
+    /*!
+     * \brief Retires this object. The object will be deleted using deleter
+     *        once no hazard_pointer protects it any longer.
+     * \param deleter The deleter to delete the object with.
+     * \param domain The domain whose hazard pointers may protect the object.
+     * \warning The object must already have been unlinked from the data
+     *          structure, so that no new hazard_pointer can protect it.
+    **/
+    void retire(
+        Deleter                        deleter = Deleter{},
+        PL_INOUT hazard_pointer_domain& domain = hazard_pointer_default_domain())
+    {
+        m_deleter = std::move(deleter);
+        m_object  = static_cast<const void*>(static_cast<Type*>(this));
+        m_reclaim = &reclaim;
+        domain.push_retired(this);
+    }
+
+protected:
+    hazard_pointer_obj_base() noexcept(noexcept(Deleter{}))
+        : detail::hazard_pointer_retired{}, m_deleter{}
+    {
+    }
+
+    hazard_pointer_obj_base(const hazard_pointer_obj_base&) = default;
+
+    hazard_pointer_obj_base(hazard_pointer_obj_base&&) = default;
+
+    hazard_pointer_obj_base& operator=(const hazard_pointer_obj_base&)
+        = default;
+
+    hazard_pointer_obj_base& operator=(hazard_pointer_obj_base&&) = default;
+
+    ~hazard_pointer_obj_base() = default;
+
+private:
+    static void reclaim(detail::hazard_pointer_retired* retired)
+    {
+        hazard_pointer_obj_base* const self{
+            static_cast<hazard_pointer_obj_base*>(retired)};
+        Deleter deleter{std::move(self->m_deleter)};
+        deleter(static_cast<Type*>(self));
+    }
+
+    Deleter m_deleter; //!< set by retire.
+};
+
+/*!
+ * \brief Owns a hazard pointer slot of a hazard_pointer_domain. An object
+ *        protected by the slot is not reclaimed by the domain until the
+ *        protection is reset.
+ *        Created using make_hazard_pointer.
+ *
+ * Example:
+ * \code
+ * pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer()};
+ * node* n{hp.protect(head)}; // head is a std::atomic<node*>
+ * // n can be safely dereferenced until hp is reset or destroyed.
+ * \endcode
+**/
+class hazard_pointer {
+public:
+    using this_type = hazard_pointer;
+
+    /*!
+     * \brief Creates an empty hazard_pointer, that does not own a slot.
+    **/
+    hazard_pointer() noexcept : m_record{nullptr} {}
+
+    /*!
+     * \brief Takes ownership of the slot passed.
+     *        Not to be used directly, use make_hazard_pointer instead.
+    **/
+    explicit hazard_pointer(detail::hazard_pointer_record* record) noexcept
+        : m_record{record}
+    {
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    hazard_pointer(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Move constructor. Leaves other empty.
+    **/
+    hazard_pointer(this_type&& other) noexcept : m_record{other.m_record}
+    {
+        other.m_record = nullptr;
+    }
+
+    /*!
+     * \brief Move assignment. Releases the slot owned before, if any.
+    **/
+    this_type& operator=(this_type&& other) noexcept
+    {
+        this_type{std::move(other)}.swap(*this);
+        return *this;
+    }
+
+    /*!
+     * \brief Releases the slot owned, if any.
+    **/
+    ~hazard_pointer()
+    {
+        if (m_record != nullptr) {
+            hazard_pointer_domain::release_record(m_record);
+        }
+    }
+
+    /*!
+     * \brief Queries whether this hazard_pointer owns a slot.
+    **/
+    PL_NODISCARD bool empty() const noexcept { return m_record == nullptr; }
+
+    /*!
+     * \brief Protects the object pointed to by src.
+     * \param src The atomic pointer to load from.
+     * \return The pointer loaded, which is protected until the protection is
+     *         reset.
+    **/
+    template <typename Type>
+    PL_NODISCARD Type* protect(PL_IN const std::atomic<Type*>& src)
+    {
+        Type* ptr{src.load(std::memory_order_relaxed)};
+
+        while (not try_protect(ptr, src)) {
+        }
+
+        return ptr;
+    }
+
+    /*!
+     * \brief Tries to protect the object pointed to by ptr, which was
+     *        loaded from src.
+     * \param ptr The pointer previously loaded from src. Is updated with the
+     *        current value of src if protecting fails.
+     * \param src The atomic pointer ptr was loaded from.
+     * \return true if ptr is protected; false if src changed in the meantime.
+    **/
+    template <typename Type>
+    PL_NODISCARD bool try_protect(
+        PL_INOUT Type*& ptr,
+        PL_IN const std::atomic<Type*>& src)
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        Type* const old{ptr};
+        m_record->m_ptr.store(
+            static_cast<const void*>(old), std::memory_order_seq_cst);
+        // seq_cst, so that it can't be ordered before the store above; pairs
+        // with the seq_cst fence in hazard_pointer_domain::scan.
+        ptr = src.load(std::memory_order_seq_cst);
+
+        if (ptr != old) {
+            reset_protection();
+            return false;
+        }
+
+        return true;
+    }
+
+    /*!
+     * \brief Protects ptr without checking a source. The caller must ensure
+     *        that the object has not been retired yet.
+     * \param ptr The pointer to protect.
+    **/
+    template <typename Type>
+    void reset_protection(PL_IN const Type* ptr)
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        m_record->m_ptr.store(
+            static_cast<const void*>(ptr), std::memory_order_seq_cst);
+    }
+
+    /*!
+     * \brief Stops protecting the object protected, if any.
+    **/
+    void reset_protection(std::nullptr_t = nullptr)
+    {
+        PL_DBG_CHECK_PRE(not empty());
+        m_record->m_ptr.store(nullptr, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Swaps the slots of this and other.
+    **/
+    void swap(PL_INOUT this_type& other) noexcept
+    {
+        using std::swap;
+        swap(m_record, other.m_record);
+    }
+
+private:
+    detail::hazard_pointer_record* m_record; //!< the slot owned or nullptr.
+};
+
+/*!
+ * \brief Swaps the slots of two hazard_pointers.
+**/
+inline void swap(PL_INOUT hazard_pointer& a, PL_INOUT hazard_pointer& b) noexcept
+{
+    a.swap(b);
+}
+
+/*!
+ * \brief Creates a hazard_pointer owning a slot of the domain passed.
+ * \param domain The domain to acquire a slot from.
+ * \return The hazard_pointer.
+**/
+PL_NODISCARD inline hazard_pointer make_hazard_pointer(
+    PL_INOUT hazard_pointer_domain& domain = hazard_pointer_default_domain())
+{
+    return hazard_pointer{domain.acquire_record()};
+}
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_HAZARD_POINTER_HPP
@@ -0,0 +1,145 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file latch.hpp
+ * \brief Defines the latch class from C++20.
+**/
+#ifndef INCG_PL_THD_LATCH_HPP
+#define INCG_PL_THD_LATCH_HPP
+#include "../annotations.hpp" // PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include "futex.hpp"          // pl::thd::futex_wait, pl::thd::futex_wake_all
+#include <atomic>             // std::atomic
+#include <ciso646>            // and
+#include <cstddef>            // std::ptrdiff_t
+#include <cstdint>            // std::uint32_t, std::int32_t
+#include <limits>             // std::numeric_limits
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief A single use downward counter threads can block on until it
+ *        reaches zero.
+ *
+ * Implemented over an atomic counter. Threads that have to wait block on
+ * the counter using futex_wait, count_down only issues a wake up if threads
+ * are actually waiting.
+**/
+class latch {
+public:
+    using this_type = latch;
+
+    /*!
+     * \brief Returns the maximum value of the counter.
+    **/
+    static constexpr std::ptrdiff_t max() noexcept
+    {
+        return std::numeric_limits<std::int32_t>::max();
+    }
+
+    /*!
+     * \brief Creates a latch.
+     * \param expected The initial value of the counter.
+     * \throws pl::precondition_violation_exception if expected is not in
+     *         [0, max()] (debug mode only).
+    **/
+    explicit latch(std::ptrdiff_t expected)
+        : m_counter{static_cast<std::uint32_t>(expected)}, m_waiters{0U}
+    {
+        PL_DBG_CHECK_PRE((expected >= 0) and (expected <= max()));
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    latch(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Decrements the counter by update, unblocking the waiting
+     *        threads if it reaches zero.
+     * \param update The value to decrement the counter by.
+     * \throws pl::precondition_violation_exception if update is negative
+     *         (debug mode only).
+    **/
+    void count_down(std::ptrdiff_t update = 1)
+    {
+        PL_DBG_CHECK_PRE(update >= 0);
+        const std::uint32_t value{static_cast<std::uint32_t>(update)};
+
+        if (m_counter.fetch_sub(value) == value) {
+            if (m_waiters.load() != 0U) {
+                futex_wake_all(m_counter);
+            }
+        }
+    }
+
+    /*!
+     * \brief Checks whether the counter has reached zero.
+     * \return true if the counter is zero.
+    **/
+    PL_NODISCARD bool try_wait() const noexcept
+    {
+        return m_counter.load(std::memory_order_acquire) == 0U;
+    }
+
+    /*!
+     * \brief Blocks until the counter reaches zero.
+    **/
+    void wait() const
+    {
+        for (std::uint32_t value{m_counter.load(std::memory_order_acquire)};
+             value != 0U;
+             value = m_counter.load(std::memory_order_acquire)) {
+            m_waiters.fetch_add(1U);
+            futex_wait(m_counter, value);
+            m_waiters.fetch_sub(1U);
+        }
+    }
+
+    /*!
+     * \brief Decrements the counter by update and blocks until it reaches
+     *        zero.
+     * \param update The value to decrement the counter by.
+    **/
+    void arrive_and_wait(std::ptrdiff_t update = 1)
+    {
+        count_down(update);
+        wait();
+    }
+
+private:
+    std::atomic<std::uint32_t>         m_counter; //!< the futex word.
+    mutable std::atomic<std::uint32_t> m_waiters; //!< threads in wait.
+};
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_LATCH_HPP
@@ -0,0 +1,815 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file pipeline.hpp
+ * \brief Defines the pipeline class and the pipeline_builder class that can
+ *        be used to create multi-stage stream processing pipelines whose
+ *        stages run on their own threads and are connected by bounded
+ *        thread_safe_queues.
+**/
+#ifndef INCG_PL_THD_PIPELINE_HPP
+#define INCG_PL_THD_PIPELINE_HPP
+#include "../annotations.hpp"    // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"         // PL_CHECK_PRE
+#include "../invoke.hpp"         // pl::invoke
+#include "thread_safe_queue.hpp" // pl::thd::thread_safe_queue
+#include <atomic>                // std::atomic
+#include <ciso646>               // not, and, or
+#include <condition_variable>    // std::condition_variable
+#include <cstddef>               // std::size_t
+#include <exception>             // std::exception_ptr, std::current_exception
+#include <functional>            // std::function
+#include <map>                   // std::map
+#include <memory>                // std::shared_ptr, std::make_shared
+#include <mutex>                 // std::mutex, std::lock_guard, std::unique_lock
+#include <thread>                // std::thread
+#include <type_traits>           // std::decay_t, std::is_void
+#include <utility>               // std::move, std::declval
+#include <vector>                // std::vector
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief Options of a pipeline.
+**/
+struct pipeline_options {
+    std::size_t queue_capacity = 8U; /*!< the amount of batches each queue
+                                      *   between two stages can hold.
+                                      *   A stage whose output queue is full
+                                      *   blocks, which propagates
+                                      *   backpressure upstream.
+                                     **/
+    std::size_t batch_size = 64U;    /*!< the amount of items moved between
+                                      *   stages at once.
+                                     **/
+    bool preserve_order = false;     /*!< if true the sink receives the items
+                                      *   in the order they were pushed.
+                                      *   The sink then runs on one thread.
+                                     **/
+};
+
+template <typename Input>
+class pipeline;
+
+template <typename Input, typename Output>
+class pipeline_builder;
+
+template <typename Input>
+pipeline_builder<Input, Input> make_pipeline(
+    pipeline_options options = pipeline_options{});
+
+namespace detail {
+/*!
+ * \brief A batch of items travelling through a pipeline.
+ *        An empty batch marks the end of the stream.
+ *        Not to be used directly.
+**/
+template <typename Type>
+struct pipeline_batch {
+    std::size_t       sequence; //!< position of the batch in the input.
+    std::vector<Type> items;    //!< the items, empty for end of stream.
+};
+
+template <typename Type>
+using pipeline_queue = thread_safe_queue<pipeline_batch<Type>>;
+
+/*!
+ * \brief Starts the threads of a stage. Is passed the amount of threads
+ *        of the downstream stage and the vector to store the threads in.
+ *        Not to be used directly.
+**/
+using pipeline_launcher
+    = std::function<void(std::size_t, std::vector<std::thread>&)>;
+
+/*!
+ * \brief Pushes the given amount of end of stream markers into the input
+ *        queue of a stage. Not to be used directly.
+**/
+using pipeline_stopper = std::function<void(std::size_t)>;
+
+/*!
+ * \brief What pipeline_builder needs to know about a stage.
+ *        Not to be used directly.
+**/
+struct pipeline_stage_control {
+    pipeline_launcher launch;    //!< starts the threads of the stage.
+    pipeline_stopper  end_input; //!< ends the input of the stage.
+};
+
+/*!
+ * \brief Limits how far ahead of the sink the batches pushed into an
+ *        order preserving pipeline may get. Not to be used directly.
+ *
+ * The sink holds back batches that arrive early, so a single slow batch
+ * would otherwise let the sink collect every batch pushed after it.
+ * Instead pushing the batch with sequence s blocks until the sink has
+ * consumed batch s - size. As every batch admitted can make progress this
+ * cannot deadlock and bounds the batches held back to size.
+**/
+class pipeline_order_window {
+public:
+    explicit pipeline_order_window(std::size_t size) noexcept
+        : m_mutex{},
+          m_condition{},
+          m_next_sequence{0U},
+          m_size{size},
+          m_is_released{false}
+    {
+    }
+
+    /*!
+     * \brief Blocks until the batch with the given sequence may enter the
+     *        pipeline.
+    **/
+    void wait_for(std::size_t sequence)
+    {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        m_condition.wait(lock, [this, sequence] {
+            return m_is_released or (sequence < m_next_sequence + m_size);
+        });
+    }
+
+    /*!
+     * \brief Called by the sink once it consumed the next batch.
+    **/
+    void advance()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            (void)lock;
+            ++m_next_sequence;
+        }
+
+        m_condition.notify_all();
+    }
+
+    /*!
+     * \brief Stops limiting, called once batches are dropped due to an
+     *        exception, as the sink will not see them.
+    **/
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_mutex};
+            (void)lock;
+            m_is_released = true;
+        }
+
+        m_condition.notify_all();
+    }
+
+private:
+    std::mutex              m_mutex;
+    std::condition_variable m_condition;
+    std::size_t m_next_sequence; //!< the next batch the sink consumes.
+    std::size_t m_size;          //!< the batches allowed ahead of it.
+    bool        m_is_released;
+};
+
+/*!
+ * \brief Stores the first exception thrown by any stage of a pipeline.
+ *        Once an exception has been stored the remaining items are dropped.
+ *        Not to be used directly.
+**/
+class pipeline_error {
+public:
+    pipeline_error() noexcept
+        : m_failed{false}, m_mutex{}, m_exception{}, m_window{}
+    {
+    }
+
+    /*!
+     * \brief Sets the order window to release once an exception occurs.
+     *        Must be called before the threads of the pipeline are started.
+    **/
+    void set_order_window(std::shared_ptr<pipeline_order_window> window)
+    {
+        m_window = std::move(window);
+    }
+
+    PL_NODISCARD bool failed() const noexcept
+    {
+        return m_failed.load(std::memory_order_acquire);
+    }
+
+    void set(std::exception_ptr exception)
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        (void)lock;
+
+        if (not m_exception) {
+            m_exception = std::move(exception);
+            m_failed.store(true, std::memory_order_release);
+
+            if (m_window != nullptr) {
+                m_window->release();
+            }
+        }
+    }
+
+    void rethrow_if_failed()
+    {
+        std::lock_guard<std::mutex> lock{m_mutex};
+        (void)lock;
+
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::atomic<bool>                      m_failed;
+    std::mutex                             m_mutex;
+    std::exception_ptr                     m_exception;
+    std::shared_ptr<pipeline_order_window> m_window;
+};
+
+/*!
+ * \brief Creates the output batch of a stage by invoking callable with
+ *        every item of the input batch. Drops the batch if an exception
+ *        occurs or has occurred in another stage.
+ *        Not to be used directly.
+**/
+template <typename Output, typename Input, typename Callable>
+inline pipeline_batch<Output> pipeline_transform(
+    PL_INOUT pipeline_batch<Input>& batch,
+    PL_INOUT Callable& callable,
+    PL_INOUT pipeline_error& error)
+{
+    pipeline_batch<Output> result{batch.sequence, std::vector<Output>{}};
+
+    if (error.failed()) {
+        return result;
+    }
+
+    try {
+        result.items.reserve(batch.items.size());
+
+        for (Input& item : batch.items) {
+            result.items.push_back(::pl::invoke(callable, std::move(item)));
+        }
+    }
+    catch (...) {
+        error.set(std::current_exception());
+        result.items.clear();
+    }
+
+    return result;
+}
+
+/*!
+ * \brief The loop run by the threads of a stage.
+ *        Not to be used directly.
+ *
+ * The last thread of the stage to see the end of the stream forwards one
+ * end of stream marker to every thread of the downstream stage.
+**/
+template <typename Input, typename Output, typename Callable>
+inline void run_pipeline_stage(
+    PL_INOUT pipeline_queue<Input>& in,
+    PL_INOUT pipeline_queue<Output>& out,
+    Callable                          callable,
+    PL_INOUT std::atomic<std::size_t>& threads_left,
+    std::size_t                        downstream_threads,
+    PL_INOUT pipeline_error& error)
+{
+    for (;;) {
+        pipeline_batch<Input> batch{in.pop()};
+
+        if (batch.items.empty()) {
+            break;
+        }
+
+        pipeline_batch<Output> result{
+            pipeline_transform<Output>(batch, callable, error)};
+
+        if (not result.items.empty()) {
+            out.push(std::move(result));
+        }
+    }
+
+    if (threads_left.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+        for (std::size_t i{0U}; i < downstream_threads; ++i) {
+            out.push(pipeline_batch<Output>{0U, std::vector<Output>{}});
+        }
+    }
+}
+
+/*!
+ * \brief Passes every item of the batch to the sink.
+ *        Not to be used directly.
+**/
+template <typename Input, typename Callable>
+inline void pipeline_consume(
+    PL_INOUT pipeline_batch<Input>& batch,
+    PL_INOUT Callable& callable,
+    PL_INOUT pipeline_error& error)
+{
+    if (error.failed()) {
+        return;
+    }
+
+    try {
+        for (Input& item : batch.items) {
+            ::pl::invoke(callable, std::move(item));
+        }
+    }
+    catch (...) {
+        error.set(std::current_exception());
+    }
+}
+
+/*!
+ * \brief The loop run by the threads of the sink.
+ *        Not to be used directly.
+ *
+ * If window is not nullptr the order is preserved: batches that arrive
+ * early are held back until all of the batches before them have been
+ * consumed.
+**/
+template <typename Input, typename Callable>
+inline void run_pipeline_sink(
+    PL_INOUT pipeline_queue<Input>& in,
+    Callable                         callable,
+    pipeline_order_window*           window,
+    PL_INOUT pipeline_error& error)
+{
+    std::map<std::size_t, pipeline_batch<Input>> early{};
+    std::size_t                                  next_sequence{0U};
+
+    for (;;) {
+        pipeline_batch<Input> batch{in.pop()};
+
+        if (batch.items.empty()) {
+            break;
+        }
+
+        if (window == nullptr) {
+            pipeline_consume(batch, callable, error);
+            continue;
+        }
+
+        early.emplace(batch.sequence, std::move(batch));
+
+        for (auto it = early.find(next_sequence); it != early.end();
+             it      = early.find(next_sequence)) {
+            pipeline_consume(it->second, callable, error);
+            early.erase(it);
+            ++next_sequence;
+            window->advance();
+        }
+    }
+}
+} // namespace detail
+
+/*!
+ * \brief A running pipeline. Items pushed are collected into batches which
+ *        flow through the stages of the pipeline and finally into its sink.
+ *        Created using make_pipeline and pipeline_builder.
+ *
+ * Every stage runs on its own threads, consecutive stages are connected by
+ * bounded queues. If a stage can't keep up the queue in front of it fills up
+ * and the stages before it, and eventually push, block until it catches up.
+**/
+template <typename Input>
+class pipeline {
+public:
+    using this_type  = pipeline;
+    using value_type = Input;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    pipeline(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Move constructor.
+    **/
+    pipeline(this_type&&) = default;
+
+    /*!
+     * \brief This type is not move assignable.
+    **/
+    this_type& operator=(this_type&&) = delete;
+
+    /*!
+     * \brief Finishes the pipeline if finish has not been called.
+     *        Exceptions thrown by the stages are discarded.
+     * \warning Blocks until all the items pushed have been processed.
+    **/
+    ~pipeline()
+    {
+        if ((m_head != nullptr) and (not m_is_finished)) {
+            try {
+                finish();
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    /*!
+     * \brief Pushes an item into the pipeline.
+     * \param value The item to push.
+     * \note Blocks if the pipeline is saturated.
+     * \warning Must not be called after finish.
+    **/
+    void push(Input value)
+    {
+        m_batch.push_back(std::move(value));
+
+        if (m_batch.size() >= m_batch_size) {
+            flush();
+        }
+    }
+
+    /*!
+     * \brief Hands the items pushed that have not yet formed a complete batch
+     *        to the first stage.
+    **/
+    void flush()
+    {
+        if (m_batch.empty()) {
+            return;
+        }
+
+        if (m_window != nullptr) {
+            m_window->wait_for(m_sequence);
+        }
+
+        m_head->push(
+            detail::pipeline_batch<Input>{m_sequence++, std::move(m_batch)});
+        m_batch = std::vector<Input>{};
+        m_batch.reserve(m_batch_size);
+    }
+
+    /*!
+     * \brief Flushes the pipeline, signals the end of the input and waits
+     *        until every item has been processed.
+     * \throws Rethrows the first exception thrown by any of the stages.
+     *         Items following that exception have been dropped.
+    **/
+    void finish()
+    {
+        if (m_is_finished) {
+            return;
+        }
+
+        flush();
+
+        for (std::size_t i{0U}; i < m_head_threads; ++i) {
+            m_head->push(
+                detail::pipeline_batch<Input>{0U, std::vector<Input>{}});
+        }
+
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+
+        m_is_finished = true;
+        m_error->rethrow_if_failed();
+    }
+
+private:
+    template <typename, typename>
+    friend class pipeline_builder;
+
+    pipeline(
+        std::shared_ptr<detail::pipeline_queue<Input>> head,
+        std::size_t                                    head_threads,
+        std::vector<std::thread>                       threads,
+        std::shared_ptr<detail::pipeline_error>        error,
+        std::shared_ptr<detail::pipeline_order_window> window,
+        std::size_t                                    batch_size)
+        : m_head{std::move(head)},
+          m_head_threads{head_threads},
+          m_threads{std::move(threads)},
+          m_error{std::move(error)},
+          m_window{std::move(window)},
+          m_batch_size{batch_size},
+          m_batch{},
+          m_sequence{0U},
+          m_is_finished{false}
+    {
+        m_batch.reserve(m_batch_size);
+    }
+
+    std::shared_ptr<detail::pipeline_queue<Input>> m_head; //!< first queue
+    std::size_t m_head_threads;         //!< threads of the first stage.
+    std::vector<std::thread> m_threads; //!< threads of all stages.
+    std::shared_ptr<detail::pipeline_error> m_error;
+    std::shared_ptr<detail::pipeline_order_window> m_window; //!< or nullptr
+    std::size_t        m_batch_size;
+    std::vector<Input> m_batch;    //!< the batch being collected.
+    std::size_t        m_sequence; //!< the sequence of the next batch.
+    bool               m_is_finished;
+};
+
+/*!
+ * \brief Builds a pipeline whose input is of type Input and whose last stage
+ *        so far produces items of type Output.
+ *        Created using make_pipeline.
+ *
+ * Example:
+ * \code
+ * pl::thd::pipeline<std::string> p{
+ *     pl::thd::make_pipeline<std::string>()
+ *         .stage(4, [](std::string s) { return parse(s); })
+ *         .stage(2, [](record r) { return transform(r); })
+ *         .sink([&out](record r) { out.write(r); })};
+ *
+ * for (std::string& line : lines) { p.push(std::move(line)); }
+ *
+ * p.finish();
+ * \endcode
+**/
+template <typename Input, typename Output>
+class pipeline_builder {
+public:
+    using this_type = pipeline_builder;
+
+    /*!
+     * \brief Appends a stage.
+     * \param threads The amount of threads to run the stage on. Must not be 0.
+     * \param callable Invoked with every item of type Output, returns the item
+     *        passed to the next stage. Every thread uses its own copy.
+     * \return The builder for the extended pipeline.
+    **/
+    template <typename Callable>
+    PL_NODISCARD auto stage(std::size_t threads, Callable callable) &&
+    {
+        using result_type = std::decay_t<decltype(
+            ::pl::invoke(std::declval<Callable&>(), std::declval<Output>()))>;
+        static_assert(
+            not std::is_void<result_type>::value,
+            "A stage must return a value, use sink for the last stage");
+        PL_CHECK_PRE(threads != 0U);
+
+        auto in    = m_tail;
+        auto out   = make_queue<result_type>();
+        auto error = m_error;
+        detail::pipeline_stage_control control{};
+        control.launch =
+            [in, out, error, threads, callable](
+                std::size_t downstream_threads,
+                std::vector<std::thread>& thds) {
+                const auto threads_left
+                    = std::make_shared<std::atomic<std::size_t>>(threads);
+
+                for (std::size_t i{0U}; i < threads; ++i) {
+                    thds.emplace_back([=] {
+                        detail::run_pipeline_stage(
+                            *in,
+                            *out,
+                            callable,
+                            *threads_left,
+                            downstream_threads,
+                            *error);
+                    });
+                }
+            };
+        control.end_input = [in](std::size_t count) {
+            for (std::size_t i{0U}; i < count; ++i) {
+                in->push(detail::pipeline_batch<Output>{0U, std::vector<Output>{}});
+            }
+        };
+        m_stages.push_back(std::move(control));
+        m_threads.push_back(threads);
+
+        return pipeline_builder<Input, result_type>{m_options,
+                                                    std::move(m_error),
+                                                    std::move(m_head),
+                                                    std::move(out),
+                                                    std::move(m_threads),
+                                                    std::move(m_stages)};
+    }
+
+    /*!
+     * \brief Appends a stage running on a single thread.
+     * \param callable Invoked with every item of type Output, returns the item
+     *        passed to the next stage.
+     * \return The builder for the extended pipeline.
+    **/
+    template <typename Callable>
+    PL_NODISCARD auto stage(Callable callable) &&
+    {
+        return std::move(*this).stage(1U, std::move(callable));
+    }
+
+    /*!
+     * \brief Appends the sink, which consumes the items, and starts the
+     *        pipeline.
+     * \param threads The amount of threads to run the sink on. Must not be 0.
+     *        Ignored if preserve_order is set, the sink then runs on a single
+     *        thread.
+     * \param callable Invoked with every item of type Output.
+     *        Every thread uses its own copy.
+     * \return The running pipeline.
+    **/
+    template <typename Callable>
+    PL_NODISCARD pipeline<Input> sink(std::size_t threads, Callable callable) &&
+    {
+        PL_CHECK_PRE(threads != 0U);
+
+        if (m_options.preserve_order) {
+            threads = 1U;
+        }
+
+        m_threads.push_back(threads);
+
+        std::shared_ptr<detail::pipeline_order_window> window{};
+
+        if (m_options.preserve_order) {
+            // as many batches as the queues and threads can hold anyway.
+            std::size_t window_size{
+                m_options.queue_capacity * m_threads.size()};
+
+            for (std::size_t stage_threads : m_threads) {
+                window_size += stage_threads;
+            }
+
+            window
+                = std::make_shared<detail::pipeline_order_window>(window_size);
+            m_error->set_order_window(window);
+        }
+
+        auto       in{m_tail};
+        auto       error{m_error};
+        const auto sink_window{window.get()};
+
+        std::vector<std::thread> thds{};
+        // the stage being started and the threads started before it.
+        std::size_t stage{m_stages.size()};
+        std::size_t started{0U};
+
+        // started from the sink backwards, so that if starting a thread
+        // fails every stage after the failing one is fully running and
+        // passes on the end of stream markers.
+        try {
+            for (std::size_t i{0U}; i < threads; ++i) {
+                thds.emplace_back([in, callable, sink_window, error] {
+                    detail::run_pipeline_sink(
+                        *in, callable, sink_window, *error);
+                });
+                ++started;
+            }
+
+            while (stage != 0U) {
+                --stage;
+                started = thds.size();
+                m_stages[stage].launch(m_threads[stage + 1U], thds);
+            }
+        }
+        catch (...) {
+            // every thread started waits for its first batch.
+            if (stage == m_stages.size()) {
+                end_input_of_sink(started);
+            }
+            else {
+                m_stages[stage].end_input(thds.size() - started);
+                end_input_of(stage + 1U);
+            }
+
+            for (std::thread& thread : thds) {
+                thread.join();
+            }
+
+            throw;
+        }
+
+        return pipeline<Input>{std::move(m_head),
+                               m_threads.front(),
+                               std::move(thds),
+                               std::move(m_error),
+                               std::move(window),
+                               m_options.batch_size};
+    }
+
+    /*!
+     * \brief Appends the sink running on a single thread and starts the
+     *        pipeline.
+     * \param callable Invoked with every item of type Output.
+     * \return The running pipeline.
+    **/
+    template <typename Callable>
+    PL_NODISCARD pipeline<Input> sink(Callable callable) &&
+    {
+        return std::move(*this).sink(1U, std::move(callable));
+    }
+
+private:
+    template <typename, typename>
+    friend class pipeline_builder;
+
+    template <typename Ty>
+    friend pipeline_builder<Ty, Ty> make_pipeline(pipeline_options options);
+
+    pipeline_builder(
+        pipeline_options                                options,
+        std::shared_ptr<detail::pipeline_error>         error,
+        std::shared_ptr<detail::pipeline_queue<Input>>  head,
+        std::shared_ptr<detail::pipeline_queue<Output>> tail,
+        std::vector<std::size_t>                        threads,
+        std::vector<detail::pipeline_stage_control>     stages)
+        : m_options{options},
+          m_error{std::move(error)},
+          m_head{std::move(head)},
+          m_tail{std::move(tail)},
+          m_threads{std::move(threads)},
+          m_stages{std::move(stages)}
+    {
+    }
+
+    /*!
+     * \brief Ends the input of the fully started stage with the given
+     *        index, the stages after it follow once it is done.
+    **/
+    void end_input_of(std::size_t stage)
+    {
+        if (stage == m_stages.size()) {
+            end_input_of_sink(m_threads[stage]);
+        }
+        else {
+            m_stages[stage].end_input(m_threads[stage]);
+        }
+    }
+
+    /*!
+     * \brief Pushes count end of stream markers into the input of the sink.
+    **/
+    void end_input_of_sink(std::size_t count)
+    {
+        for (std::size_t i{0U}; i < count; ++i) {
+            m_tail->push(
+                detail::pipeline_batch<Output>{0U, std::vector<Output>{}});
+        }
+    }
+
+    template <typename Ty>
+    std::shared_ptr<detail::pipeline_queue<Ty>> make_queue() const
+    {
+        return std::make_shared<detail::pipeline_queue<Ty>>(
+            m_options.queue_capacity);
+    }
+
+    pipeline_options                                m_options;
+    std::shared_ptr<detail::pipeline_error>         m_error;
+    std::shared_ptr<detail::pipeline_queue<Input>>  m_head;
+    std::shared_ptr<detail::pipeline_queue<Output>> m_tail;
+    std::vector<std::size_t> m_threads; //!< the threads of every stage.
+    std::vector<detail::pipeline_stage_control> m_stages; //!< one per stage.
+};
+
+/*!
+ * \brief Starts building a pipeline.
+ * \param options The options of the pipeline.
+ * \return A pipeline_builder to append the stages to.
+**/
+template <typename Input>
+inline pipeline_builder<Input, Input> make_pipeline(pipeline_options options)
+{
+    PL_CHECK_PRE(options.queue_capacity != 0U);
+    PL_CHECK_PRE(options.batch_size != 0U);
+
+    auto head = std::make_shared<detail::pipeline_queue<Input>>(
+        options.queue_capacity);
+    return pipeline_builder<Input, Input>{
+        options,
+        std::make_shared<detail::pipeline_error>(),
+        head,
+        head,
+        std::vector<std::size_t>{},
+        std::vector<detail::pipeline_stage_control>{}};
+}
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_PIPELINE_HPP
@@ -0,0 +1,558 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file task.hpp
+ * \brief Defines the task coroutine type and the sync_wait function template
+ *        that can be used to block until a task has completed.
+ * \note Only available if the compiler supports C++20 coroutines.
+**/
+#ifndef INCG_PL_THD_TASK_HPP
+#define INCG_PL_THD_TASK_HPP
+#ifdef __cpp_impl_coroutine
+#include "../annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include <ciso646>            // not
+#include <condition_variable> // std::condition_variable
+#include <coroutine>          // std::coroutine_handle, std::suspend_always
+#include <exception>          // std::exception_ptr, std::rethrow_exception
+#include <memory>             // std::addressof
+#include <mutex>              // std::mutex, std::unique_lock
+#include <type_traits>        // std::remove_reference_t
+#include <utility>            // std::move, std::exchange, std::forward
+#include <variant>            // std::variant, std::monostate, std::get
+
+namespace pl {
+namespace thd {
+template <typename Type = void>
+class task;
+
+namespace detail {
+/*!
+ * \brief Base class of the promise types of task. Stores the continuation,
+ *        that is the coroutine awaiting the task, which is resumed using
+ *        symmetric transfer as soon as the task has completed.
+ *        Not to be used directly.
+**/
+class task_promise_base {
+public:
+    /*!
+     * \brief Awaiter used at the final suspend point of a task.
+     *        Transfers control to the continuation without growing the stack.
+    **/
+    class final_awaiter {
+    public:
+        PL_NODISCARD bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        PL_NODISCARD std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<Promise> handle) noexcept
+        {
+            return handle.promise().m_continuation;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    /*!
+     * \brief Creates a task_promise_base without a continuation.
+    **/
+    task_promise_base() noexcept : m_continuation{std::noop_coroutine()} {}
+
+    /*!
+     * \brief Tasks are lazy, they start running when they are awaited.
+    **/
+    PL_NODISCARD std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    PL_NODISCARD final_awaiter final_suspend() const noexcept { return {}; }
+
+    /*!
+     * \brief Sets the coroutine to resume once the task has completed.
+     * \param continuation The coroutine to resume.
+    **/
+    void set_continuation(std::coroutine_handle<> continuation) noexcept
+    {
+        m_continuation = continuation;
+    }
+
+private:
+    std::coroutine_handle<> m_continuation; //!< resumed on completion.
+};
+
+/*!
+ * \brief Promise type of task<Type>. Stores the value returned by the
+ *        coroutine or the exception that escaped it.
+ *        Not to be used directly.
+**/
+template <typename Type>
+class task_promise final : public task_promise_base {
+public:
+    task_promise() noexcept : task_promise_base{}, m_result{} {}
+
+    task<Type> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        m_result.template emplace<2>(std::current_exception());
+    }
+
+    template <typename Value>
+    void return_value(PL_IN Value&& value)
+    {
+        m_result.template emplace<1>(std::forward<Value>(value));
+    }
+
+    PL_NODISCARD Type& result() &
+    {
+        rethrow_if_exception();
+        return std::get<1>(m_result);
+    }
+
+    PL_NODISCARD Type&& result() &&
+    {
+        rethrow_if_exception();
+        return std::move(std::get<1>(m_result));
+    }
+
+private:
+    void rethrow_if_exception()
+    {
+        if (m_result.index() == 2U) {
+            std::rethrow_exception(std::get<2>(m_result));
+        }
+    }
+
+    std::variant<std::monostate, Type, std::exception_ptr> m_result;
+};
+
+/*!
+ * \brief Promise type of task<Type&>. Stores a pointer to the object
+ *        referred to by the reference returned by the coroutine.
+ *        Not to be used directly.
+**/
+template <typename Type>
+class task_promise<Type&> final : public task_promise_base {
+public:
+    task_promise() noexcept : task_promise_base{}, m_result{} {}
+
+    task<Type&> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        m_result.template emplace<2>(std::current_exception());
+    }
+
+    void return_value(PL_IN Type& value) noexcept
+    {
+        m_result.template emplace<1>(std::addressof(value));
+    }
+
+    PL_NODISCARD Type& result()
+    {
+        if (m_result.index() == 2U) {
+            std::rethrow_exception(std::get<2>(m_result));
+        }
+
+        return *std::get<1>(m_result);
+    }
+
+private:
+    std::variant<std::monostate, Type*, std::exception_ptr> m_result;
+};
+
+/*!
+ * \brief Promise type of task<void>.
+ *        Not to be used directly.
+**/
+template <>
+class task_promise<void> final : public task_promise_base {
+public:
+    task_promise() noexcept : task_promise_base{}, m_exception{} {}
+
+    task<void> get_return_object() noexcept;
+
+    void unhandled_exception() noexcept
+    {
+        m_exception = std::current_exception();
+    }
+
+    void return_void() const noexcept {}
+
+    void result()
+    {
+        if (m_exception) {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::exception_ptr m_exception;
+};
+} // namespace detail
+
+/*!
+ * \brief A lazily started coroutine that produces a value of type Type
+ *        (or nothing if Type is void) or an exception.
+ *
+ * The coroutine starts running when the task is awaited using co_await
+ * and resumes the awaiting coroutine through symmetric transfer once it
+ * completes, so chains of tasks do not grow the stack. Apart from the
+ * coroutine frame itself no memory is allocated.
+ * A task owns its coroutine frame and is move-only.
+ * Use thread_pool::schedule to move execution onto a thread_pool worker.
+**/
+template <typename Type>
+class task {
+public:
+    using this_type    = task;
+    using value_type   = Type;
+    using promise_type = detail::task_promise<Type>;
+    using handle_type  = std::coroutine_handle<promise_type>;
+
+    /*!
+     * \brief Creates a task that does not refer to a coroutine.
+    **/
+    task() noexcept : m_handle{} {}
+
+    /*!
+     * \brief Creates a task taking ownership of the coroutine frame passed.
+     * \param handle The coroutine to take ownership of.
+    **/
+    explicit task(handle_type handle) noexcept : m_handle{handle} {}
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    task(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Move constructor. Leaves other without a coroutine.
+    **/
+    task(this_type&& other) noexcept
+        : m_handle{std::exchange(other.m_handle, nullptr)}
+    {
+    }
+
+    /*!
+     * \brief Move assignment operator. Destroys the coroutine owned before.
+    **/
+    this_type& operator=(this_type&& other) noexcept
+    {
+        if (this != std::addressof(other)) {
+            destroy();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    /*!
+     * \brief Destroys the coroutine frame owned, if any.
+    **/
+    ~task() { destroy(); }
+
+    /*!
+     * \brief Queries whether the task has completed.
+     * \return true if the coroutine has run to completion or there is no
+     *         coroutine; false otherwise.
+    **/
+    PL_NODISCARD bool is_ready() const noexcept
+    {
+        return not m_handle or m_handle.done();
+    }
+
+    /*!
+     * \brief Awaits the task.
+     * \return An awaitable that yields an lvalue reference to the result of
+     *         the task, or rethrows the exception that escaped the task.
+    **/
+    auto operator co_await() const& noexcept
+    {
+        class awaiter : public awaiter_base {
+        public:
+            using awaiter_base::awaiter_base;
+
+            decltype(auto) await_resume()
+            {
+                return this->m_handle.promise().result();
+            }
+        };
+
+        return awaiter{m_handle};
+    }
+
+    /*!
+     * \brief Awaits the task.
+     * \return An awaitable that yields the result of the task as an rvalue,
+     *         or rethrows the exception that escaped the task.
+    **/
+    auto operator co_await() const&& noexcept
+    {
+        class awaiter : public awaiter_base {
+        public:
+            using awaiter_base::awaiter_base;
+
+            decltype(auto) await_resume()
+            {
+                return std::move(this->m_handle.promise()).result();
+            }
+        };
+
+        return awaiter{m_handle};
+    }
+
+    /*!
+     * \brief Awaits the completion of the task without fetching its result.
+     * \return An awaitable that completes when the task has completed.
+     * \note Never throws the exception stored in the task.
+    **/
+    PL_NODISCARD auto when_ready() const noexcept
+    {
+        class awaiter : public awaiter_base {
+        public:
+            using awaiter_base::awaiter_base;
+
+            void await_resume() const noexcept {}
+        };
+
+        return awaiter{m_handle};
+    }
+
+    /*!
+     * \brief Fetches the result of a completed task.
+     * \return The result of the task.
+     * \warning The task must have completed.
+     * \throws Rethrows the exception that escaped the coroutine, if any.
+    **/
+    decltype(auto) result() &&
+    {
+        PL_DBG_CHECK_PRE(m_handle and m_handle.done());
+        return std::move(m_handle.promise()).result();
+    }
+
+private:
+    /*!
+     * \brief Base of the awaiters. Starts the coroutine when awaited
+     *        and hands control to it through symmetric transfer.
+    **/
+    class awaiter_base {
+    public:
+        explicit awaiter_base(handle_type handle) noexcept : m_handle{handle}
+        {
+        }
+
+        PL_NODISCARD bool await_ready() const noexcept
+        {
+            return not m_handle or m_handle.done();
+        }
+
+        PL_NODISCARD std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<> awaiting) noexcept
+        {
+            m_handle.promise().set_continuation(awaiting);
+            return m_handle;
+        }
+
+    protected:
+        handle_type m_handle;
+    };
+
+    void destroy() noexcept
+    {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    handle_type m_handle; //!< The coroutine owned.
+};
+
+namespace detail {
+template <typename Type>
+inline task<Type> task_promise<Type>::get_return_object() noexcept
+{
+    return task<Type>{std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+template <typename Type>
+inline task<Type&> task_promise<Type&>::get_return_object() noexcept
+{
+    return task<Type&>{
+        std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+inline task<void> task_promise<void>::get_return_object() noexcept
+{
+    return task<void>{
+        std::coroutine_handle<task_promise>::from_promise(*this)};
+}
+
+/*!
+ * \brief Eagerly started coroutine used by sync_wait to run a task and
+ *        signal an event once the task has completed.
+ *        Not to be used directly.
+**/
+class sync_wait_task {
+public:
+    /*!
+     * \brief Event that sync_wait blocks on.
+    **/
+    class event {
+    public:
+        event() noexcept : m_mutex{}, m_cv{}, m_is_set{false} {}
+
+        void set()
+        {
+            // notify while holding the lock, the waiting thread destroys
+            // the event as soon as it observes m_is_set.
+            std::lock_guard<std::mutex> lock{m_mutex};
+            (void)lock;
+            m_is_set = true;
+            m_cv.notify_all();
+        }
+
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock{m_mutex};
+            m_cv.wait(lock, [this] { return m_is_set; });
+        }
+
+    private:
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        bool                    m_is_set;
+    };
+
+    class promise_type {
+    public:
+        promise_type() noexcept : m_event{nullptr} {}
+
+        sync_wait_task get_return_object() noexcept
+        {
+            return sync_wait_task{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        PL_NODISCARD std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        PL_NODISCARD auto final_suspend() const noexcept
+        {
+            class awaiter {
+            public:
+                PL_NODISCARD bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(
+                    std::coroutine_handle<promise_type> handle) const noexcept
+                {
+                    handle.promise().m_event->set();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            return awaiter{};
+        }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+
+        void start(PL_INOUT event& ev)
+        {
+            m_event = std::addressof(ev);
+            std::coroutine_handle<promise_type>::from_promise(*this).resume();
+        }
+
+    private:
+        event* m_event;
+    };
+
+    explicit sync_wait_task(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle{handle}
+    {
+    }
+
+    sync_wait_task(const sync_wait_task&) = delete;
+
+    sync_wait_task& operator=(const sync_wait_task&) = delete;
+
+    ~sync_wait_task() { m_handle.destroy(); }
+
+    void run()
+    {
+        event ev{};
+        m_handle.promise().start(ev);
+        ev.wait();
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <typename Type>
+inline sync_wait_task make_sync_wait_task(PL_IN const task<Type>& t)
+{
+    co_await t.when_ready();
+}
+} // namespace detail
+
+/*!
+ * \brief Runs the task passed and blocks the calling thread until the task
+ *        has completed.
+ * \param t The task to run.
+ * \return The result of the task.
+ * \throws Rethrows the exception that escaped the task, if any.
+ *
+ * Allows the result of a coroutine to be fetched from code that is not
+ * itself a coroutine, such as main.
+**/
+template <typename Type>
+inline Type sync_wait(task<Type> t)
+{
+    detail::make_sync_wait_task(t).run();
+    return std::move(t).result();
+}
+} // namespace thd
+} // namespace pl
+#endif // __cpp_impl_coroutine
+#endif // INCG_PL_THD_TASK_HPP
@@ -34,12 +34,14 @@
 #include "../annotations.hpp"  // PL_IN, PL_NODISCARD
 #include "../apply.hpp"        // pl::apply
 #include "../byte.hpp"         // pl::byte
-#include <algorithm>           // std::for_each
+#include "../object_pool.hpp"  // pl::object_pool_allocator
+#include <algorithm>           // std::for_each, std::remove
 #include <ciso646>             // not, or
 #include <condition_variable>  // std::condition_variable
 #include <cstddef>             // std::size_t
 #include <cstdint>             // std::uint8_t
 #include <future>              // std::future, std::promise
+#include <limits>              // std::numeric_limits
 #include <memory>  // std::shared_ptr, std::unique_ptr, std::addressof
 #include <mutex>   // std::mutex
 #include <new>     // new
@@ -48,9 +50,33 @@
 #include <tuple>   // std::make_tuple
 #include <utility> // std::move
 #include <vector>  // std::vector
+#ifdef __cpp_impl_coroutine
+#include <coroutine> // std::coroutine_handle
+#endif               // __cpp_impl_coroutine
 
 namespace pl {
 namespace thd {
+namespace detail {
+/*!
+ * \brief Holds the constants of thread_pool. Is a class template, as
+ *        before C++17 only the out of class definitions of static data
+ *        members of templates may appear in every translation unit.
+ *        Not to be used directly.
+**/
+template <typename = void>
+struct thread_pool_constants {
+    /*!
+     * \brief Value returned by worker_index if the calling thread is not one
+     *        of the threads managed by the thread_pool.
+    **/
+    static constexpr std::size_t no_worker{
+        std::numeric_limits<std::size_t>::max()};
+};
+
+template <typename Ty>
+constexpr std::size_t thread_pool_constants<Ty>::no_worker;
+} // namespace detail
+
 /*!
  * \brief A thread pool. Can be created with a count of threads. Will manage
  *        that many threads. Tasks can be added with a priority. The threads
@@ -58,12 +84,65 @@ namespace thd {
  *        threads and the count of tasks still waiting to be executed can be
  *        queried.
 **/
-class thread_pool {
+class thread_pool : public detail::thread_pool_constants<> {
 private:
     class executor_base;
 
 public:
     using this_type = thread_pool;
+    using detail::thread_pool_constants<>::no_worker;
+
+    /*!
+     * \brief Base class for storage whose lifetime is bound to a thread_pool,
+     *        such as worker_local. Registers itself with the thread_pool when
+     *        constructed. When the thread_pool is destroyed it calls
+     *        on_pool_destroyed on every storage still registered, after all of
+     *        its threads have been joined.
+     * \warning Must not be destroyed concurrently with the thread_pool.
+    **/
+    class storage_base {
+    public:
+        /*!
+         * \brief Registers this storage with the thread_pool passed.
+         * \param pool The thread_pool to bind this storage to.
+        **/
+        explicit storage_base(PL_INOUT thread_pool& pool);
+
+        /*!
+         * \brief This type is non-copyable.
+        **/
+        storage_base(const storage_base&) = delete;
+
+        /*!
+         * \brief This type is non-copyable.
+        **/
+        storage_base& operator=(const storage_base&) = delete;
+
+        /*!
+         * \brief Unregisters this storage from its thread_pool, if that
+         *        thread_pool still exists.
+        **/
+        virtual ~storage_base();
+
+        /*!
+         * \brief Returns the thread_pool this storage is bound to.
+         * \return The thread_pool or nullptr if it has been destroyed.
+        **/
+        PL_NODISCARD thread_pool* pool() const noexcept;
+
+    protected:
+        /*!
+         * \brief Called by the thread_pool's destructor. Implementations
+         *        release the resources tied to the threads of the
+         *        thread_pool.
+        **/
+        virtual void on_pool_destroyed() noexcept = 0;
+
+    private:
+        friend class thread_pool;
+
+        thread_pool* m_pool; //!< The thread_pool or nullptr.
+    };
 
     /*!
      * \brief Compares two executor_base's priorities.
@@ -171,13 +250,14 @@ public:
         // return type for the Executor template
         using ret = decltype(invoker());
 
+        auto t = std::allocate_shared<executor<decltype(invoker), ret>>(
+            m_task_allocator, std::move(invoker), prio);
+        auto fut = t->result().get_future();
+
         // lock the mutex, shared data is going to be accessed
         std::unique_lock<std::mutex> lock{m_mutex};
-        auto t = std::make_shared<executor<decltype(invoker), ret>>(
-            std::move(invoker), prio);
 
-        m_tasks_shared.push(t); // add the task to the queue.
-        auto fut = t->result().get_future();
+        m_tasks_shared.push(std::move(t)); // add the task to the queue.
         lock.unlock();
         m_cv.notify_one(); // wake one thread
         return fut;
@@ -199,6 +279,69 @@ public:
     **/
     PL_NODISCARD std::size_t tasks_waiting_for_execution() const;
 
+    /*!
+     * \brief Queries the index of the calling thread within this thread_pool.
+     * \return The index of the calling thread within [0..thread_count()) if
+     *         the calling thread is managed by this thread_pool;
+     *         no_worker otherwise.
+    **/
+    PL_NODISCARD std::size_t worker_index() const noexcept;
+
+#ifdef __cpp_impl_coroutine
+    /*!
+     * \brief Awaitable returned by schedule. Suspends the awaiting coroutine
+     *        and resumes it on one of the threads of the thread_pool.
+    **/
+    class schedule_operation {
+    public:
+        /*!
+         * \brief Creates a schedule_operation.
+         * \param pool The thread_pool to resume the awaiting coroutine on.
+         * \param prio The priority with which to resume the coroutine.
+        **/
+        schedule_operation(PL_IN thread_pool& pool, std::uint8_t prio) noexcept
+            : m_pool{&pool}, m_priority{prio}
+        {
+        }
+
+        PL_NODISCARD bool await_ready() const noexcept { return false; }
+
+        /*!
+         * \brief Adds a task that resumes the awaiting coroutine to the
+         *        queue of tasks of the thread_pool.
+         * \param awaiting The awaiting coroutine.
+        **/
+        void await_suspend(std::coroutine_handle<> awaiting) const
+        {
+            (void)m_pool->add_task(m_priority, [awaiting] {
+                awaiting.resume();
+            });
+        }
+
+        void await_resume() const noexcept {}
+
+    private:
+        thread_pool* m_pool;     //!< The thread_pool to resume on.
+        std::uint8_t m_priority; //!< The priority of the resumption.
+    };
+
+    /*!
+     * \brief Allows a coroutine to move its execution onto one of the threads
+     *        of this thread_pool using co_await pool.schedule().
+     * \param prio The priority with which the awaiting coroutine is to be
+     *        resumed. The value of prio must be within [0..255].
+     * \return An awaitable that resumes the awaiting coroutine on one of the
+     *         threads managed by this thread_pool.
+     * \note Only available if the compiler supports C++20 coroutines.
+     * \warning The thread_pool must not have 0 threads.
+    **/
+    PL_NODISCARD schedule_operation schedule(
+        std::uint8_t prio = static_cast<std::uint8_t>(0U)) noexcept
+    {
+        return schedule_operation{*this, prio};
+    }
+#endif // __cpp_impl_coroutine
+
 private:
     /*!
      * \brief Base class for the executors. Can run a task and store
@@ -377,6 +520,7 @@ private:
 
     /*!
      * \brief The function that the threads in this thread_pool will run.
+     * \param index The index of the thread within this thread_pool.
      *
      * A thread will keep running in a loop in this function until the
      * queue of tasks is empty and the thread_pool is being destroyed.
@@ -390,7 +534,22 @@ private:
      * that the future that was returned to the user by add_task is associated
      * with.
     **/
-    void thread_function();
+    void thread_function(std::size_t index);
+
+    /*!
+     * \brief Identifies the thread_pool a thread belongs to and the index
+     *        of that thread within the thread_pool.
+    **/
+    struct worker_identity {
+        const thread_pool* pool;  //!< nullptr if not a worker.
+        std::size_t        index; //!< the index within the thread_pool.
+    };
+
+    /*!
+     * \brief Returns the worker_identity of the calling thread.
+     * \return A reference to the thread local worker_identity.
+    **/
+    PL_NODISCARD static worker_identity& this_worker() noexcept;
 
     /*!
      * \brief Will set the is finished flag and wake all threads and then
@@ -401,6 +560,10 @@ private:
     **/
     void join();
 
+    pl::object_pool_allocator<pl::byte>
+        m_task_allocator; /*!< allocates the tasks from pools, so that adding
+                           *   a task does not need to go to the heap.
+                          **/
     std::priority_queue<std::shared_ptr<executor_base>,
                         std::vector<std::shared_ptr<executor_base>>,
                         deref_less>
@@ -417,10 +580,15 @@ private:
                                                 **/
     std::thread* m_thread_begin; //!< iterator to the first thread.
     std::thread* m_thread_end;   //!< end iterator of the range of threads.
+    std::vector<storage_base*> m_storages; /*!< storage bound to this
+                                            *   thread_pool, guarded by
+                                            *   m_mutex.
+                                           **/
 };
 
 inline thread_pool::thread_pool(std::size_t amt_threads)
-    : m_tasks_shared{ },
+    : m_task_allocator{ },
+      m_tasks_shared{ },
       m_mutex{ },
       m_cv{ },
       m_is_finished_shared{ false }, // start out not finished
@@ -432,21 +600,26 @@ inline thread_pool::thread_pool(std::size_t amt_threads)
       m_thread_begin{ // begin iterator to the range of threads
           reinterpret_cast<std::thread *>(m_threads.get())
       },
-      m_thread_end{ m_thread_begin + m_thread_count } /* end iterator.
-                                                       * is out of bounds.
-                                                       */
+      m_thread_end{ m_thread_begin + m_thread_count }, /* end iterator.
+                                                        * is out of bounds.
+                                                        */
+      m_storages{ }
 {
     // pointer to the thread_pool
     // used in the lambda below.
     auto self = this;
 
+    // the index of the next thread to be created.
+    std::size_t index{0U};
+
     // construct the threads into the raw memory.
     // start running the thread running the thread_function which is a
     // non-static member function of thread_pool.
-    std::for_each(m_thread_begin, m_thread_end, [self](PL_OUT std::thread& t) {
-        ::new (static_cast<void*>(std::addressof(t)))
-            std::thread{&thread_pool::thread_function, self};
-    });
+    std::for_each(
+        m_thread_begin, m_thread_end, [self, &index](PL_OUT std::thread& t) {
+            ::new (static_cast<void*>(std::addressof(t)))
+                std::thread{&thread_pool::thread_function, self, index++};
+        });
 }
 
 inline thread_pool::~thread_pool()
@@ -459,6 +632,13 @@ inline thread_pool::~thread_pool()
      * the unique_ptr will only free the raw memory of pl::bytes.
     **/
     algo::destroy(m_thread_begin, m_thread_end);
+
+    // release the storage bound to the threads, no thread can access
+    // it any longer.
+    for (storage_base* storage : m_storages) {
+        storage->on_pool_destroyed();
+        storage->m_pool = nullptr;
+    }
 }
 
 PL_NODISCARD inline std::size_t thread_pool::thread_count() const
@@ -476,6 +656,44 @@ PL_NODISCARD inline std::size_t thread_pool::tasks_waiting_for_execution() const
     return m_tasks_shared.size(); // return the number of tasks still to be run.
 }
 
+PL_NODISCARD inline std::size_t thread_pool::worker_index() const noexcept
+{
+    const worker_identity& identity{this_worker()};
+    return identity.pool == this ? identity.index : no_worker;
+}
+
+inline thread_pool::storage_base::storage_base(PL_INOUT thread_pool& pool)
+    : m_pool{&pool}
+{
+    std::lock_guard<std::mutex> lock{pool.m_mutex};
+    (void)lock;
+    pool.m_storages.push_back(this);
+}
+
+inline thread_pool::storage_base::~storage_base()
+{
+    if (m_pool != nullptr) {
+        std::lock_guard<std::mutex> lock{m_pool->m_mutex};
+        (void)lock;
+        std::vector<storage_base*>& storages{m_pool->m_storages};
+        storages.erase(std::remove(storages.begin(), storages.end(), this),
+                       storages.end());
+    }
+}
+
+PL_NODISCARD inline thread_pool* thread_pool::storage_base::pool() const
+    noexcept
+{
+    return m_pool;
+}
+
+PL_NODISCARD inline thread_pool::worker_identity& thread_pool::this_worker()
+    noexcept
+{
+    static thread_local worker_identity identity{nullptr, no_worker};
+    return identity;
+}
+
 inline thread_pool::executor_base::executor_base(std::uint8_t p)
     : m_priority{p} // just set the priority
 {
@@ -489,8 +707,11 @@ inline bool operator<(
     return a.m_priority < b.m_priority; // compare the priorities stored.
 }
 
-inline void thread_pool::thread_function()
+inline void thread_pool::thread_function(std::size_t index)
 {
+    // remember which thread_pool this thread belongs to.
+    this_worker() = worker_identity{this, index};
+
     // by default we're running.
     auto running = true;
 
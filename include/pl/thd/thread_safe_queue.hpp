@@ -30,9 +30,11 @@
 **/
 #ifndef INCG_PL_THD_THREAD_SAFE_QUEUE_HPP
 #define INCG_PL_THD_THREAD_SAFE_QUEUE_HPP
-#include "../annotations.hpp" // PL_IN, PL_NODISCARD
+#include "../annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"      // PL_CHECK_PRE
 #include <ciso646>            // not
 #include <condition_variable> // std::condition_variable
+#include <limits>             // std::numeric_limits
 #include <mutex>              // std::mutex, std::unique_lock
 #include <queue>              // std::queue
 #include <utility>            // std::move
@@ -44,6 +46,9 @@ namespace thd {
  *        and pop elements from the front.
  *
  * This class can be accessed from multiple threads at the same time.
+ * A thread_safe_queue can optionally be bounded, in which case pushing to
+ * a full queue blocks until another thread pops an element, which lets
+ * consumers exert backpressure on producers.
 **/
 template <typename ValueType>
 class thread_safe_queue {
@@ -54,10 +59,31 @@ public:
     using size_type      = typename container_type::size_type;
 
     /*!
-     * \brief Creates a thread_safe_queue.
+     * \brief Creates an unbounded thread_safe_queue.
      *        The thread_safe_queue will start out empty.
     **/
-    thread_safe_queue() noexcept : m_cont{}, m_mutex{}, m_cv_has_elements{} {}
+    thread_safe_queue() noexcept
+        : thread_safe_queue{std::numeric_limits<size_type>::max()}
+    {
+    }
+
+    /*!
+     * \brief Creates a bounded thread_safe_queue.
+     *        The thread_safe_queue will start out empty.
+     * \param capacity The maximum amount of elements the queue can hold.
+     *        Must not be 0.
+     * \throws pl::precondition_violation_exception if capacity is 0.
+    **/
+    explicit thread_safe_queue(size_type capacity)
+        : m_cont{},
+          m_mutex{},
+          m_cv_has_elements{},
+          m_cv_has_space{},
+          m_capacity{capacity}
+    {
+        PL_CHECK_PRE(capacity != 0U);
+    }
+
     /*!
      * \brief This type is non-copyable.
     **/
@@ -79,8 +105,10 @@ public:
     {
         std::unique_lock<std::mutex> lock{m_mutex};
         m_cv_has_elements.wait(lock, [this] { return not m_cont.empty(); });
-        auto return_value = m_cont.front();
+        auto return_value = std::move(m_cont.front());
         m_cont.pop();
+        lock.unlock();
+        m_cv_has_space.notify_one();
         return return_value;
     }
 
@@ -90,12 +118,15 @@ public:
      * \param data The object to push to the back of the queue.
      * \return A reference to this object.
      *
+     * If the queue is full the calling thread will be put to sleep until
+     * another thread pops an element.
      * Will notify threads waiting for the queue to no longer be empty that
      * the queue is no longer empty.
     **/
     this_type& push(PL_IN const value_type& data)
     {
         std::unique_lock<std::mutex> lock{m_mutex};
+        wait_for_space(lock);
         m_cont.push(data);
         lock.unlock();
         m_cv_has_elements.notify_all();
@@ -107,12 +138,15 @@ public:
      * \param data The rvalue to add to the back of the queue
      * \return A reference to this object.
      *
+     * If the queue is full the calling thread will be put to sleep until
+     * another thread pops an element.
      * Will notify threads waiting for the queue to no longer be empty that
      * the queue is no longer empty.
     **/
     this_type& push(PL_IN value_type&& data)
     {
         std::unique_lock<std::mutex> lock{m_mutex};
+        wait_for_space(lock);
         m_cont.push(std::move(data));
         lock.unlock();
         m_cv_has_elements.notify_all();
@@ -141,10 +175,28 @@ public:
         return m_cont.size();
     }
 
+    /*!
+     * \brief Queries the maximum amount of elements the queue can hold.
+     * \return The capacity of the queue.
+    **/
+    PL_NODISCARD size_type capacity() const noexcept { return m_capacity; }
+
 private:
+    /*!
+     * \brief Puts the calling thread to sleep while the queue is full.
+     * \param lock The lock holding m_mutex.
+    **/
+    void wait_for_space(PL_INOUT std::unique_lock<std::mutex>& lock)
+    {
+        m_cv_has_space.wait(
+            lock, [this] { return m_cont.size() < m_capacity; });
+    }
+
     container_type          m_cont;
     mutable std::mutex      m_mutex;
     std::condition_variable m_cv_has_elements;
+    std::condition_variable m_cv_has_space; //!< signalled on pop.
+    const size_type         m_capacity;     //!< the maximum size.
 };
 } // namespace thd
 } // namespace pl
@@ -0,0 +1,319 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file when_all.hpp
+ * \brief Exports the when_all function templates that can be used to await
+ *        multiple tasks concurrently.
+ * \note Only available if the compiler supports C++20 coroutines.
+**/
+#ifndef INCG_PL_THD_WHEN_ALL_HPP
+#define INCG_PL_THD_WHEN_ALL_HPP
+#ifdef __cpp_impl_coroutine
+#include "../annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "task.hpp"           // pl::thd::task
+#include <array>              // std::array
+#include <atomic>             // std::atomic
+#include <coroutine>          // std::coroutine_handle, std::suspend_always
+#include <cstddef>            // std::size_t
+#include <exception>          // std::terminate
+#include <memory>             // std::addressof
+#include <tuple>              // std::tuple
+#include <type_traits>        // std::conditional_t, std::is_void
+#include <utility>            // std::move, std::exchange
+#include <variant>            // std::monostate
+#include <vector>             // std::vector
+
+namespace pl {
+namespace thd {
+namespace detail {
+/*!
+ * \brief Counts the tasks of a when_all that have not yet completed.
+ *        The last one to complete resumes the coroutine awaiting the when_all.
+ *        Not to be used directly.
+ *
+ * The counter starts out at one more than the amount of tasks, the extra
+ * count is released by the awaiting coroutine after it has started all
+ * of the tasks, so that it can't be resumed before it has done so.
+**/
+class when_all_counter {
+public:
+    explicit when_all_counter(std::size_t task_count) noexcept
+        : m_count{task_count + 1U}, m_awaiting{}
+    {
+    }
+
+    /*!
+     * \brief Releases the count held by the awaiting coroutine.
+     * \return true if the awaiting coroutine has to stay suspended;
+     *         false if all the tasks have already completed.
+    **/
+    PL_NODISCARD bool release_awaiting() noexcept
+    {
+        return m_count.fetch_sub(1U, std::memory_order_acq_rel) > 1U;
+    }
+
+    /*!
+     * \brief Called by a task that has completed.
+     * \return The coroutine to transfer control to.
+    **/
+    PL_NODISCARD std::coroutine_handle<> notify_completed() noexcept
+    {
+        if (m_count.fetch_sub(1U, std::memory_order_acq_rel) == 1U) {
+            return m_awaiting;
+        }
+
+        return std::noop_coroutine();
+    }
+
+    void set_awaiting(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_awaiting = awaiting;
+    }
+
+private:
+    std::atomic<std::size_t> m_count;
+    std::coroutine_handle<>  m_awaiting;
+};
+
+/*!
+ * \brief Coroutine that awaits one of the tasks of a when_all and notifies
+ *        the when_all_counter once that task has completed.
+ *        Not to be used directly.
+**/
+class when_all_task {
+public:
+    class promise_type {
+    public:
+        promise_type() noexcept : m_counter{nullptr} {}
+
+        when_all_task get_return_object() noexcept
+        {
+            return when_all_task{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        PL_NODISCARD std::suspend_always initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        PL_NODISCARD auto final_suspend() const noexcept
+        {
+            class awaiter {
+            public:
+                PL_NODISCARD bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                PL_NODISCARD std::coroutine_handle<> await_suspend(
+                    std::coroutine_handle<promise_type> handle) const noexcept
+                {
+                    return handle.promise().m_counter->notify_completed();
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            return awaiter{};
+        }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+
+        void start(PL_INOUT when_all_counter& counter)
+        {
+            m_counter = std::addressof(counter);
+            std::coroutine_handle<promise_type>::from_promise(*this).resume();
+        }
+
+    private:
+        when_all_counter* m_counter;
+    };
+
+    when_all_task() noexcept : m_handle{} {}
+
+    explicit when_all_task(std::coroutine_handle<promise_type> handle) noexcept
+        : m_handle{handle}
+    {
+    }
+
+    when_all_task(const when_all_task&) = delete;
+
+    when_all_task& operator=(const when_all_task&) = delete;
+
+    when_all_task(when_all_task&& other) noexcept
+        : m_handle{std::exchange(other.m_handle, nullptr)}
+    {
+    }
+
+    when_all_task& operator=(when_all_task&& other) noexcept
+    {
+        std::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    ~when_all_task()
+    {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    void start(PL_INOUT when_all_counter& counter)
+    {
+        m_handle.promise().start(counter);
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+template <typename Type>
+inline when_all_task make_when_all_task(PL_IN const task<Type>& t)
+{
+    co_await t.when_ready();
+}
+
+/*!
+ * \brief Awaitable that starts all the when_all_tasks passed and completes
+ *        once all of them have completed.
+ *        Not to be used directly.
+**/
+template <typename Range>
+class when_all_awaiter {
+public:
+    explicit when_all_awaiter(PL_INOUT Range& tasks)
+        : m_tasks{tasks}, m_counter{tasks.size()}
+    {
+    }
+
+    PL_NODISCARD bool await_ready() const noexcept { return m_tasks.empty(); }
+
+    PL_NODISCARD bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        m_counter.set_awaiting(awaiting);
+
+        for (when_all_task& t : m_tasks) {
+            t.start(m_counter);
+        }
+
+        return m_counter.release_awaiting();
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Range&           m_tasks;
+    when_all_counter m_counter;
+};
+
+/*!
+ * \brief The type that a task<Type> contributes to the result of when_all.
+ *        Void tasks contribute std::monostate.
+**/
+template <typename Type>
+using when_all_result_t
+    = std::conditional_t<std::is_void<Type>::value, std::monostate, Type>;
+
+template <typename Type>
+inline Type take_when_all_result(task<Type>& t)
+{
+    return std::move(t).result();
+}
+
+inline std::monostate take_when_all_result(task<void>& t)
+{
+    std::move(t).result();
+    return {};
+}
+} // namespace detail
+
+/*!
+ * \brief Runs the tasks passed concurrently.
+ * \param tasks The tasks to run.
+ * \return A task that completes once all the tasks passed have completed.
+ *         Its result is a std::tuple of the results of the tasks passed,
+ *         void tasks contribute std::monostate. If any of the tasks completed
+ *         with an exception, the exception of the leftmost such task is
+ *         rethrown when the result is fetched.
+ *
+ * Every task is started on the thread that awaits the returned task, they only
+ * run concurrently if they move themselves onto other threads, for instance
+ * using co_await thread_pool::schedule(). The coroutine awaiting the returned
+ * task is resumed on the thread that completed the last of the tasks.
+**/
+template <typename... Types>
+inline task<std::tuple<detail::when_all_result_t<Types>...>> when_all(
+    task<Types>... tasks)
+{
+    std::array<detail::when_all_task, sizeof...(Types)> waiters{
+        {detail::make_when_all_task(tasks)...}};
+    co_await detail::when_all_awaiter<decltype(waiters)>{waiters};
+    co_return std::tuple<detail::when_all_result_t<Types>...>{
+        detail::take_when_all_result(tasks)...};
+}
+
+/*!
+ * \brief Runs the tasks passed concurrently.
+ * \param tasks The tasks to run.
+ * \return A task that completes once all the tasks passed have completed.
+ *         Its result is a std::vector of the results of the tasks in the
+ *         order of the tasks passed. If any of the tasks completed with an
+ *         exception, the exception of the first such task is rethrown when
+ *         the result is fetched.
+**/
+template <typename Type>
+inline task<std::vector<detail::when_all_result_t<Type>>> when_all(
+    std::vector<task<Type>> tasks)
+{
+    std::vector<detail::when_all_task> waiters{};
+    waiters.reserve(tasks.size());
+
+    for (const task<Type>& t : tasks) {
+        waiters.push_back(detail::make_when_all_task(t));
+    }
+
+    co_await detail::when_all_awaiter<decltype(waiters)>{waiters};
+
+    std::vector<detail::when_all_result_t<Type>> results{};
+    results.reserve(tasks.size());
+
+    for (task<Type>& t : tasks) {
+        results.push_back(detail::take_when_all_result(t));
+    }
+
+    co_return results;
+}
+} // namespace thd
+} // namespace pl
+#endif // __cpp_impl_coroutine
+#endif // INCG_PL_THD_WHEN_ALL_HPP
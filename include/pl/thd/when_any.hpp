@@ -0,0 +1,286 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file when_any.hpp
+ * \brief Exports the when_any function templates that can be used to await
+ *        the first of multiple tasks to complete.
+ * \note Only available if the compiler supports C++20 coroutines.
+**/
+#ifndef INCG_PL_THD_WHEN_ANY_HPP
+#define INCG_PL_THD_WHEN_ANY_HPP
+#ifdef __cpp_impl_coroutine
+#include "../annotations.hpp"      // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"           // PL_DBG_CHECK_PRE
+#include "../meta/conjunction.hpp" // pl::meta::conjunction
+#include "task.hpp"                // pl::thd::task
+#include <atomic>                  // std::atomic
+#include <coroutine>               // std::coroutine_handle, std::suspend_never
+#include <cstddef>                 // std::size_t
+#include <exception>               // std::terminate
+#include <limits>                  // std::numeric_limits
+#include <memory>                  // std::shared_ptr, std::make_shared
+#include <type_traits>             // std::is_same, std::enable_if_t
+#include <utility>                 // std::move
+#include <vector>                  // std::vector
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief The result of when_any. Holds the index of the task that completed
+ *        first as well as its result.
+**/
+template <typename Type>
+struct when_any_result {
+    std::size_t index; //!< index of the task that completed first.
+    Type        value; //!< the result of that task.
+};
+
+/*!
+ * \brief The result of when_any for void tasks. Holds the index of the task
+ *        that completed first.
+**/
+template <>
+struct when_any_result<void> {
+    std::size_t index; //!< index of the task that completed first.
+};
+
+namespace detail {
+/*!
+ * \brief State shared between a when_any and the coroutines awaiting its
+ *        tasks. Owns the tasks so that the tasks that did not complete first
+ *        can keep running after the when_any has completed.
+ *        Not to be used directly.
+**/
+template <typename Type>
+class when_any_state {
+public:
+    static constexpr std::size_t no_index{
+        std::numeric_limits<std::size_t>::max()};
+
+    explicit when_any_state(std::vector<task<Type>> tasks)
+        : m_tasks{std::move(tasks)},
+          m_winner{no_index},
+          m_resume_count{2U},
+          m_awaiting{}
+    {
+    }
+
+    PL_NODISCARD std::vector<task<Type>>& tasks() noexcept { return m_tasks; }
+
+    PL_NODISCARD std::size_t winner() const noexcept
+    {
+        return m_winner.load(std::memory_order_acquire);
+    }
+
+    void set_awaiting(std::coroutine_handle<> awaiting) noexcept
+    {
+        m_awaiting = awaiting;
+    }
+
+    /*!
+     * \brief Called by the task at index once it has completed.
+     *        The first task to complete resumes the awaiting coroutine,
+     *        unless that coroutine is still busy starting tasks.
+    **/
+    void notify_completed(std::size_t index) noexcept
+    {
+        std::size_t expected{no_index};
+
+        if (m_winner.compare_exchange_strong(
+                expected, index, std::memory_order_acq_rel)) {
+            if (release()) {
+                m_awaiting.resume();
+            }
+        }
+    }
+
+    /*!
+     * \brief Releases one of the two counts required to resume the awaiting
+     *        coroutine. One is held by the awaiting coroutine until it has
+     *        started all the tasks, the other by the first task to complete.
+     * \return true if the caller released the last count.
+    **/
+    PL_NODISCARD bool release() noexcept
+    {
+        return m_resume_count.fetch_sub(1U, std::memory_order_acq_rel) == 1U;
+    }
+
+private:
+    std::vector<task<Type>>  m_tasks;
+    std::atomic<std::size_t> m_winner;
+    std::atomic<std::size_t> m_resume_count;
+    std::coroutine_handle<>  m_awaiting;
+};
+
+/*!
+ * \brief Eagerly started, self-destroying coroutine that awaits one of the
+ *        tasks of a when_any. Keeps the shared state alive until that task
+ *        has completed.
+ *        Not to be used directly.
+**/
+class when_any_task {
+public:
+    class promise_type {
+    public:
+        when_any_task get_return_object() const noexcept { return {}; }
+
+        PL_NODISCARD std::suspend_never initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        PL_NODISCARD std::suspend_never final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        [[noreturn]] void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+template <typename Type>
+inline when_any_task make_when_any_task(
+    std::shared_ptr<when_any_state<Type>> state,
+    std::size_t                           index)
+{
+    co_await state->tasks()[index].when_ready();
+    state->notify_completed(index);
+}
+
+/*!
+ * \brief Awaitable that starts all the tasks of a when_any and completes
+ *        once the first of them has completed.
+ *        Not to be used directly.
+**/
+template <typename Type>
+class when_any_awaiter {
+public:
+    explicit when_any_awaiter(
+        PL_IN const std::shared_ptr<when_any_state<Type>>& state) noexcept
+        : m_state{state}
+    {
+    }
+
+    PL_NODISCARD bool await_ready() const noexcept { return false; }
+
+    PL_NODISCARD bool await_suspend(std::coroutine_handle<> awaiting)
+    {
+        // keep a local reference, this awaiter lives in the awaiting
+        // coroutine's frame which may be destroyed once it is resumed.
+        const std::shared_ptr<when_any_state<Type>> state{m_state};
+        state->set_awaiting(awaiting);
+
+        const std::size_t task_count{state->tasks().size()};
+
+        for (std::size_t i{0U}; i < task_count; ++i) {
+            make_when_any_task(state, i);
+
+            if (state->winner() != when_any_state<Type>::no_index) {
+                break; // no need to start the remaining tasks.
+            }
+        }
+
+        return not state->release();
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    const std::shared_ptr<when_any_state<Type>>& m_state;
+};
+
+template <typename Type>
+inline when_any_result<Type> take_when_any_result(
+    PL_INOUT task<Type>& t,
+    std::size_t          index)
+{
+    return when_any_result<Type>{index, std::move(t).result()};
+}
+
+inline when_any_result<void> take_when_any_result(
+    PL_INOUT task<void>& t,
+    std::size_t          index)
+{
+    std::move(t).result();
+    return when_any_result<void>{index};
+}
+} // namespace detail
+
+/*!
+ * \brief Runs the tasks passed concurrently until the first of them completes.
+ * \param tasks The tasks to run. Must not be empty.
+ * \return A task that completes as soon as the first of the tasks passed has
+ *         completed. Its result is a when_any_result holding the index of
+ *         that task and its result. If that task completed with an exception
+ *         the exception is rethrown when the result is fetched.
+ *
+ * Tasks are started in order, tasks after the first one to complete
+ * synchronously are not started at all. The tasks that have been started but
+ * did not complete first keep running, their results are discarded. The tasks
+ * are kept alive until all of them have completed.
+**/
+template <typename Type>
+inline task<when_any_result<Type>> when_any(std::vector<task<Type>> tasks)
+{
+    PL_DBG_CHECK_PRE(not tasks.empty());
+
+    const std::shared_ptr<detail::when_any_state<Type>> state{
+        std::make_shared<detail::when_any_state<Type>>(std::move(tasks))};
+    co_await detail::when_any_awaiter<Type>{state};
+
+    const std::size_t index{state->winner()};
+    co_return detail::take_when_any_result(state->tasks()[index], index);
+}
+
+/*!
+ * \brief Runs the tasks passed concurrently until the first of them completes.
+ * \param first The first task.
+ * \param rest The remaining tasks, all the tasks must have the same type.
+ * \return A task that completes as soon as the first of the tasks passed has
+ *         completed. Its result is a when_any_result holding the index of
+ *         that task and its result.
+**/
+template <typename Type, typename... Types>
+inline auto when_any(task<Type> first, task<Types>... rest)
+    -> std::enable_if_t<meta::conjunction<std::is_same<Type, Types>...>::value,
+                        task<when_any_result<Type>>>
+{
+    std::vector<task<Type>> tasks{};
+    tasks.reserve(1U + sizeof...(Types));
+    tasks.push_back(std::move(first));
+    (tasks.push_back(std::move(rest)), ...);
+    return when_any(std::move(tasks));
+}
+} // namespace thd
+} // namespace pl
+#endif // __cpp_impl_coroutine
+#endif // INCG_PL_THD_WHEN_ANY_HPP
@@ -0,0 +1,194 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+/*!
+ * \file worker_local.hpp
+ * \brief Defines the worker_local class, which holds one lazily constructed
+ *        object per thread of a thread_pool.
+**/
+#ifndef INCG_PL_THD_WORKER_LOCAL_HPP
+#define INCG_PL_THD_WORKER_LOCAL_HPP
+#include "../annotations.hpp" // PL_IN, PL_INOUT, PL_NODISCARD
+#include "../assert.hpp"      // PL_DBG_CHECK_PRE
+#include "../invoke.hpp"      // pl::invoke
+#include "thread_pool.hpp"    // pl::thd::thread_pool
+#include <cstddef>            // std::size_t
+#include <functional>         // std::function
+#include <memory>             // std::unique_ptr, std::make_unique
+#include <utility>            // std::move
+#include <vector>             // std::vector
+
+namespace pl {
+namespace thd {
+/*!
+ * \brief Holds one object of type Type per thread of a thread_pool.
+ *
+ * Each object is constructed lazily the first time the thread it belongs to
+ * calls local(). Unlike thread_local variables the objects are specific to
+ * a single thread_pool and are destroyed together with that thread_pool
+ * (or with the worker_local, whichever comes first).
+ * The objects that have been constructed can be iterated over, for instance
+ * to merge per thread results.
+**/
+template <typename Type>
+class worker_local final : public thread_pool::storage_base {
+public:
+    using this_type    = worker_local;
+    using element_type = Type;
+    using factory_type = std::function<Type()>;
+
+    /*!
+     * \brief Creates a worker_local whose objects are value initialized.
+     * \param pool The thread_pool to bind to.
+    **/
+    explicit worker_local(PL_INOUT thread_pool& pool)
+        : worker_local{pool, [] { return Type{}; }}
+    {
+    }
+
+    /*!
+     * \brief Creates a worker_local whose objects are created by factory.
+     * \param pool The thread_pool to bind to.
+     * \param factory Callable returning a Type, invoked by a thread of the
+     *        thread_pool the first time that thread calls local().
+    **/
+    worker_local(PL_INOUT thread_pool& pool, factory_type factory)
+        : storage_base{pool},
+          m_factory{std::move(factory)},
+          m_objects(pool.thread_count())
+    {
+    }
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    worker_local(const this_type&) = delete;
+
+    /*!
+     * \brief This type is non-copyable.
+    **/
+    this_type& operator=(const this_type&) = delete;
+
+    /*!
+     * \brief Returns the object belonging to the calling thread. Creates it
+     *        if this is the first time the calling thread accesses it.
+     * \return The object belonging to the calling thread.
+     * \warning Must only be called by the threads of the thread_pool.
+    **/
+    PL_NODISCARD Type& local()
+    {
+        PL_DBG_CHECK_PRE(pool() != nullptr);
+        const std::size_t index{pool()->worker_index()};
+        PL_DBG_CHECK_PRE(index != thread_pool::no_worker);
+
+        std::unique_ptr<Type>& object{m_objects[index]};
+
+        if (object == nullptr) {
+            object = std::make_unique<Type>(m_factory());
+        }
+
+        return *object;
+    }
+
+    /*!
+     * \brief Invokes callable with every object that has been created.
+     * \param callable The callable to invoke with a Type&.
+     * \warning Must not be called while threads of the thread_pool may be
+     *          accessing their objects, e.g. call it after waiting on the
+     *          futures of the tasks that use this worker_local.
+    **/
+    template <typename Callable>
+    void for_each(PL_IN Callable&& callable)
+    {
+        for (std::unique_ptr<Type>& object : m_objects) {
+            if (object != nullptr) {
+                ::pl::invoke(callable, *object);
+            }
+        }
+    }
+
+    /*!
+     * \brief Reduces the objects that have been created.
+     * \param init The initial value.
+     * \param binary_operation Callable invoked as
+     *        binary_operation(accumulator, object), whose result becomes the
+     *        new accumulator.
+     * \return The final accumulator.
+     * \warning Same restrictions as for_each.
+    **/
+    template <typename Ty, typename BinaryOperation>
+    PL_NODISCARD Ty combine(Ty init, BinaryOperation binary_operation) const
+    {
+        for (const std::unique_ptr<Type>& object : m_objects) {
+            if (object != nullptr) {
+                init = ::pl::invoke(binary_operation, std::move(init), *object);
+            }
+        }
+
+        return init;
+    }
+
+    /*!
+     * \brief Queries the amount of objects that have been created.
+     * \return The amount of objects created.
+     * \warning Same restrictions as for_each.
+    **/
+    PL_NODISCARD std::size_t size() const noexcept
+    {
+        std::size_t count{0U};
+
+        for (const std::unique_ptr<Type>& object : m_objects) {
+            if (object != nullptr) {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+    /*!
+     * \brief Destroys all the objects created. They will be recreated lazily.
+     * \warning Same restrictions as for_each.
+    **/
+    void clear() noexcept
+    {
+        for (std::unique_ptr<Type>& object : m_objects) {
+            object.reset();
+        }
+    }
+
+private:
+    /*!
+     * \brief Destroys the objects, the threads they belong to are gone.
+    **/
+    virtual void on_pool_destroyed() noexcept override { clear(); }
+
+    factory_type                       m_factory; //!< creates the objects.
+    std::vector<std::unique_ptr<Type>> m_objects; //!< one per thread.
+};
+} // namespace thd
+} // namespace pl
+#endif // INCG_PL_THD_WORKER_LOCAL_HPP
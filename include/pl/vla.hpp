@@ -26,12 +26,195 @@
 
 /*!
  * \file vla.hpp
- * \brief Exports the PL_VLA macro.
+ * \brief Exports the PL_VLA and PL_SAFE_VLA macros.
 **/
 #ifndef INCG_PL_VLA_HPP
 #define INCG_PL_VLA_HPP
 #include "alloca.hpp"           // PL_ALLOCA
+#include "annotations.hpp"      // PL_NODISCARD
 #include "raw_memory_array.hpp" // pl::RawMemoryArray
+#include <ciso646>              // and, or
+#include <cstddef>              // std::size_t
+#include <new>                  // ::operator new, ::operator delete
+
+/*!
+ * \def PL_SAFE_VLA_MAX_STACK_BYTES
+ * \brief The largest amount of bytes that PL_SAFE_VLA allocates from the
+ *        stack. Larger VLAs are allocated from the heap.
+ *        May be defined before including this file.
+**/
+#ifndef PL_SAFE_VLA_MAX_STACK_BYTES
+#define PL_SAFE_VLA_MAX_STACK_BYTES 1024U
+#endif // PL_SAFE_VLA_MAX_STACK_BYTES
+
+/*!
+ * \def PL_SAFE_VLA_MAX_CACHED_BYTES
+ * \brief The largest heap buffer of PL_SAFE_VLA that is kept in the per
+ *        thread cache. Larger buffers are freed once the VLA goes out of
+ *        scope, so that a single huge VLA doesn't pin its memory for the
+ *        lifetime of the thread. May be defined before including this file.
+**/
+#ifndef PL_SAFE_VLA_MAX_CACHED_BYTES
+#define PL_SAFE_VLA_MAX_CACHED_BYTES 1048576U
+#endif // PL_SAFE_VLA_MAX_CACHED_BYTES
+
+namespace pl {
+namespace detail {
+/*!
+ * \brief Per thread cache of the heap buffers of PL_SAFE_VLA, so that
+ *        repeatedly creating large VLAs does not go to the heap every time.
+ *        Not to be used directly.
+**/
+class vla_buffer_cache {
+public:
+    using this_type = vla_buffer_cache;
+
+    static constexpr std::size_t max_buffers = 4U;
+
+    vla_buffer_cache() noexcept : m_buffers{}, m_count{0U} {}
+
+    vla_buffer_cache(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    ~vla_buffer_cache()
+    {
+        for (std::size_t i{0U}; i < m_count; ++i) {
+            ::operator delete(m_buffers[i].memory);
+        }
+    }
+
+    PL_NODISCARD static this_type& instance()
+    {
+        thread_local this_type cache{};
+        return cache;
+    }
+
+    /*!
+     * \brief Returns the smallest cached buffer of at least byte_count
+     *        bytes, or allocates a new one.
+    **/
+    PL_NODISCARD void* acquire(std::size_t byte_count, std::size_t& capacity)
+    {
+        std::size_t best{m_count};
+
+        for (std::size_t i{0U}; i < m_count; ++i) {
+            if ((m_buffers[i].size >= byte_count)
+                and ((best == m_count)
+                     or (m_buffers[i].size < m_buffers[best].size))) {
+                best = i;
+            }
+        }
+
+        if (best == m_count) {
+            capacity = byte_count;
+            return ::operator new(byte_count);
+        }
+
+        void* const memory{m_buffers[best].memory};
+        capacity          = m_buffers[best].size;
+        m_buffers[best]   = m_buffers[m_count - 1U];
+        --m_count;
+        return memory;
+    }
+
+    /*!
+     * \brief Caches the buffer, evicting the smallest one if the cache is
+     *        full. Buffers larger than PL_SAFE_VLA_MAX_CACHED_BYTES are
+     *        freed instead.
+    **/
+    void release(void* memory, std::size_t capacity) noexcept
+    {
+        if (capacity > PL_SAFE_VLA_MAX_CACHED_BYTES) {
+            ::operator delete(memory);
+            return;
+        }
+
+        if (m_count < max_buffers) {
+            m_buffers[m_count] = buffer{memory, capacity};
+            ++m_count;
+            return;
+        }
+
+        std::size_t smallest{0U};
+
+        for (std::size_t i{1U}; i < m_count; ++i) {
+            if (m_buffers[i].size < m_buffers[smallest].size) {
+                smallest = i;
+            }
+        }
+
+        if (m_buffers[smallest].size < capacity) {
+            ::operator delete(m_buffers[smallest].memory);
+            m_buffers[smallest] = buffer{memory, capacity};
+        }
+        else {
+            ::operator delete(memory);
+        }
+    }
+
+    /*!
+     * \brief Returns the amount of buffers cached.
+    **/
+    PL_NODISCARD std::size_t size() const noexcept { return m_count; }
+
+private:
+    struct buffer {
+        void*       memory;
+        std::size_t size;
+    };
+
+    buffer      m_buffers[max_buffers];
+    std::size_t m_count;
+};
+
+/*!
+ * \brief Owns the heap memory of a PL_SAFE_VLA that is too large for the
+ *        stack. Not to be used directly.
+**/
+class vla_heap_buffer {
+public:
+    using this_type = vla_heap_buffer;
+
+    vla_heap_buffer(std::size_t byte_count, std::size_t max_stack_bytes)
+        : m_byte_count{byte_count}, m_memory{nullptr}, m_capacity{0U}
+    {
+        if (m_byte_count > max_stack_bytes) {
+            m_memory = vla_buffer_cache::instance().acquire(
+                m_byte_count, m_capacity);
+        }
+    }
+
+    vla_heap_buffer(const this_type&) = delete;
+
+    this_type& operator=(const this_type&) = delete;
+
+    ~vla_heap_buffer()
+    {
+        if (m_memory != nullptr) {
+            vla_buffer_cache::instance().release(m_memory, m_capacity);
+        }
+    }
+
+    PL_NODISCARD std::size_t byte_count() const noexcept
+    {
+        return m_byte_count;
+    }
+
+    PL_NODISCARD bool is_on_heap() const noexcept
+    {
+        return m_memory != nullptr;
+    }
+
+    PL_NODISCARD void* data() const noexcept { return m_memory; }
+
+private:
+    std::size_t m_byte_count;
+    void*       m_memory;
+    std::size_t m_capacity;
+};
+} // namespace detail
+} // namespace pl
 
 /*!
  * \def PL_VLA(type, identifier, size, ...)
@@ -42,8 +225,10 @@
  *        Pass an object with which to initialize the objects in the
  *        VLA by copy construction into the macro varargs.
  * \warning Internally uses PL_ALLOCA. Beware of stack overflow. See the
- *          documentation of PL_ALLOCA.
+ *          documentation of PL_ALLOCA. Use PL_SAFE_VLA if 'size' may be
+ *          large.
  * \see PL_ALLOCA
+ * \see PL_SAFE_VLA
  * \note If the type contains a comma such as
  *       std::unordered_map<int, std::string>
  *       you have to use a type alias for that type, rather than using the type
@@ -53,4 +238,29 @@
 #define PL_VLA(type, identifier, size, ...)  \
     ::pl::raw_memory_array<type> identifier( \
         PL_ALLOCA(sizeof(type) * size), sizeof(type) * size, __VA_ARGS__)
+
+/*!
+ * \def PL_SAFE_VLA(type, identifier, size, ...)
+ * \brief Like PL_VLA, but only allocates the VLA from the stack if it is
+ *        no larger than PL_SAFE_VLA_MAX_STACK_BYTES bytes, otherwise it is
+ *        allocated from the heap. Heap buffers are cached per thread and
+ *        reused by later PL_SAFE_VLAs.
+ *        'identifier' is a pl::raw_memory_array<type> either way.
+ * \note Declares additional variables in the current scope whose names
+ *       begin with pl_vla_, followed by 'identifier'.
+ * \note 'size' is evaluated once.
+ * \see PL_VLA
+ * \see PL_SAFE_VLA_MAX_STACK_BYTES
+**/
+#define PL_SAFE_VLA(type, identifier, size, ...)                              \
+    const ::pl::detail::vla_heap_buffer pl_vla_buffer_##identifier(          \
+        sizeof(type) * (size), PL_SAFE_VLA_MAX_STACK_BYTES);                  \
+    void* const pl_vla_memory_##identifier                                    \
+        = pl_vla_buffer_##identifier.is_on_heap()                             \
+              ? pl_vla_buffer_##identifier.data()                             \
+              : PL_ALLOCA(pl_vla_buffer_##identifier.byte_count());           \
+    ::pl::raw_memory_array<type> identifier(                                  \
+        pl_vla_memory_##identifier,                                           \
+        pl_vla_buffer_##identifier.byte_count(),                              \
+        __VA_ARGS__)
 #endif // INCG_PL_VLA_HPP
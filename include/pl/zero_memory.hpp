@@ -30,13 +30,96 @@
 **/
 #ifndef INCG_PL_ZERO_MEMORY_HPP
 #define INCG_PL_ZERO_MEMORY_HPP
-#include "annotations.hpp" // PL_OUT
-#include "assert.hpp"      // PL_DBG_CHECK_PRE
-#include "byte.hpp"        // pl::byte
-#include "inline.hpp"      // PL_ALWAYS_INLINE
-#include <cstddef>         // std::size_t
+#include "annotations.hpp"  // PL_OUT
+#include "assert.hpp"       // PL_DBG_CHECK_PRE
+#include "byte.hpp"         // pl::byte
+#include "compiler.hpp"     // PL_COMPILER, PL_COMPILER_GCC, PL_COMPILER_CLANG, PL_COMPILER_ICC
+#include "cpu_features.hpp" // pl::best_simd_level, pl::last_level_cache_size, PL_TARGET, PL_CPU_X86
+#include "inline.hpp"       // PL_ALWAYS_INLINE
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uintptr_t
+#include <cstring>          // std::memset
+#if PL_CPU_X86
+#include <emmintrin.h> // _mm_stream_si128, _mm_setzero_si128, _mm_sfence
+#endif
 
 namespace pl {
+/*!
+ * \brief Selects whether pl::zero_memory leaves the zeroed memory in the
+ *        CPU caches.
+**/
+enum class zero_memory_policy {
+    automatic, //!< streaming for buffers larger than the last level cache.
+    cached,    //!< regular stores, the memory ends up in the caches.
+    streaming  //!< non-temporal stores that bypass the caches.
+};
+
+namespace detail {
+#if PL_CPU_X86
+/*!
+ * \brief Zeroes memory using non-temporal 16 byte stores.
+ *        Not to be used directly.
+**/
+PL_TARGET("sse2")
+inline void zero_memory_streaming_sse2(
+    byte*       dest,
+    std::size_t count_bytes) noexcept
+{
+    const std::size_t misalignment{static_cast<std::size_t>(
+        reinterpret_cast<std::uintptr_t>(dest) & 15U)};
+    std::size_t head{misalignment == 0U ? 0U : (16U - misalignment)};
+
+    if (head > count_bytes) {
+        head = count_bytes;
+    }
+
+    std::memset(dest, 0, head);
+    dest += head;
+    count_bytes -= head;
+
+    const __m128i zero{_mm_setzero_si128()};
+
+    while (count_bytes >= 64U) {
+        __m128i* const d{reinterpret_cast<__m128i*>(dest)};
+        _mm_stream_si128(d, zero);
+        _mm_stream_si128(d + 1, zero);
+        _mm_stream_si128(d + 2, zero);
+        _mm_stream_si128(d + 3, zero);
+
+        count_bytes -= 64U;
+        dest += 64U;
+    }
+
+    while (count_bytes >= 16U) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dest), zero);
+
+        count_bytes -= 16U;
+        dest += 16U;
+    }
+
+    std::memset(dest, 0, count_bytes);
+
+    // order the non-temporal stores before any later stores.
+    _mm_sfence();
+}
+#endif // PL_CPU_X86
+
+/*!
+ * \brief Zeroes memory bypassing the caches if the CPU supports it.
+ *        Not to be used directly.
+**/
+inline void zero_memory_streaming(byte* dest, std::size_t count_bytes) noexcept
+{
+#if PL_CPU_X86
+    if (best_simd_level() != simd_level::none) {
+        zero_memory_streaming_sse2(dest, count_bytes);
+        return;
+    }
+#endif
+    std::memset(dest, 0, count_bytes);
+}
+} // namespace detail
+
 /*!
  * \brief Copies a zero byte into each of the first count_bytes
  *        characters of the object pointed to by dest.
@@ -62,13 +145,41 @@ PL_ALWAYS_INLINE void* zero_memory(PL_OUT void* dest, std::size_t count_bytes)
 {
     PL_DBG_CHECK_PRE(dest != nullptr);
 
-    byte* ptr{static_cast<byte*>(dest)};
+    return std::memset(dest, 0, count_bytes);
+}
 
-    for (; count_bytes != 0U; ++ptr, --count_bytes) {
-        *ptr = 0U;
+/*!
+ * \brief Copies a zero byte into each of the first count_bytes
+ *        characters of the object pointed to by dest, using regular or
+ *        non-temporal stores as selected by policy.
+ * \param dest Pointer to the object to fill with zero bytes.
+ *        (May never be a null pointer!)
+ * \param count_bytes number of bytes to fill with zeroes.
+ * \param policy Whether to bypass the CPU caches. Bypassing them avoids
+ *               evicting useful data when clearing buffers that won't be
+ *               read again soon, but makes reading them again slower.
+ * \return dest (a copy of the first parameter as it was passed in)
+ * \warning The same warnings as for the overload without a policy apply.
+ * \see secure_zero_memory
+**/
+inline void* zero_memory(
+    PL_OUT void*       dest,
+    std::size_t        count_bytes,
+    zero_memory_policy policy)
+{
+    PL_DBG_CHECK_PRE(dest != nullptr);
+
+    const bool streaming{
+        (policy == zero_memory_policy::streaming)
+        or ((policy == zero_memory_policy::automatic)
+            and (count_bytes > last_level_cache_size()))};
+
+    if (streaming) {
+        detail::zero_memory_streaming(static_cast<byte*>(dest), count_bytes);
+        return dest;
     }
 
-    return dest;
+    return std::memset(dest, 0, count_bytes);
 }
 
 /*!
@@ -93,6 +204,8 @@ PL_ALWAYS_INLINE void* zero_memory(PL_OUT void* dest, std::size_t count_bytes)
  * pl::zero_memory when you want to ensure that the data will be zeroed out
  * even if the object pointed to by dest will not be referenced after
  * a call to this function.
+ * Uses memset followed by a compiler barrier where supported, so it runs as
+ * fast as pl::zero_memory, and volatile stores otherwise.
 **/
 PL_ALWAYS_INLINE void* secure_zero_memory(
     PL_OUT void* dest,
@@ -100,11 +213,20 @@ PL_ALWAYS_INLINE void* secure_zero_memory(
 {
     PL_DBG_CHECK_PRE(dest != nullptr);
 
+#if (PL_COMPILER == PL_COMPILER_GCC) || (PL_COMPILER == PL_COMPILER_CLANG) \
+    || (PL_COMPILER == PL_COMPILER_ICC)
+    std::memset(dest, 0, count_bytes);
+
+    // the compiler must assume that the empty assembly reads the zeroed
+    // memory through dest, so the memset can't be removed as a dead store.
+    __asm__ __volatile__("" : : "r"(dest) : "memory");
+#else
     volatile byte* ptr{static_cast<volatile byte*>(dest)};
 
     for (; count_bytes != 0U; ++ptr, --count_bytes) {
         *ptr = 0U;
     }
+#endif
 
     return dest;
 }
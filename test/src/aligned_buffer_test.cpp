@@ -0,0 +1,148 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/aligned_buffer.hpp"   // pl::aligned_buffer, pl::aligned_allocator
+#include "../../include/pl/os.hpp"               // PL_OS, PL_OS_LINUX
+#include "../../include/pl/raw_memory_array.hpp" // pl::raw_memory_array
+#include <cstddef>                               // std::size_t
+#include <cstdint>                               // std::uintptr_t
+#include <cstring>                               // std::memset
+#include <utility>                               // std::move
+#include <vector>                                // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+bool is_aligned(const void* pointer, std::size_t alignment)
+{
+    return (reinterpret_cast<std::uintptr_t>(pointer) % alignment) == 0U;
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("aligned_buffer_test")
+{
+    const pl::aligned_buffer empty{};
+    CHECK(empty.empty());
+    CHECK(empty.data() == nullptr);
+    CHECK(empty.size() == 0U);
+
+    pl::aligned_buffer buffer{100U};
+    CHECK_FALSE(buffer.empty());
+    CHECK(buffer.size() == 100U);
+    CHECK(buffer.alignment() == pl::cache_line_size);
+    CHECK(pl::test::is_aligned(buffer.data(), pl::cache_line_size));
+    CHECK_FALSE(buffer.placement().is_mapped);
+    std::memset(buffer.data(), 0xFF, buffer.size());
+
+    const pl::aligned_buffer page_aligned{10U, 4096U};
+    CHECK(pl::test::is_aligned(page_aligned.data(), 4096U));
+
+    void* const        memory{buffer.data()};
+    pl::aligned_buffer moved{std::move(buffer)};
+    CHECK(moved.data() == memory);
+    CHECK(buffer.empty());
+
+    buffer = std::move(moved);
+    CHECK(buffer.data() == memory);
+    CHECK(moved.empty());
+}
+
+TEST_CASE("aligned_buffer_huge_page_test")
+{
+    pl::aligned_buffer buffer{
+        pl::huge_page_size + 1U,
+        pl::cache_line_size,
+        pl::huge_page_policy::automatic};
+    CHECK(buffer.size() == (pl::huge_page_size + 1U));
+    std::memset(buffer.data(), 1, buffer.size());
+
+    const pl::aligned_buffer_placement placement{buffer.placement()};
+#if PL_OS == PL_OS_LINUX
+    CHECK(placement.is_mapped);
+    CHECK(placement.is_huge_page_aligned);
+    CHECK(pl::test::is_aligned(buffer.data(), pl::huge_page_size));
+#endif
+    CHECK(placement.huge_page_bytes <= (2U * pl::huge_page_size));
+
+    const pl::aligned_buffer never{
+        pl::huge_page_size, 64U, pl::huge_page_policy::never};
+    CHECK_FALSE(never.placement().is_mapped);
+    CHECK_FALSE(never.placement().huge_pages_advised);
+
+    const pl::aligned_buffer always{
+        64U, 64U, pl::huge_page_policy::always};
+#if PL_OS == PL_OS_LINUX
+    CHECK(always.placement().is_mapped);
+#endif
+    CHECK(pl::test::is_aligned(always.data(), 64U));
+}
+
+TEST_CASE("aligned_buffer_raw_memory_array_test")
+{
+    static constexpr std::size_t count{32U};
+    pl::aligned_buffer           buffer{count * sizeof(double)};
+    pl::raw_memory_array<double> view{
+        buffer.data(), buffer.size(), pl::default_init_t{}};
+    CHECK(view.size() == count);
+    CHECK(static_cast<void*>(view.data()) == buffer.data());
+    view.fill(1.5);
+    CHECK(view.back() > 1.0);
+}
+
+TEST_CASE("aligned_allocator_test")
+{
+    std::vector<int, pl::aligned_allocator<int>> vector{};
+
+    for (int i{0}; i < 1000; ++i) {
+        vector.push_back(i);
+        CHECK(pl::test::is_aligned(vector.data(), pl::cache_line_size));
+    }
+
+    CHECK(vector[999] == 999);
+
+    std::vector<char, pl::aligned_allocator<char, 4096U>> page{};
+    page.resize(pl::huge_page_size);
+    CHECK(pl::test::is_aligned(page.data(), 4096U));
+    page.back() = 'a';
+    page.clear();
+    page.shrink_to_fit();
+
+    const pl::aligned_allocator<int>    a{};
+    const pl::aligned_allocator<double> b{a};
+    CHECK(a == b);
+    CHECK_FALSE(a != b);
+}
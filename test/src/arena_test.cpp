@@ -0,0 +1,197 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/alloca.hpp"           // PL_ALLOCA
+#include "../../include/pl/arena.hpp"            // pl::arena, pl::arena_allocator
+#include "../../include/pl/raw_memory_array.hpp" // pl::raw_memory_array
+#include <cstddef>                               // std::size_t
+#include <cstdint>                               // std::uintptr_t
+#include <list>                                  // std::list
+#include <string>                                // std::string
+#include <vector>                                // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+bool is_aligned(const void* pointer, std::size_t alignment)
+{
+    return (reinterpret_cast<std::uintptr_t>(pointer) % alignment) == 0U;
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("arena_allocate_test")
+{
+    pl::arena arena{64U};
+    CHECK(arena.bytes_used() == 0U);
+    CHECK(arena.capacity() == 0U);
+    CHECK(arena.block_count() == 0U);
+
+    char* const a{static_cast<char*>(arena.allocate(10U, 1U))};
+    char* const b{static_cast<char*>(arena.allocate(6U, 1U))};
+    CHECK(b == a + 10);
+    CHECK(arena.bytes_used() == 16U);
+    CHECK(arena.block_count() == 1U);
+    CHECK(arena.capacity() == 64U);
+
+    void* const aligned{arena.allocate(8U, 32U)};
+    CHECK(pl::test::is_aligned(aligned, 32U));
+
+    // larger than a block.
+    void* const big{arena.allocate(1000U)};
+    CHECK(big != nullptr);
+    CHECK(arena.block_count() == 2U);
+    CHECK(arena.capacity() >= 1064U);
+    CHECK(arena.high_water_mark() == arena.bytes_used());
+}
+
+TEST_CASE("arena_create_test")
+{
+    pl::arena          arena{};
+    std::string* const string{arena.create<std::string>(3U, 'a')};
+    CHECK(*string == "aaa");
+    CHECK(pl::test::is_aligned(string, alignof(std::string)));
+    string->~basic_string();
+
+    int* const i{arena.create<int>(42)};
+    CHECK(*i == 42);
+}
+
+TEST_CASE("arena_default_block_size_test")
+{
+    // binds a reference, which requires a definition in C++14.
+    const std::size_t& block_size{pl::arena::default_block_size};
+    CHECK(block_size == 4096U);
+}
+
+TEST_CASE("arena_reset_test")
+{
+    pl::arena arena{128U};
+
+    for (int i{0}; i < 10; ++i) {
+        (void)arena.allocate(100U);
+    }
+
+    const std::size_t blocks{arena.block_count()};
+    const std::size_t capacity{arena.capacity()};
+    const std::size_t high_water_mark{arena.high_water_mark()};
+    CHECK(blocks == 10U);
+
+    arena.reset();
+    CHECK(arena.bytes_used() == 0U);
+    CHECK(arena.high_water_mark() == high_water_mark);
+
+    // the blocks are reused after a reset.
+    for (int i{0}; i < 10; ++i) {
+        (void)arena.allocate(100U);
+    }
+
+    CHECK(arena.block_count() == blocks);
+    CHECK(arena.capacity() == capacity);
+
+    arena.release();
+    CHECK(arena.block_count() == 0U);
+    CHECK(arena.capacity() == 0U);
+    CHECK(arena.bytes_used() == 0U);
+    (void)arena.allocate(1U);
+    CHECK(arena.block_count() == 1U);
+}
+
+TEST_CASE("arena_initial_buffer_test")
+{
+    static constexpr std::size_t size{256U};
+    void* const                  buffer{PL_ALLOCA(size)};
+    pl::arena                    arena{buffer, size};
+    CHECK(arena.capacity() == size);
+
+    void* const first{arena.allocate(100U)};
+    CHECK(first == buffer);
+    (void)arena.allocate(100U);
+    CHECK(arena.block_count() == 0U);
+
+    (void)arena.allocate(100U);
+    CHECK(arena.block_count() == 1U);
+
+    arena.reset();
+    CHECK(arena.allocate(100U) == buffer);
+
+    arena.release();
+    CHECK(arena.capacity() == size);
+    CHECK(arena.allocate(10U) == buffer);
+}
+
+TEST_CASE("arena_allocator_test")
+{
+    pl::arena                                  arena{};
+    pl::arena_allocator<int>                   allocator{arena};
+    std::vector<int, pl::arena_allocator<int>> vector{allocator};
+
+    for (int i{0}; i < 100; ++i) {
+        vector.push_back(i);
+    }
+
+    CHECK(vector.size() == 100U);
+    CHECK(vector[99] == 99);
+    CHECK(arena.bytes_used() >= 100U * sizeof(int));
+
+    // std::list rebinds the allocator to its node type.
+    std::list<int, pl::arena_allocator<int>> list{allocator};
+    list.push_back(1);
+    list.push_back(2);
+    CHECK(list.size() == 2U);
+
+    const pl::arena_allocator<double> rebound{allocator};
+    CHECK(rebound == allocator);
+    CHECK(&rebound.arena() == &arena);
+
+    pl::arena                         other_arena{};
+    const pl::arena_allocator<double> other{other_arena};
+    CHECK(other != allocator);
+}
+
+TEST_CASE("arena_raw_memory_array_test")
+{
+    static constexpr std::size_t count{16U};
+    pl::arena                    arena{};
+    pl::raw_memory_array<int>    array{
+        arena.allocate(count * sizeof(int), alignof(int)),
+        count * sizeof(int),
+        7};
+
+    CHECK(array.size() == count);
+    CHECK(array.front() == 7);
+    CHECK(array.back() == 7);
+}
@@ -33,9 +33,13 @@
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif // PL_COMPILER == PL_COMPILER_GCC
-#include "../../include/pl/bit.hpp" // pl::set_bit, pl::clear_bit, pl::toggle_bit, pl::is_bit_set, pl::bit_cast
-#include <climits> // CHAR_BIT
-#include <cstdint> // std::uint8_t
+#include "../../include/pl/bit.hpp"     // pl::set_bit, pl::clear_bit, pl::toggle_bit, pl::is_bit_set, pl::bit_cast, pl::popcount, pl::countl_zero, pl::countr_zero, pl::rotl, pl::rotr, pl::bit_floor, pl::bit_ceil, pl::pdep, pl::pext, pl::select_bit, pl::select_byte
+#include "../include/static_assert.hpp" // PL_TEST_STATIC_ASSERT
+#include <ciso646>                      // and
+#include <climits>                      // CHAR_BIT
+#include <cstdint>                      // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, UINT32_C, UINT64_C
+#include <initializer_list>             // std::initializer_list
+#include <limits>                       // std::numeric_limits
 
 TEST_CASE("bits_test")
 {
@@ -69,3 +73,210 @@ TEST_CASE("bit_cast")
     const std::uint32_t v{pl::bit_cast<std::uint32_t>(2.0F)};
     CHECK(v == UINT32_C(0x40000000));
 }
+
+namespace pl {
+namespace test {
+namespace {
+/*!
+ * \brief Values covering single bits, runs of bits and mixed patterns.
+**/
+constexpr std::uint64_t bit_test_values[]{UINT64_C(0),
+                                          UINT64_C(1),
+                                          UINT64_C(2),
+                                          UINT64_C(3),
+                                          UINT64_C(0x80),
+                                          UINT64_C(0xFF),
+                                          UINT64_C(0x1234),
+                                          UINT64_C(0x8000),
+                                          UINT64_C(0xFFFF),
+                                          UINT64_C(0x80000000),
+                                          UINT64_C(0xDEADBEEF),
+                                          UINT64_C(0xFFFFFFFF),
+                                          UINT64_C(0x0123456789ABCDEF),
+                                          UINT64_C(0x8000000000000000),
+                                          UINT64_C(0xF0F0F0F0F0F0F0F0),
+                                          UINT64_C(0xFFFFFFFFFFFFFFFF)};
+
+template<typename Unsigned>
+int naive_popcount(Unsigned value)
+{
+    int count{0};
+
+    for (int i{0}; i < std::numeric_limits<Unsigned>::digits; ++i) {
+        count += static_cast<int>((value >> i) & 1U);
+    }
+
+    return count;
+}
+
+template<typename Unsigned>
+int naive_countl_zero(Unsigned value)
+{
+    int count{0};
+
+    for (int i{std::numeric_limits<Unsigned>::digits - 1};
+         (i >= 0) and (((value >> i) & 1U) == 0U);
+         --i) {
+        ++count;
+    }
+
+    return count;
+}
+
+template<typename Unsigned>
+int naive_countr_zero(Unsigned value)
+{
+    int count{0};
+
+    for (int i{0}; (i < std::numeric_limits<Unsigned>::digits)
+                   and (((value >> i) & 1U) == 0U);
+         ++i) {
+        ++count;
+    }
+
+    return count;
+}
+
+template<typename Unsigned>
+Unsigned naive_pdep(Unsigned value, Unsigned mask)
+{
+    Unsigned result{0U};
+    int      next{0};
+
+    for (int i{0}; i < std::numeric_limits<Unsigned>::digits; ++i) {
+        if (((mask >> i) & 1U) != 0U) {
+            if (((value >> next) & 1U) != 0U) {
+                result = static_cast<Unsigned>(result | (Unsigned{1U} << i));
+            }
+
+            ++next;
+        }
+    }
+
+    return result;
+}
+
+template<typename Unsigned>
+Unsigned naive_pext(Unsigned value, Unsigned mask)
+{
+    Unsigned result{0U};
+    int      next{0};
+
+    for (int i{0}; i < std::numeric_limits<Unsigned>::digits; ++i) {
+        if (((mask >> i) & 1U) != 0U) {
+            if (((value >> i) & 1U) != 0U) {
+                result
+                    = static_cast<Unsigned>(result | (Unsigned{1U} << next));
+            }
+
+            ++next;
+        }
+    }
+
+    return result;
+}
+
+/*!
+ * \brief Checks the bit manipulation functions against naive
+ *        implementations for all the test values truncated to Unsigned.
+**/
+template<typename Unsigned>
+void check_bit_functions()
+{
+    constexpr int digits{std::numeric_limits<Unsigned>::digits};
+
+    for (std::uint64_t wide_value : bit_test_values) {
+        const Unsigned value{static_cast<Unsigned>(wide_value)};
+
+        CHECK(pl::popcount(value) == naive_popcount(value));
+        CHECK(pl::countl_zero(value) == naive_countl_zero(value));
+        CHECK(pl::countr_zero(value) == naive_countr_zero(value));
+        CHECK(
+            pl::countl_one(value)
+            == naive_countl_zero(static_cast<Unsigned>(~value)));
+        CHECK(
+            pl::countr_one(value)
+            == naive_countr_zero(static_cast<Unsigned>(~value)));
+        CHECK(pl::bit_width(value) == digits - naive_countl_zero(value));
+        CHECK(pl::has_single_bit(value) == (naive_popcount(value) == 1));
+
+        for (int shift : {0, 1, 3, digits - 1, digits, digits + 5, -1, -7}) {
+            const Unsigned rotated_left{pl::rotl(value, shift)};
+            CHECK(pl::rotr(rotated_left, shift) == value);
+            CHECK(pl::rotl(value, -shift) == pl::rotr(value, shift));
+            CHECK(pl::popcount(rotated_left) == pl::popcount(value));
+        }
+
+        if (value != 0U) {
+            const Unsigned floor{pl::bit_floor(value)};
+            CHECK(pl::has_single_bit(floor));
+            CHECK(floor <= value);
+            CHECK(value / 2U < floor);
+        }
+
+        if (pl::bit_width(value) < digits) {
+            const Unsigned ceil{pl::bit_ceil(value)};
+            CHECK(pl::has_single_bit(ceil));
+            CHECK(ceil >= value);
+            CHECK(ceil / 2U < (value == 0U ? 1U : value));
+        }
+
+        for (std::uint64_t wide_mask : bit_test_values) {
+            const Unsigned mask{static_cast<Unsigned>(wide_mask)};
+            CHECK(pl::pdep(value, mask) == naive_pdep(value, mask));
+            CHECK(pl::pext(value, mask) == naive_pext(value, mask));
+        }
+
+        int n{0};
+
+        for (int i{0}; i < digits; ++i) {
+            if (((value >> i) & 1U) != 0U) {
+                CHECK(pl::select_bit(value, n) == i);
+                ++n;
+            }
+        }
+
+        CHECK(pl::select_bit(value, n) == digits);
+        CHECK(pl::select_bit(value, -1) == digits);
+    }
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("bit_manipulation_constexpr_test")
+{
+    PL_TEST_STATIC_ASSERT(pl::popcount(UINT64_C(0xF0F0F0F0F0F0F0F0)) == 32);
+    PL_TEST_STATIC_ASSERT(pl::countl_zero(std::uint8_t{1U}) == 7);
+    PL_TEST_STATIC_ASSERT(pl::countl_zero(std::uint32_t{0U}) == 32);
+    PL_TEST_STATIC_ASSERT(pl::countr_zero(UINT64_C(0x100)) == 8);
+    PL_TEST_STATIC_ASSERT(pl::countl_one(std::uint16_t{0xF000U}) == 4);
+    PL_TEST_STATIC_ASSERT(pl::countr_one(std::uint8_t{0x07U}) == 3);
+    PL_TEST_STATIC_ASSERT(
+        pl::rotl(std::uint8_t{0x81U}, 1) == std::uint8_t{0x03U});
+    PL_TEST_STATIC_ASSERT(
+        pl::rotr(UINT32_C(0x12345678), 8) == UINT32_C(0x78123456));
+    PL_TEST_STATIC_ASSERT(pl::has_single_bit(std::uint16_t{0x400U}));
+    PL_TEST_STATIC_ASSERT(pl::bit_width(UINT32_C(5)) == 3);
+    PL_TEST_STATIC_ASSERT(pl::bit_floor(UINT32_C(100)) == UINT32_C(64));
+    PL_TEST_STATIC_ASSERT(pl::bit_ceil(UINT32_C(100)) == UINT32_C(128));
+    PL_TEST_STATIC_ASSERT(pl::bit_ceil(UINT32_C(64)) == UINT32_C(64));
+    PL_TEST_STATIC_ASSERT(
+        pl::pdep(UINT32_C(0x5), UINT32_C(0xF0)) == UINT32_C(0x50));
+    PL_TEST_STATIC_ASSERT(
+        pl::pext(UINT32_C(0xA5), UINT32_C(0xF0)) == UINT32_C(0xA));
+    PL_TEST_STATIC_ASSERT(pl::select_bit(UINT32_C(0x1010), 1) == 12);
+    PL_TEST_STATIC_ASSERT(pl::select_byte(UINT32_C(0x11223344), 2U) == 0x22U);
+}
+
+TEST_CASE("bit_manipulation_test")
+{
+    pl::test::check_bit_functions<std::uint8_t>();
+    pl::test::check_bit_functions<std::uint16_t>();
+    pl::test::check_bit_functions<std::uint32_t>();
+    pl::test::check_bit_functions<std::uint64_t>();
+    pl::test::check_bit_functions<unsigned long>();
+
+    CHECK(pl::select_byte(UINT64_C(0x0123456789ABCDEF), 0U) == 0xEFU);
+    CHECK(pl::select_byte(UINT64_C(0x0123456789ABCDEF), 7U) == 0x01U);
+}
@@ -33,15 +33,17 @@
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif                                // PL_COMPILER == PL_COMPILER_GCC
-#include "../../include/pl/bswap.hpp" // pl::bswap
-#include "../../include/pl/byte.hpp"  // pl::byte
+#include "../../include/pl/bswap.hpp"           // pl::bswap, pl::bswap_n, pl::bswap_inplace
+#include "../../include/pl/byte.hpp"            // pl::byte
 #include "../../include/pl/cont/make_array.hpp" // pl::cont::make_array
-#include "../../include/pl/packed.hpp"  // PL_PACKED_START, PL_PACKED_END
-#include "../include/static_assert.hpp" // PL_TEST_STATIC_ASSERT
-#include <array>                        // std::array
-#include <cstddef>                      // std::size_t
-#include <cstdint>                      // std::uint32_t
-#include <cstring>                      // std::memcpy, std::memcmp
+#include "../../include/pl/cpu_features.hpp"    // pl::simd_level
+#include "../../include/pl/packed.hpp"          // PL_PACKED_START, PL_PACKED_END
+#include "../include/static_assert.hpp"         // PL_TEST_STATIC_ASSERT
+#include <array>                                // std::array
+#include <cstddef>                              // std::size_t
+#include <cstdint>                              // std::uint16_t, std::uint32_t, std::uint64_t, UINT16_C, UINT32_C, UINT64_C
+#include <cstring>                              // std::memcpy, std::memcmp
+#include <vector>                               // std::vector
 
 TEST_CASE("bswap_basic_test")
 {
@@ -230,3 +232,116 @@ TEST_CASE("bswap_struct")
     const buf res{pl::bswap(a)};
     CHECK(std::memcmp(&res, expected, 20) == 0);
 }
+
+namespace {
+/*!
+ * \brief Checks bswap_n against pl::bswap for every simd_level, in place
+ *        and into a different array, for several counts and alignments.
+**/
+template<typename Ty>
+void check_bswap_n()
+{
+    static constexpr std::size_t max_count{200U};
+
+    std::vector<Ty> source(max_count + 1U);
+
+    for (std::size_t i{0U}; i < source.size(); ++i) {
+        const std::uint64_t pattern{
+            (i + 1U) * UINT64_C(0x0102030405060708) ^ UINT64_C(0xA5)};
+        std::memcpy(&source[i], &pattern, sizeof(Ty));
+    }
+
+    for (pl::simd_level level :
+         {pl::simd_level::none,
+          pl::simd_level::sse2,
+          pl::simd_level::ssse3,
+          pl::simd_level::avx2,
+          pl::simd_level::avx512}) {
+        for (std::size_t count : {0U, 1U, 3U, 8U, 17U, 64U, 199U}) {
+            // start one element in to also use unaligned addresses.
+            for (std::size_t offset : {0U, 1U}) {
+                std::vector<Ty> expected(source);
+
+                for (std::size_t i{offset}; i < offset + count; ++i) {
+                    expected[i] = pl::bswap(source[i]);
+                }
+
+                std::vector<Ty> destination(source);
+                Ty* const       end{pl::bswap_n(
+                    destination.data() + offset,
+                    source.data() + offset,
+                    count,
+                    level)};
+                CHECK(end == destination.data() + offset + count);
+                CHECK(
+                    std::memcmp(
+                        destination.data(),
+                        expected.data(),
+                        source.size() * sizeof(Ty))
+                    == 0);
+
+                std::vector<Ty> in_place(source);
+                (void)pl::bswap_n(
+                    in_place.data() + offset,
+                    in_place.data() + offset,
+                    count,
+                    level);
+                CHECK(
+                    std::memcmp(
+                        in_place.data(),
+                        expected.data(),
+                        source.size() * sizeof(Ty))
+                    == 0);
+            }
+        }
+    }
+}
+} // anonymous namespace
+
+TEST_CASE("bswap_n_test")
+{
+    check_bswap_n<std::uint8_t>();
+    check_bswap_n<std::uint16_t>();
+    check_bswap_n<std::int16_t>();
+    check_bswap_n<std::uint32_t>();
+    check_bswap_n<std::int32_t>();
+    check_bswap_n<float>();
+    check_bswap_n<std::uint64_t>();
+    check_bswap_n<std::int64_t>();
+    check_bswap_n<double>();
+}
+
+TEST_CASE("bswap_inplace_test")
+{
+    SUBCASE("pointer and count")
+    {
+        std::uint32_t values[]{
+            UINT32_C(0x11223344), UINT32_C(0xAABBCCDD), UINT32_C(0x01020304)};
+        std::uint32_t* const end{pl::bswap_inplace(values, 2U)};
+
+        CHECK(end == values + 2);
+        CHECK(values[0U] == UINT32_C(0x44332211));
+        CHECK(values[1U] == UINT32_C(0xDDCCBBAA));
+        CHECK(values[2U] == UINT32_C(0x01020304));
+    }
+
+    SUBCASE("built-in array")
+    {
+        std::uint16_t values[]{UINT16_C(0x1234), UINT16_C(0xABCD)};
+        (void)pl::bswap_inplace(values);
+
+        CHECK(values[0U] == UINT16_C(0x3412));
+        CHECK(values[1U] == UINT16_C(0xCDAB));
+    }
+
+    SUBCASE("std::vector")
+    {
+        std::vector<std::uint64_t> values(
+            100U, UINT64_C(0x0102030405060708));
+        (void)pl::bswap_inplace(values);
+
+        for (std::uint64_t value : values) {
+            CHECK(value == UINT64_C(0x0807060504030201));
+        }
+    }
+}
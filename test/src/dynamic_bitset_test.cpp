@@ -0,0 +1,293 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif                                // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/dynamic_bitset.hpp" // pl::dynamic_bitset
+#include <cstddef>                             // std::size_t
+#include <cstdint>                             // std::uint64_t, UINT64_C
+#include <initializer_list>                    // std::initializer_list
+#include <vector>                              // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+/*!
+ * \brief Creates a pseudo random pattern of 'size' bits from 'seed'.
+**/
+std::vector<bool> random_bits(std::size_t size, std::uint64_t seed)
+{
+    std::vector<bool> bits(size);
+
+    for (std::size_t i{0U}; i < size; ++i) {
+        seed = (seed * UINT64_C(6364136223846793005))
+               + UINT64_C(1442695040888963407);
+        bits[i] = (seed >> 61U) < 3U;
+    }
+
+    return bits;
+}
+
+pl::dynamic_bitset to_bitset(const std::vector<bool>& bits)
+{
+    pl::dynamic_bitset result(bits.size());
+
+    for (std::size_t i{0U}; i < bits.size(); ++i) {
+        result.set(i, bits[i]);
+    }
+
+    return result;
+}
+
+bool equals(const pl::dynamic_bitset& bitset, const std::vector<bool>& bits)
+{
+    if (bitset.size() != bits.size()) {
+        return false;
+    }
+
+    for (std::size_t i{0U}; i < bits.size(); ++i) {
+        if (bitset[i] != bits[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Checks that the bits beyond size() in the last word are 0.
+**/
+bool unused_bits_clear(const pl::dynamic_bitset& bitset)
+{
+    const std::size_t used_bits{bitset.size() % 64U};
+    return (used_bits == 0U)
+           or ((bitset.data()[bitset.word_count() - 1U] >> used_bits) == 0U);
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("dynamic_bitset_construction_test")
+{
+    const pl::dynamic_bitset empty{};
+    CHECK(empty.empty());
+    CHECK(empty.size() == 0U);
+    CHECK(empty.count() == 0U);
+    CHECK(empty.none());
+    CHECK(empty.all());
+    CHECK(empty.find_first() == pl::dynamic_bitset::npos);
+
+    const pl::dynamic_bitset zeros(130U);
+    CHECK(zeros.size() == 130U);
+    CHECK(zeros.word_count() == 3U);
+    CHECK(zeros.none());
+
+    const pl::dynamic_bitset ones(130U, true);
+    CHECK(ones.count() == 130U);
+    CHECK(ones.all());
+    CHECK(pl::test::unused_bits_clear(ones));
+    CHECK(~ones == zeros);
+}
+
+TEST_CASE("dynamic_bitset_single_bit_test")
+{
+    pl::dynamic_bitset bitset(100U);
+
+    bitset.set(0U).set(63U).set(64U).set(99U);
+    CHECK(bitset.test(0U));
+    CHECK(bitset.test(63U));
+    CHECK(bitset.test(64U));
+    CHECK(bitset.test(99U));
+    CHECK_FALSE(bitset.test(1U));
+    CHECK(bitset.count() == 4U);
+
+    bitset.reset(63U);
+    CHECK_FALSE(bitset[63U]);
+    bitset.flip(63U).flip(64U);
+    CHECK(bitset[63U]);
+    CHECK_FALSE(bitset[64U]);
+    bitset.set(5U, false);
+    CHECK_FALSE(bitset[5U]);
+
+    bitset.flip();
+    CHECK(bitset.count() == 97U);
+    CHECK(pl::test::unused_bits_clear(bitset));
+    bitset.reset();
+    CHECK(bitset.none());
+    bitset.set();
+    CHECK(bitset.all());
+    CHECK(pl::test::unused_bits_clear(bitset));
+}
+
+TEST_CASE("dynamic_bitset_resize_test")
+{
+    pl::dynamic_bitset bitset(10U, true);
+
+    bitset.resize(70U);
+    CHECK(bitset.count() == 10U);
+
+    bitset.resize(150U, true);
+    CHECK(bitset.count() == 90U);
+    CHECK_FALSE(bitset[10U]);
+    CHECK_FALSE(bitset[69U]);
+    CHECK(bitset[70U]);
+    CHECK(bitset[149U]);
+
+    bitset.resize(65U);
+    CHECK(bitset.size() == 65U);
+    CHECK(bitset.count() == 10U);
+    CHECK(pl::test::unused_bits_clear(bitset));
+
+    bitset.push_back(true);
+    CHECK(bitset.size() == 66U);
+    CHECK(bitset[65U]);
+
+    bitset.clear();
+    CHECK(bitset.empty());
+}
+
+TEST_CASE("dynamic_bitset_range_test")
+{
+    for (std::size_t first : {0U, 1U, 63U, 64U, 65U, 100U}) {
+        for (std::size_t last :
+             {first, first + 1U, std::size_t{64U}, std::size_t{200U}}) {
+            if (last < first) {
+                continue;
+            }
+
+            std::vector<bool> expected(
+                pl::test::random_bits(200U, first * 1000U + last));
+            pl::dynamic_bitset bitset{pl::test::to_bitset(expected)};
+
+            for (std::size_t i{first}; i < last; ++i) {
+                expected[i] = true;
+            }
+
+            bitset.set_range(first, last);
+            CHECK(pl::test::equals(bitset, expected));
+
+            for (std::size_t i{first}; i < last; ++i) {
+                expected[i] = false;
+            }
+
+            bitset.reset_range(first, last);
+            CHECK(pl::test::equals(bitset, expected));
+        }
+    }
+}
+
+TEST_CASE("dynamic_bitset_set_operations_test")
+{
+    for (std::size_t size : {1U, 63U, 64U, 65U, 1000U, 4099U}) {
+        const std::vector<bool> a(pl::test::random_bits(size, 1U));
+        const std::vector<bool> b(pl::test::random_bits(size, 2U));
+
+        std::vector<bool> expected_and(size);
+        std::vector<bool> expected_or(size);
+        std::vector<bool> expected_xor(size);
+        std::vector<bool> expected_and_not(size);
+        std::size_t       expected_count{0U};
+
+        for (std::size_t i{0U}; i < size; ++i) {
+            expected_and[i]     = a[i] and b[i];
+            expected_or[i]      = a[i] or b[i];
+            expected_xor[i]     = a[i] != b[i];
+            expected_and_not[i] = a[i] and (not b[i]);
+            expected_count += a[i] ? 1U : 0U;
+        }
+
+        const pl::dynamic_bitset bitset_a{pl::test::to_bitset(a)};
+        const pl::dynamic_bitset bitset_b{pl::test::to_bitset(b)};
+
+        CHECK(bitset_a.count() == expected_count);
+        CHECK(pl::test::equals(bitset_a & bitset_b, expected_and));
+        CHECK(pl::test::equals(bitset_a | bitset_b, expected_or));
+        CHECK(pl::test::equals(bitset_a ^ bitset_b, expected_xor));
+
+        pl::dynamic_bitset difference{bitset_a};
+        difference.and_not(bitset_b);
+        CHECK(pl::test::equals(difference, expected_and_not));
+        CHECK(pl::test::unused_bits_clear(~bitset_a));
+
+        CHECK(bitset_a == pl::test::to_bitset(a));
+        CHECK((bitset_a != bitset_b) == (a != b));
+    }
+}
+
+TEST_CASE("dynamic_bitset_find_test")
+{
+    const std::vector<bool> bits(pl::test::random_bits(1000U, 3U));
+    pl::dynamic_bitset      bitset{pl::test::to_bitset(bits)};
+    std::vector<std::size_t> expected{};
+
+    for (std::size_t i{0U}; i < bits.size(); ++i) {
+        if (bits[i]) {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<std::size_t> found{};
+
+    for (std::size_t i{bitset.find_first()}; i != pl::dynamic_bitset::npos;
+         i = bitset.find_next(i)) {
+        found.push_back(i);
+    }
+
+    CHECK(found == expected);
+
+    std::vector<std::size_t> visited{};
+    bitset.for_each_set([&visited](std::size_t i) { visited.push_back(i); });
+    CHECK(visited == expected);
+
+    bitset.reset();
+    CHECK(bitset.find_first() == pl::dynamic_bitset::npos);
+    bitset.set(999U);
+    CHECK(bitset.find_first() == 999U);
+    CHECK(bitset.find_next(999U) == pl::dynamic_bitset::npos);
+    CHECK(
+        bitset.find_next(pl::dynamic_bitset::npos) == pl::dynamic_bitset::npos);
+    CHECK(bitset.find_next(bitset.size()) == pl::dynamic_bitset::npos);
+    CHECK(bitset.find_next(500U) == 999U);
+}
+
+TEST_CASE("dynamic_bitset_swap_test")
+{
+    pl::dynamic_bitset a(10U, true);
+    pl::dynamic_bitset b(70U);
+
+    swap(a, b);
+    CHECK(a.size() == 70U);
+    CHECK(a.none());
+    CHECK(b.size() == 10U);
+    CHECK(b.all());
+}
@@ -0,0 +1,204 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif                                // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/byte.hpp"    // pl::byte
+#include "../../include/pl/endian.hpp"  // pl::endian, pl::big_endian, pl::little_endian, pl::overlay
+#include "../../include/pl/packed.hpp"  // PL_PACKED_START, PL_PACKED_END
+#include "../include/static_assert.hpp" // PL_TEST_STATIC_ASSERT
+#include <cstdint>                      // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::int16_t
+#include <cstring>                      // std::memcpy, std::memcmp
+#include <type_traits>                  // std::is_trivial
+
+namespace pl {
+namespace test {
+namespace {
+PL_PACKED_START
+/*!
+ * \brief The header of a made up big endian network protocol.
+**/
+struct wire_header {
+    pl::big_endian<std::uint16_t> type;
+    pl::big_endian<std::uint32_t> length;
+    pl::byte                      flags;
+    pl::big_endian<std::uint64_t> sequence;
+};
+PL_PACKED_END
+
+enum class message_kind : std::uint16_t { ping = 0x0102, pong = 0x0304 };
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("endian_native_test")
+{
+    const std::uint32_t value{UINT32_C(0x01020304)};
+    unsigned char       bytes[sizeof(value)];
+    std::memcpy(bytes, &value, sizeof(value));
+
+    if (pl::endian::native == pl::endian::little) {
+        CHECK(bytes[0U] == 0x04U);
+    }
+    else {
+        CHECK(bytes[0U] == 0x01U);
+    }
+}
+
+TEST_CASE("endian_value_layout_test")
+{
+    PL_TEST_STATIC_ASSERT(sizeof(pl::big_endian<std::uint32_t>) == 4U);
+    PL_TEST_STATIC_ASSERT(alignof(pl::big_endian<std::uint64_t>) == 1U);
+    PL_TEST_STATIC_ASSERT(sizeof(pl::little_endian<double>) == 8U);
+    PL_TEST_STATIC_ASSERT(
+        std::is_trivial<pl::little_endian<std::uint16_t>>::value);
+    PL_TEST_STATIC_ASSERT(sizeof(pl::test::wire_header) == 15U);
+    PL_TEST_STATIC_ASSERT(alignof(pl::test::wire_header) == 1U);
+}
+
+TEST_CASE("endian_value_test")
+{
+    SUBCASE("big_endian")
+    {
+        const pl::big_endian<std::uint32_t> value{UINT32_C(0x11223344)};
+        const unsigned char expected[]{0x11U, 0x22U, 0x33U, 0x44U};
+
+        CHECK(std::memcmp(value.data(), expected, sizeof(expected)) == 0);
+        CHECK(value.value() == UINT32_C(0x11223344));
+        CHECK(static_cast<std::uint32_t>(value) == UINT32_C(0x11223344));
+    }
+
+    SUBCASE("little_endian")
+    {
+        pl::little_endian<std::uint16_t> value{};
+        value = UINT16_C(0xABCD);
+        const unsigned char expected[]{0xCDU, 0xABU};
+
+        CHECK(std::memcmp(value.data(), expected, sizeof(expected)) == 0);
+        CHECK(value == UINT16_C(0xABCD));
+    }
+
+    SUBCASE("signed")
+    {
+        const pl::big_endian<std::int16_t> value{std::int16_t{-2}};
+        const unsigned char                expected[]{0xFFU, 0xFEU};
+
+        CHECK(std::memcmp(value.data(), expected, sizeof(expected)) == 0);
+        CHECK(value.value() == -2);
+    }
+
+    SUBCASE("floating point")
+    {
+        const double                 original{1.5};
+        const pl::big_endian<double> value{original};
+
+        const double result{value.value()};
+        CHECK(std::memcmp(&result, &original, sizeof(original)) == 0);
+    }
+
+    SUBCASE("enumeration")
+    {
+        const pl::big_endian<pl::test::message_kind> value{
+            pl::test::message_kind::pong};
+        const unsigned char expected[]{0x03U, 0x04U};
+
+        CHECK(std::memcmp(value.data(), expected, sizeof(expected)) == 0);
+        CHECK(value.value() == pl::test::message_kind::pong);
+    }
+
+    SUBCASE("comparison")
+    {
+        const pl::big_endian<std::uint64_t> a{UINT64_C(1)};
+        const pl::big_endian<std::uint64_t> b{UINT64_C(1)};
+        const pl::big_endian<std::uint64_t> c{UINT64_C(2)};
+
+        CHECK(a == b);
+        CHECK_FALSE(a != b);
+        CHECK(a != c);
+        CHECK_FALSE(a == c);
+    }
+}
+
+TEST_CASE("overlay_test")
+{
+    unsigned char buffer[]{0x00U,
+                           0x07U,
+                           0x00U,
+                           0x00U,
+                           0x01U,
+                           0x00U,
+                           0x80U,
+                           0x00U,
+                           0x00U,
+                           0x00U,
+                           0x00U,
+                           0x00U,
+                           0x00U,
+                           0x00U,
+                           0x2AU,
+                           0xEEU};
+
+    SUBCASE("read")
+    {
+        const pl::test::wire_header* const header{
+            pl::overlay<pl::test::wire_header>(
+                static_cast<const void*>(buffer), sizeof(buffer))};
+        REQUIRE(header != nullptr);
+        CHECK(static_cast<const void*>(header) == buffer);
+        CHECK(header->type == 7U);
+        CHECK(header->length == UINT32_C(256));
+        CHECK(header->flags == pl::byte{0x80U});
+        CHECK(header->sequence == UINT64_C(42));
+    }
+
+    SUBCASE("write")
+    {
+        pl::test::wire_header* const header{
+            pl::overlay<pl::test::wire_header>(buffer, sizeof(buffer))};
+        REQUIRE(header != nullptr);
+        header->length = UINT32_C(0x0A0B0C0D);
+
+        CHECK(buffer[2U] == 0x0AU);
+        CHECK(buffer[3U] == 0x0BU);
+        CHECK(buffer[4U] == 0x0CU);
+        CHECK(buffer[5U] == 0x0DU);
+        CHECK(buffer[15U] == 0xEEU);
+    }
+
+    SUBCASE("too small")
+    {
+        CHECK(
+            pl::overlay<pl::test::wire_header>(buffer, sizeof(buffer) - 2U)
+            == nullptr);
+    }
+}
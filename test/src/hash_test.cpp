@@ -33,14 +33,24 @@
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif                               // PL_COMPILER == PL_COMPILER_GCC
-#include "../../include/pl/hash.hpp" // pl::hash
-#include <ciso646>                   // and
-#include <cstddef>                   // std::size_t
-#include <functional>                // std::hash
-#include <iterator>                  // std::end
-#include <string>                    // std::string
-#include <unordered_set>             // std::unordered_set
-#include <utility>                   // std::move
+#include "../../include/pl/hash.hpp"         // pl::hash, pl::hash_bytes, pl::crc32c, pl::hash_range
+#include "../../include/pl/cpu_features.hpp" // pl::detected_cpu_features, PL_CPU_X86
+#include "../include/static_assert.hpp"      // PL_TEST_STATIC_ASSERT
+#include <array>                             // std::array
+#include <ciso646>                           // and, not
+#include <cstddef>                           // std::size_t
+#include <cstdint>                           // std::uint32_t, std::uint64_t
+#include <cstring>                           // std::strlen
+#include <functional>                        // std::hash
+#include <iterator>                          // std::begin, std::end
+#include <list>                              // std::list
+#include <set>                               // std::set
+#include <string>                            // std::string
+#include <tuple>                             // std::tuple, std::make_tuple
+#include <type_traits>                       // std::true_type
+#include <unordered_set>                     // std::unordered_set
+#include <utility>                           // std::move, std::pair
+#include <vector>                            // std::vector
 
 namespace pl {
 namespace test {
@@ -131,3 +141,384 @@ TEST_CASE("hash_unordered_set_test")
     set.emplace("hash_test", 50);
     CHECK(set.find(pl::test::hashable{"hash_test", 50}) != std::end(set));
 }
+
+namespace pl {
+namespace test {
+namespace {
+/*!
+ * \brief Returns 'size' pseudo random bytes.
+**/
+std::vector<unsigned char> random_bytes(std::size_t size)
+{
+    std::vector<unsigned char> bytes(size);
+    std::uint64_t              state{0x0123456789ABCDEFULL};
+
+    for (unsigned char& byte : bytes) {
+        state = pl::mix64(state + 0x9E3779B97F4A7C15ULL);
+        byte  = static_cast<unsigned char>(state);
+    }
+
+    return bytes;
+}
+
+/*!
+ * \brief Returns the amount of set bits in 'value'.
+**/
+int bit_count(std::uint64_t value)
+{
+    int result{0};
+
+    for (; value != 0U; value &= value - 1U) {
+        ++result;
+    }
+
+    return result;
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("hash_combine_test")
+{
+    std::size_t a{0U};
+    pl::hash_combine(a, 1U);
+    pl::hash_combine(a, 2U);
+
+    std::size_t b{0U};
+    pl::hash_combine(b, 2U);
+    pl::hash_combine(b, 1U);
+
+    CHECK(a != b);
+    CHECK(pl::hash(1, 2) == a);
+
+    SUBCASE("small integers spread over the low bits")
+    {
+        std::set<std::size_t> buckets{};
+
+        for (int i{0}; i < 1024; ++i) {
+            buckets.insert(pl::hash(i) & 0xFFU);
+        }
+
+        CHECK(buckets.size() > 240U);
+    }
+}
+
+TEST_CASE("mix64_test")
+{
+    CHECK(pl::mix64(1U) != pl::mix64(2U));
+
+    // every input bit flips about half of the output bits.
+    for (int bit{0}; bit < 64; ++bit) {
+        int flipped{0};
+
+        for (std::uint64_t i{1U}; i <= 256U; ++i) {
+            const std::uint64_t input{pl::mix64(i)};
+            flipped += pl::test::bit_count(
+                pl::mix64(input) ^ pl::mix64(input ^ (1ULL << bit)));
+        }
+
+        CHECK(flipped > 256 * 28);
+        CHECK(flipped < 256 * 36);
+    }
+}
+
+TEST_CASE("multiply_128_test")
+{
+    const std::vector<std::uint64_t> values{0U,
+                                            1U,
+                                            0xFFFFFFFFU,
+                                            0x100000000ULL,
+                                            0xFFFFFFFFFFFFFFFFULL,
+                                            0x0123456789ABCDEFULL,
+                                            0xFEDCBA9876543210ULL};
+
+    for (std::uint64_t x : values) {
+        for (std::uint64_t y : values) {
+            std::uint64_t low{x};
+            std::uint64_t high{y};
+            pl::detail::multiply_128(low, high);
+
+            std::uint64_t portable_low{x};
+            std::uint64_t portable_high{y};
+            pl::detail::multiply_128_portable(portable_low, portable_high);
+
+            CHECK(low == x * y);
+            CHECK(low == portable_low);
+            CHECK(high == portable_high);
+        }
+    }
+
+    std::uint64_t low{0xFFFFFFFFFFFFFFFFULL};
+    std::uint64_t high{0xFFFFFFFFFFFFFFFFULL};
+    pl::detail::multiply_128_portable(low, high);
+    CHECK(low == 1U);
+    CHECK(high == 0xFFFFFFFFFFFFFFFEULL);
+}
+
+TEST_CASE("hash_bytes_test")
+{
+    const std::vector<unsigned char> bytes{pl::test::random_bytes(300U)};
+
+    CHECK(pl::hash_bytes(nullptr, 0U) == pl::hash_bytes(bytes.data(), 0U));
+    CHECK(pl::hash_bytes(bytes.data(), 0U) != pl::hash_bytes(bytes.data(), 1U));
+    CHECK(
+        pl::hash_bytes(bytes.data(), bytes.size(), 1U)
+        != pl::hash_bytes(bytes.data(), bytes.size(), 2U));
+
+    SUBCASE("equal content yields equal hashes")
+    {
+        const std::string a{"The quick brown fox jumps over the lazy dog"};
+        const std::string b{a};
+
+        CHECK(pl::hash_bytes(a.data(), a.size()) == pl::hash_bytes(b.data(), b.size()));
+    }
+
+    SUBCASE("prefixes have distinct hashes")
+    {
+        std::set<std::uint64_t> hashes{};
+
+        for (std::size_t size{0U}; size <= bytes.size(); ++size) {
+            hashes.insert(pl::hash_bytes(bytes.data(), size));
+        }
+
+        CHECK(hashes.size() == bytes.size() + 1U);
+    }
+
+    SUBCASE("every input bit affects the hash")
+    {
+        for (std::size_t size : {std::size_t{1U},
+                                 std::size_t{3U},
+                                 std::size_t{4U},
+                                 std::size_t{8U},
+                                 std::size_t{16U},
+                                 std::size_t{17U},
+                                 std::size_t{48U},
+                                 std::size_t{100U}}) {
+            std::vector<unsigned char> input(
+                bytes.begin(), bytes.begin() + static_cast<long>(size));
+            const std::uint64_t original{pl::hash_bytes(input.data(), size)};
+            int                 flipped{0};
+
+            for (std::size_t bit{0U}; bit < size * 8U; ++bit) {
+                input[bit / 8U] = static_cast<unsigned char>(
+                    input[bit / 8U] ^ (1U << (bit % 8U)));
+                const std::uint64_t changed{pl::hash_bytes(input.data(), size)};
+                input[bit / 8U] = static_cast<unsigned char>(
+                    input[bit / 8U] ^ (1U << (bit % 8U)));
+
+                REQUIRE(changed != original);
+                flipped += pl::test::bit_count(changed ^ original);
+            }
+
+            const int bits{static_cast<int>(size * 8U)};
+            CHECK(flipped > bits * 28);
+            CHECK(flipped < bits * 36);
+        }
+    }
+}
+
+TEST_CASE("crc32c_test")
+{
+    const char* const check{"123456789"};
+
+    CHECK(pl::crc32c(nullptr, 0U) == 0U);
+    CHECK(pl::crc32c(check, std::strlen(check)) == 0xE3069283U);
+    CHECK(pl::crc32c("a", 1U) == 0xC1D04330U);
+
+    SUBCASE("piecewise")
+    {
+        const std::uint32_t first{pl::crc32c(check, 4U)};
+        CHECK(pl::crc32c(check + 4, 5U, first) == 0xE3069283U);
+    }
+
+    SUBCASE("kernels agree")
+    {
+        const std::vector<unsigned char> bytes{pl::test::random_bytes(300U)};
+
+        for (std::size_t offset{0U}; offset < 8U; ++offset) {
+            for (std::size_t size{0U}; size + offset <= bytes.size();
+                 size += 7U) {
+                const unsigned char* data{bytes.data() + offset};
+                const std::uint32_t  expected{
+                    ~pl::detail::crc32c_software(0xFFFFFFFFU, data, size)};
+
+                CHECK(pl::crc32c(data, size) == expected);
+#if PL_CPU_X86
+                if (pl::detected_cpu_features().sse42) {
+                    CHECK(
+                        ~pl::detail::crc32c_sse42(0xFFFFFFFFU, data, size)
+                        == expected);
+                }
+#endif
+            }
+        }
+    }
+}
+
+namespace pl {
+namespace test {
+namespace {
+enum class color { red, green, blue };
+
+struct packed_pair {
+    std::uint32_t first;
+    std::uint32_t second;
+};
+
+struct padded_pair {
+    std::uint8_t  first;
+    std::uint32_t second;
+};
+} // anonymous namespace
+} // namespace test
+
+template <>
+struct is_uniquely_represented<test::packed_pair> : public std::true_type {
+};
+} // namespace pl
+
+TEST_CASE("is_uniquely_represented_test")
+{
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<int>::value);
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<char>::value);
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<bool>::value);
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<std::uint64_t>::value);
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<pl::test::color>::value);
+    PL_TEST_STATIC_ASSERT(pl::is_uniquely_represented<const int*>::value);
+    PL_TEST_STATIC_ASSERT(
+        pl::is_uniquely_represented<pl::test::packed_pair>::value);
+    PL_TEST_STATIC_ASSERT(not pl::is_uniquely_represented<double>::value);
+    PL_TEST_STATIC_ASSERT(not pl::is_uniquely_represented<float>::value);
+    PL_TEST_STATIC_ASSERT(
+        not pl::is_uniquely_represented<pl::test::padded_pair>::value);
+    PL_TEST_STATIC_ASSERT(not pl::is_uniquely_represented<std::string>::value);
+}
+
+TEST_CASE("hash_range_test")
+{
+    const std::vector<int> vector{1, 2, 3, 4, 5};
+    const int              array[]{1, 2, 3, 4, 5};
+    const std::list<int>   list{1, 2, 3, 4, 5};
+
+    SUBCASE("contiguous ranges of uniquely represented types are hashed as bytes")
+    {
+        const std::size_t expected{static_cast<std::size_t>(
+            pl::hash_bytes(array, sizeof(array)))};
+
+        CHECK(pl::hash_range(vector) == expected);
+        CHECK(pl::hash_range(array) == expected);
+        CHECK(pl::hash_range(std::begin(array), std::end(array)) == expected);
+        CHECK(
+            pl::hash_range(vector.data(), vector.data() + vector.size())
+            == expected);
+        CHECK(
+            pl::hash_range(std::array<int, 5U>{{1, 2, 3, 4, 5}}) == expected);
+
+        const std::string string{"text"};
+        CHECK(
+            pl::hash_range(string)
+            == static_cast<std::size_t>(
+                   pl::hash_bytes(string.data(), string.size())));
+    }
+
+    SUBCASE("the hash only depends on the elements")
+    {
+        const std::size_t expected{static_cast<std::size_t>(
+            pl::hash_bytes(array, sizeof(array)))};
+
+        CHECK(pl::hash_range(list) == expected);
+        CHECK(pl::hash_range(list.begin(), list.end()) == expected);
+        CHECK(pl::hash_range(vector.begin(), vector.end()) == expected);
+        CHECK(pl::hash_range(vector.cbegin(), vector.cend()) == expected);
+#ifdef __cpp_lib_concepts
+        // hashed as a single block of bytes.
+        PL_TEST_STATIC_ASSERT(pl::detail::is_contiguous_iterator<
+                              std::vector<int>::const_iterator>::value);
+#endif
+
+        // crosses the block sizes of hash_bytes.
+        for (std::size_t size{0U}; size < 150U; ++size) {
+            std::vector<unsigned char> bytes(size);
+            std::list<std::uint64_t>   words{};
+
+            for (std::size_t i{0U}; i < size; ++i) {
+                bytes[i] = static_cast<unsigned char>(i * 7U);
+                words.push_back(i * 0x9E3779B97F4A7C15ULL);
+            }
+
+            const std::list<unsigned char> byte_list(bytes.begin(), bytes.end());
+            const std::vector<std::uint64_t> word_vector(
+                words.begin(), words.end());
+
+            CHECK(
+                pl::hash_range(byte_list)
+                == static_cast<std::size_t>(
+                       pl::hash_bytes(bytes.data(), bytes.size())));
+            CHECK(pl::hash_range(words) == pl::hash_range(word_vector));
+        }
+    }
+
+    SUBCASE("other types are hashed element wise")
+    {
+        const std::vector<std::string> strings{"a", "b", "c"};
+        const std::list<std::string>   string_list{"a", "b", "c"};
+        std::size_t                    expected{0U};
+
+        for (const std::string& string : strings) {
+            pl::hash_combine(expected, std::hash<std::string>{}(string));
+        }
+
+        pl::hash_combine(expected, strings.size());
+
+        CHECK(pl::hash_range(strings) == expected);
+        CHECK(pl::hash_range(string_list) == expected);
+        CHECK(pl::hash_range(strings.begin(), strings.end()) == expected);
+
+        const std::vector<std::pair<int, std::string>> pairs{
+            {1, "one"}, {2, "two"}};
+        expected = 0U;
+
+        for (const std::pair<int, std::string>& pair : pairs) {
+            pl::hash_combine(expected, pl::hash(pair.first, pair.second));
+        }
+
+        pl::hash_combine(expected, pairs.size());
+
+        CHECK(pl::hash_range(pairs) == expected);
+        CHECK(
+            pl::hash_range(std::vector<std::tuple<int, char>>{
+                std::make_tuple(1, 'a')})
+            != pl::hash_range(std::vector<std::tuple<int, char>>{
+                   std::make_tuple(1, 'b')}));
+    }
+
+    SUBCASE("floating point ranges are hashed element wise")
+    {
+        const std::vector<double> a{0.0, 1.0};
+        const std::vector<double> b{-0.0, 1.0};
+
+        CHECK(pl::hash_range(a) == pl::hash_range(b));
+    }
+
+    SUBCASE("user defined uniquely represented types")
+    {
+        const std::vector<pl::test::packed_pair> pairs{{1U, 2U}, {3U, 4U}};
+
+        CHECK(
+            pl::hash_range(pairs)
+            == static_cast<std::size_t>(pl::hash_bytes(
+                   pairs.data(), pairs.size() * sizeof(pl::test::packed_pair))));
+    }
+
+    SUBCASE("different ranges yield different hashes")
+    {
+        const std::vector<int> other{1, 2, 3, 4, 6};
+        const std::vector<int> prefix{1, 2, 3, 4};
+        const std::list<int>   list_prefix{1, 2, 3, 4};
+
+        CHECK(pl::hash_range(vector) != pl::hash_range(other));
+        CHECK(pl::hash_range(vector) != pl::hash_range(prefix));
+        CHECK(pl::hash_range(list) != pl::hash_range(list_prefix));
+        CHECK(pl::hash_range(std::vector<int>{}) != pl::hash_range(prefix));
+    }
+}
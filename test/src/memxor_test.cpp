@@ -33,11 +33,14 @@
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif                               // PL_COMPILER == PL_COMPILER_GCC
-#include "../../include/pl/byte.hpp" // pl::byte
+#include "../../include/pl/byte.hpp"            // pl::byte
 #include "../../include/pl/cont/make_array.hpp" // pl::make_array
-#include "../../include/pl/memxor.hpp"          // pl::memxor
+#include "../../include/pl/memxor.hpp"          // pl::memxor, pl::memxor_n
+#include "../../include/pl/cpu_features.hpp"    // pl::simd_level
+#include <algorithm>                            // std::equal
 #include <cstddef>                              // std::size_t
 #include <cstring>                              // std::memcmp
+#include <vector>                               // std::vector
 
 TEST_CASE("memxor_test")
 {
@@ -92,3 +95,146 @@ TEST_CASE("memxor_test")
 
     CHECK(std::memcmp(dest, expected, size) == 0);
 }
+
+TEST_CASE("memxor_simd_test")
+{
+    static constexpr std::size_t max_size{1100U};
+    static constexpr std::size_t max_offset{70U};
+
+    std::vector<pl::byte> source(max_size + max_offset);
+    std::vector<pl::byte> original(max_size + max_offset);
+
+    for (std::size_t i{0U}; i < source.size(); ++i) {
+        source[i]   = static_cast<pl::byte>((i * 7U) + 3U);
+        original[i] = static_cast<pl::byte>((i * 13U) ^ 0x5AU);
+    }
+
+    for (pl::simd_level level :
+         {pl::simd_level::none,
+          pl::simd_level::sse2,
+          pl::simd_level::ssse3,
+          pl::simd_level::avx2,
+          pl::simd_level::avx512}) {
+        for (std::size_t size : {0U, 1U, 7U, 15U, 33U, 64U, 255U, 1100U}) {
+            // misalign the destination and the source differently.
+            for (std::size_t offset : {0U, 1U, 13U, 63U}) {
+                std::vector<pl::byte> destination{original};
+                std::vector<pl::byte> expected{original};
+
+                for (std::size_t i{0U}; i < size; ++i) {
+                    expected[offset + i] = static_cast<pl::byte>(
+                        expected[offset + i] ^ source[max_offset - offset + i]);
+                }
+
+                void* const result{pl::memxor(
+                    destination.data() + offset,
+                    source.data() + max_offset - offset,
+                    size,
+                    level)};
+                CHECK(result == destination.data() + offset);
+
+                // nothing outside of the range may be touched.
+                CHECK(destination == expected);
+
+                std::vector<pl::byte> dispatched{original};
+                (void)pl::memxor(
+                    dispatched.data() + offset,
+                    source.data() + max_offset - offset,
+                    size);
+                CHECK(dispatched == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("memxor_three_operand_test")
+{
+    for (std::size_t size : {1U, 5U, 64U, 1000U, 9000U}) {
+        std::vector<pl::byte> first(size);
+        std::vector<pl::byte> second(size);
+        std::vector<pl::byte> expected(size);
+
+        for (std::size_t i{0U}; i < size; ++i) {
+            first[i]    = static_cast<pl::byte>(i * 3U);
+            second[i]   = static_cast<pl::byte>((i * 11U) + 1U);
+            expected[i] = static_cast<pl::byte>(first[i] ^ second[i]);
+        }
+
+        // one byte past the end must not be written.
+        std::vector<pl::byte> destination(size + 1U, pl::byte{0xAB});
+        void* const result{pl::memxor(
+            destination.data(), first.data(), second.data(), size)};
+        CHECK(result == destination.data());
+        CHECK(std::equal(
+            expected.begin(), expected.end(), destination.begin()));
+        CHECK(destination.back() == pl::byte{0xAB});
+
+        // the destination may be the first operand.
+        (void)pl::memxor(first.data(), first.data(), second.data(), size);
+        CHECK(first == expected);
+    }
+}
+
+TEST_CASE("memxor_n_test")
+{
+    static constexpr std::size_t size{10000U};
+
+    std::vector<std::vector<pl::byte>> sources(
+        5U, std::vector<pl::byte>(size));
+    std::vector<const void*> source_pointers{};
+
+    for (std::size_t s{0U}; s < sources.size(); ++s) {
+        for (std::size_t i{0U}; i < size; ++i) {
+            sources[s][i] = static_cast<pl::byte>((i * (s + 2U)) ^ (s * 37U));
+        }
+
+        source_pointers.push_back(sources[s].data());
+    }
+
+    std::vector<pl::byte> original(size);
+
+    for (std::size_t i{0U}; i < size; ++i) {
+        original[i] = static_cast<pl::byte>(i ^ 0xC3U);
+    }
+
+    SUBCASE("initializer_list")
+    {
+        for (std::size_t byte_count : {0U, 3U, 100U, 4096U, 4097U, 10000U}) {
+            std::vector<pl::byte> expected{original};
+            std::vector<pl::byte> destination{original};
+
+            for (std::size_t s{0U}; s < 3U; ++s) {
+                (void)pl::memxor(
+                    expected.data(), sources[s].data(), byte_count);
+            }
+
+            void* const result{pl::memxor_n(
+                destination.data(),
+                {sources[0U].data(), sources[1U].data(), sources[2U].data()},
+                byte_count)};
+            CHECK(result == destination.data());
+            CHECK(destination == expected);
+        }
+    }
+
+    SUBCASE("pointer and count")
+    {
+        std::vector<pl::byte> expected{original};
+        std::vector<pl::byte> destination{original};
+
+        for (const std::vector<pl::byte>& source : sources) {
+            (void)pl::memxor(expected.data(), source.data(), size);
+        }
+
+        (void)pl::memxor_n(
+            destination.data(), source_pointers.data(), sources.size(), size);
+        CHECK(destination == expected);
+    }
+
+    SUBCASE("no sources")
+    {
+        std::vector<pl::byte> destination{original};
+        (void)pl::memxor_n(destination.data(), nullptr, 0U, size);
+        CHECK(destination == original);
+    }
+}
@@ -0,0 +1,344 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/object_pool.hpp" // pl::object_pool, pl::object_pool_allocator
+#include "../include/static_assert.hpp"     // PL_TEST_STATIC_ASSERT
+#include <cstddef>                          // std::size_t, std::max_align_t
+#include <cstdint>                          // std::uintptr_t
+#include <list>                             // std::list
+#include <map>                              // std::map
+#include <memory>                           // std::allocate_shared, std::shared_ptr, std::unique_ptr
+#include <set>                              // std::set
+#include <string>                           // std::string
+#include <thread>                           // std::thread
+#include <type_traits>                      // std::is_nothrow_constructible
+#include <utility>                          // std::move
+#include <vector>                           // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+struct pooled {
+    pooled(int a, std::string b) : m_a{a}, m_b{std::move(b)} {}
+
+    int         m_a;
+    std::string m_b;
+};
+
+struct throws_on_construction {
+    throws_on_construction() { throw 5; }
+};
+
+struct big {
+    char bytes[4096];
+};
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("object_pool_create_test")
+{
+    pl::object_pool<pl::test::pooled> pool{};
+    CHECK(pool.slab_count() == 0U);
+
+    pl::test::pooled* const a{pool.create(1, "one")};
+    pl::test::pooled* const b{pool.create(2, "two")};
+    CHECK(a != b);
+    CHECK(a->m_a == 1);
+    CHECK(a->m_b == "one");
+    CHECK(b->m_a == 2);
+    CHECK(b->m_b == "two");
+    CHECK(pool.slab_count() == 1U);
+    CHECK(
+        (reinterpret_cast<std::uintptr_t>(a) % alignof(pl::test::pooled))
+        == 0U);
+
+    pool.destroy(b);
+    pool.destroy(a);
+    pool.destroy(nullptr);
+
+    // freed objects are reused.
+    pl::test::pooled* const c{pool.create(3, "three")};
+    CHECK(((c == a) or (c == b)));
+    pool.destroy(c);
+}
+
+TEST_CASE("object_pool_slab_test")
+{
+    pl::object_pool_options options{};
+    options.objects_per_slab = 8U;
+    options.batch_size       = 4U;
+    pl::object_pool<int> pool{options};
+
+    std::vector<int*> objects{};
+    std::set<int*>    distinct{};
+
+    for (int i{0}; i < 20; ++i) {
+        objects.push_back(pool.create(i));
+        distinct.insert(objects.back());
+    }
+
+    CHECK(distinct.size() == objects.size());
+    CHECK(pool.slab_count() == 3U);
+
+    for (std::size_t i{0U}; i < objects.size(); ++i) {
+        CHECK(*objects[i] == static_cast<int>(i));
+    }
+
+    for (int* object : objects) {
+        pool.destroy(object);
+    }
+
+    // no new slabs are needed once the objects have been freed.
+    for (std::size_t i{0U}; i < objects.size(); ++i) {
+        objects[i] = pool.create(0);
+    }
+
+    CHECK(pool.slab_count() == 3U);
+
+    for (int* object : objects) {
+        pool.destroy(object);
+    }
+}
+
+TEST_CASE("object_pool_no_thread_caches_test")
+{
+    pl::object_pool_options options{};
+    options.objects_per_slab = 4U;
+    options.thread_caches    = false;
+    pl::object_pool<long> pool{options};
+
+    long* const a{pool.create(1L)};
+    long* const b{pool.create(2L)};
+    CHECK(*a == 1L);
+    CHECK(*b == 2L);
+    pool.destroy(a);
+    CHECK(pool.create(3L) == a);
+    pool.destroy(a);
+    pool.destroy(b);
+    CHECK(pool.slab_count() == 1U);
+}
+
+TEST_CASE("object_pool_exception_test")
+{
+    pl::object_pool_options options{};
+    options.objects_per_slab = 1U;
+    options.batch_size       = 1U;
+    pl::object_pool<pl::test::throws_on_construction> pool{options};
+
+    CHECK_THROWS_AS((void)pool.create(), int);
+
+    // the memory was given back to the pool.
+    void* const memory{pool.allocate()};
+    CHECK(pool.slab_count() == 1U);
+    pool.deallocate(memory);
+}
+
+TEST_CASE("object_pool_threads_test")
+{
+    pl::object_pool_options options{};
+    options.objects_per_slab = 64U;
+    options.batch_size       = 8U;
+    pl::object_pool<std::size_t> pool{options};
+    static constexpr std::size_t thread_count{4U};
+    static constexpr std::size_t iterations{1000U};
+
+    std::vector<std::vector<std::size_t*>> produced(thread_count);
+    std::vector<std::thread>               threads{};
+
+    for (std::size_t t{0U}; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &produced, t] {
+            for (std::size_t i{0U}; i < iterations; ++i) {
+                produced[t].push_back(pool.create(i));
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    threads.clear();
+
+    std::set<std::size_t*> distinct{};
+
+    for (const std::vector<std::size_t*>& objects : produced) {
+        distinct.insert(objects.begin(), objects.end());
+    }
+
+    CHECK(distinct.size() == (thread_count * iterations));
+
+    // free the objects on a different thread than the one that created
+    // them.
+    for (std::size_t t{0U}; t < thread_count; ++t) {
+        threads.emplace_back([&pool, &produced, t] {
+            const std::vector<std::size_t*>& objects{
+                produced[(t + 1U) % thread_count]};
+
+            for (std::size_t i{0U}; i < objects.size(); ++i) {
+                CHECK(*objects[i] == i);
+                pool.destroy(objects[i]);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const std::size_t slabs{pool.slab_count()};
+
+    // the objects freed by the threads made it back to the depot.
+    std::vector<std::size_t*> objects{};
+
+    for (std::size_t i{0U}; i < (thread_count * iterations) / 2U; ++i) {
+        objects.push_back(pool.create(i));
+    }
+
+    CHECK(pool.slab_count() == slabs);
+
+    for (std::size_t* object : objects) {
+        pool.destroy(object);
+    }
+}
+
+TEST_CASE("object_pool_destroyed_pool_test")
+{
+    // pools destroyed while a thread still caches their objects, pools
+    // created afterwards may reuse their addresses.
+    for (int i{0}; i < 10; ++i) {
+        pl::object_pool<int> pool{};
+        int* const           object{pool.create(i)};
+        CHECK(*object == i);
+        pool.destroy(object);
+        CHECK(pool.slab_count() == 1U);
+    }
+
+    std::unique_ptr<pl::object_pool<int>> pool{new pl::object_pool<int>{}};
+    pool->destroy(pool->create(1));
+
+    std::thread thread{[&pool] {
+        pool->destroy(pool->create(2));
+        pool.reset(new pl::object_pool<int>{});
+        int* const object{pool->create(3)};
+        CHECK(*object == 3);
+        pool->destroy(object);
+        CHECK(pool->slab_count() == 1U);
+    }};
+    thread.join();
+
+    int* const object{pool->create(4)};
+    CHECK(*object == 4);
+    pool->destroy(object);
+}
+
+TEST_CASE("object_pool_allocator_test")
+{
+    pl::object_pool_allocator<int> allocator{};
+
+    std::list<int, pl::object_pool_allocator<int>> list{allocator};
+
+    for (int i{0}; i < 100; ++i) {
+        list.push_back(i);
+    }
+
+    CHECK(list.size() == 100U);
+    CHECK(list.back() == 99);
+
+    std::map<int,
+             std::string,
+             std::less<int>,
+             pl::object_pool_allocator<std::pair<const int, std::string>>>
+        map{pl::object_pool_allocator<std::pair<const int, std::string>>{
+            allocator}};
+    map[1] = "one";
+    map[2] = "two";
+    CHECK(map.size() == 2U);
+    CHECK(map[2] == "two");
+
+    // contiguous allocations use the heap.
+    std::vector<int, pl::object_pool_allocator<int>> vector{allocator};
+
+    for (int i{0}; i < 100; ++i) {
+        vector.push_back(i);
+    }
+
+    CHECK(vector[50] == 50);
+
+    const std::shared_ptr<std::string> shared{
+        std::allocate_shared<std::string>(allocator, "text")};
+    CHECK(*shared == "text");
+
+    const pl::object_pool_allocator<double> rebound{allocator};
+    CHECK(rebound == allocator);
+    CHECK_FALSE(rebound != allocator);
+
+    const pl::object_pool_allocator<int> other{};
+    CHECK(other != allocator);
+}
+
+TEST_CASE("object_pool_allocator_rebind_test")
+{
+    // std::allocate_shared rebinds the allocator in noexcept contexts.
+    PL_TEST_STATIC_ASSERT(std::is_nothrow_constructible<
+                          pl::object_pool_allocator<double>,
+                          const pl::object_pool_allocator<int>&>::value);
+    PL_TEST_STATIC_ASSERT(std::is_nothrow_copy_constructible<
+                          pl::object_pool_allocator<int>>::value);
+
+    const pl::object_pool_allocator<int> allocator{};
+    std::vector<std::thread>             threads{};
+
+    for (std::size_t t{0U}; t < 4U; ++t) {
+        threads.emplace_back([&allocator] {
+            for (std::size_t i{0U}; i < 1000U; ++i) {
+                const std::shared_ptr<std::size_t> p{
+                    std::allocate_shared<std::size_t>(allocator, i)};
+                CHECK(*p == i);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // objects too large for the pools use the heap.
+    pl::object_pool_allocator<pl::test::big> big_allocator{allocator};
+    pl::test::big* const b{big_allocator.allocate(1U)};
+    b->bytes[4095] = 'a';
+    CHECK(b->bytes[4095] == 'a');
+    big_allocator.deallocate(b, 1U);
+}
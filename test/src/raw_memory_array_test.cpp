@@ -210,3 +210,31 @@ TEST_CASE("raw_memory_array_test")
         CHECK(ary1 >= ary2);
     }
 }
+
+TEST_CASE("raw_memory_array_default_init_test")
+{
+    static constexpr std::size_t amount{8U};
+
+    // trivial types are left uninitialized.
+    std::unique_ptr<pl::byte, pl::test::freeer> int_memory{
+        static_cast<pl::byte*>(std::calloc(amount, sizeof(int))),
+        pl::test::freeer{}};
+    pl::raw_memory_array<int> ints{
+        int_memory.get(), amount * sizeof(int), pl::default_init_t{}};
+    CHECK(ints.size() == amount);
+    CHECK(static_cast<void*>(ints.data()) == int_memory.get());
+    ints.fill(5);
+    CHECK(pl::algo::all_of(ints, [](int i) { return i == 5; }));
+
+    // class types are default constructed.
+    std::unique_ptr<pl::byte, pl::test::freeer> string_memory{
+        static_cast<pl::byte*>(std::calloc(amount, sizeof(std::string))),
+        pl::test::freeer{}};
+    pl::raw_memory_array<std::string> strings{
+        string_memory.get(),
+        amount * sizeof(std::string),
+        pl::default_init_t{}};
+    CHECK(strings.size() == amount);
+    CHECK(pl::algo::all_of(
+        strings, [](const std::string& s) { return s.empty(); }));
+}
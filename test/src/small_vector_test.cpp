@@ -0,0 +1,229 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/small_vector.hpp" // pl::small_vector
+#include <cstddef>                           // std::size_t
+#include <memory>                            // std::unique_ptr
+#include <stdexcept>                         // std::out_of_range
+#include <string>                            // std::string
+#include <utility>                           // std::move
+
+namespace pl {
+namespace test {
+namespace {
+/*!
+ * \brief Counts the live instances, to detect leaks and double destruction.
+**/
+class counted {
+public:
+    static int s_live;
+
+    explicit counted(int value) : m_value{value} { ++s_live; }
+
+    counted(const counted& other) : m_value{other.m_value} { ++s_live; }
+
+    counted(counted&& other) noexcept : m_value{other.m_value}
+    {
+        other.m_value = -1;
+        ++s_live;
+    }
+
+    counted& operator=(const counted& other) = default;
+
+    counted& operator=(counted&& other) noexcept
+    {
+        m_value       = other.m_value;
+        other.m_value = -1;
+        return *this;
+    }
+
+    ~counted() { --s_live; }
+
+    int value() const noexcept { return m_value; }
+
+private:
+    int m_value;
+};
+
+int counted::s_live = 0;
+
+bool operator==(const counted& lhs, const counted& rhs) noexcept
+{
+    return lhs.value() == rhs.value();
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("small_vector_inline_test")
+{
+    pl::small_vector<int, 4> vector{};
+    CHECK(vector.empty());
+    CHECK(vector.is_inline());
+    CHECK(vector.capacity() == 4U);
+
+    vector.push_back(1);
+    vector.push_back(2);
+    vector.emplace_back(3);
+    CHECK(vector.size() == 3U);
+    CHECK(vector.is_inline());
+    CHECK(vector.front() == 1);
+    CHECK(vector.back() == 3);
+    CHECK(vector[1] == 2);
+    CHECK(vector.at(2) == 3);
+    CHECK_THROWS_AS((void)vector.at(3), std::out_of_range);
+
+    vector.pop_back();
+    CHECK(vector == (pl::small_vector<int, 4>{1, 2}));
+}
+
+TEST_CASE("small_vector_spill_test")
+{
+    pl::small_vector<std::string, 2> vector{};
+
+    for (int i{0}; i < 10; ++i) {
+        vector.push_back(std::to_string(i));
+    }
+
+    CHECK_FALSE(vector.is_inline());
+    CHECK(vector.size() == 10U);
+    CHECK(vector.capacity() >= 10U);
+
+    for (std::size_t i{0U}; i < vector.size(); ++i) {
+        CHECK(vector[i] == std::to_string(i));
+    }
+
+    // appending an element of itself while growing.
+    pl::small_vector<std::string, 2> self{"a", "b"};
+    self.push_back(self.front());
+    CHECK(self.size() == 3U);
+    CHECK(self.back() == "a");
+
+    vector.resize(1U);
+    vector.shrink_to_fit();
+    CHECK(vector.is_inline());
+    CHECK(vector.size() == 1U);
+    CHECK(vector.front() == "0");
+}
+
+TEST_CASE("small_vector_move_test")
+{
+    pl::small_vector<int, 2> heap{1, 2, 3, 4};
+    CHECK_FALSE(heap.is_inline());
+    const int* const buffer{heap.data()};
+
+    // the heap buffer is stolen.
+    pl::small_vector<int, 2> moved{std::move(heap)};
+    CHECK(moved.data() == buffer);
+    CHECK(moved.size() == 4U);
+    CHECK(heap.empty());
+    CHECK(heap.is_inline());
+
+    pl::small_vector<int, 2> inline_vector{5};
+    moved = std::move(inline_vector);
+    CHECK(moved == (pl::small_vector<int, 2>{5}));
+    CHECK(inline_vector.empty());
+
+    pl::small_vector<std::unique_ptr<int>, 2> pointers{};
+    pointers.push_back(std::unique_ptr<int>{new int{1}});
+    pl::small_vector<std::unique_ptr<int>, 2> moved_pointers{
+        std::move(pointers)};
+    CHECK(*moved_pointers.front() == 1);
+    CHECK(pointers.empty());
+}
+
+TEST_CASE("small_vector_lifetime_test")
+{
+    {
+        pl::small_vector<pl::test::counted, 3> vector{};
+
+        for (int i{0}; i < 8; ++i) {
+            vector.emplace_back(i);
+        }
+
+        CHECK(pl::test::counted::s_live == 8);
+
+        pl::small_vector<pl::test::counted, 3> copy{vector};
+        CHECK(pl::test::counted::s_live == 16);
+        CHECK(copy.back().value() == 7);
+
+        (void)copy.erase(copy.begin() + 1, copy.begin() + 3);
+        CHECK(copy.size() == 6U);
+        CHECK(copy[1].value() == 3);
+        CHECK(pl::test::counted::s_live == 14);
+
+        (void)copy.insert(copy.begin(), pl::test::counted{42});
+        CHECK(copy.front().value() == 42);
+        CHECK(copy[1].value() == 0);
+
+        pl::small_vector<pl::test::counted, 3> small{};
+        small.emplace_back(1);
+        swap(small, copy);
+        CHECK(small.size() == 7U);
+        CHECK(copy.size() == 1U);
+        CHECK(copy.front().value() == 1);
+
+        copy = small;
+        CHECK(copy == small);
+        vector.clear();
+        CHECK(pl::test::counted::s_live == 14);
+    }
+
+    CHECK(pl::test::counted::s_live == 0);
+}
+
+TEST_CASE("small_vector_resize_test")
+{
+    pl::small_vector<int, 4> vector(3U);
+    CHECK(vector == (pl::small_vector<int, 4>{0, 0, 0}));
+
+    vector.resize(6U, 7);
+    CHECK(vector == (pl::small_vector<int, 4>{0, 0, 0, 7, 7, 7}));
+
+    vector.resize(2U);
+    CHECK(vector.size() == 2U);
+
+    vector.reserve(100U);
+    CHECK(vector.capacity() == 100U);
+
+    const pl::small_vector<int, 4> a{1, 2, 3};
+    const pl::small_vector<int, 4> b{1, 2, 4};
+    CHECK(a < b);
+    CHECK(a != b);
+
+    const pl::small_vector<int, 0> empty_inline{1, 2};
+    CHECK(empty_inline.size() == 2U);
+    CHECK_FALSE(empty_inline.is_inline());
+}
@@ -0,0 +1,148 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../include/pl/algo/ranged_algorithms.hpp" // pl::algo::fill, pl::algo::iota, pl::algo::count_if, pl::algo::all_of
+#include "../../include/pl/aligned_buffer.hpp"         // pl::cache_line_size
+#include "../../include/pl/as_const.hpp"               // pl::as_const
+#include "../../include/pl/soa_vector.hpp"             // pl::soa_vector
+#include <cstddef>                                     // std::size_t
+#include <cstdint>                                     // std::uintptr_t
+#include <stdexcept>                                   // std::out_of_range
+#include <string>                                      // std::string
+#include <tuple>                                       // std::get
+#include <utility>                                     // std::move
+
+TEST_CASE("soa_vector_test")
+{
+    pl::soa_vector<int, std::string, long> vector{};
+    CHECK(vector.empty());
+    CHECK(vector.size() == 0U);
+
+    for (int i{0}; i < 100; ++i) {
+        vector.push_back(i, std::to_string(i), static_cast<long>(i) * 2L);
+    }
+
+    CHECK(vector.size() == 100U);
+    CHECK(vector.capacity() >= 100U);
+    CHECK(std::get<0>(vector[42]) == 42);
+    CHECK(std::get<1>(vector[42]) == "42");
+    CHECK(std::get<2>(vector.at(42)) == 84L);
+    CHECK(std::get<1>(vector.back()) == "99");
+    CHECK_THROWS_AS((void)vector.at(100U), std::out_of_range);
+
+    // the proxy references refer to the fields.
+    std::get<1>(vector.front()) = "zero";
+    CHECK(vector.column<1>()[0] == "zero");
+
+    // the columns are contiguous and aligned.
+    CHECK(
+        (reinterpret_cast<std::uintptr_t>(vector.data<2>())
+         % pl::cache_line_size)
+        == 0U);
+    CHECK(vector.column<2>().size() == 100U);
+    CHECK(&vector.column<2>()[1] == &vector.column<2>()[0] + 1);
+
+    vector.erase(0U);
+    CHECK(vector.size() == 99U);
+    CHECK(std::get<0>(vector.front()) == 1);
+    CHECK(std::get<1>(vector.front()) == "1");
+
+    vector.pop_back();
+    CHECK(std::get<1>(vector.back()) == "98");
+
+    vector.resize(2U);
+    CHECK(vector.size() == 2U);
+    vector.resize(3U);
+    CHECK(std::get<0>(vector[2]) == 0);
+    CHECK(std::get<1>(vector[2]).empty());
+
+    // appending a field of a record while growing.
+    pl::soa_vector<std::string, std::string> strings{};
+    strings.push_back("a", "b");
+    strings.push_back(std::get<1>(strings[0]), std::get<0>(strings[0]));
+    CHECK(std::get<0>(strings[1]) == "b");
+    CHECK(std::get<1>(strings[1]) == "a");
+}
+
+TEST_CASE("soa_vector_copy_move_test")
+{
+    const pl::soa_vector<int, std::string> vector{{1, "one"}, {2, "two"}};
+    CHECK(vector.size() == 2U);
+
+    pl::soa_vector<int, std::string> copy{vector};
+    CHECK(copy.size() == 2U);
+    CHECK(std::get<1>(copy[1]) == "two");
+    CHECK(copy.data<1>() != vector.data<1>());
+
+    const std::string* const strings{copy.data<1>()};
+    pl::soa_vector<int, std::string> moved{std::move(copy)};
+    CHECK(moved.data<1>() == strings);
+    CHECK(copy.empty());
+
+    copy = moved;
+    CHECK(std::get<0>(copy[0]) == 1);
+    moved.clear();
+    CHECK(moved.empty());
+    CHECK(std::get<1>(copy[0]) == "one");
+}
+
+TEST_CASE("soa_vector_ranged_algorithms_test")
+{
+    pl::soa_vector<float, int> vector(10U);
+    pl::algo::fill(vector.column<0>(), 1.5F);
+    pl::algo::iota(vector.column<1>(), 0);
+
+    CHECK(pl::algo::count_if(
+              vector.column<1>(), [](int i) { return (i % 2) == 0; })
+          == 5);
+    CHECK(pl::algo::all_of(
+        vector.column<0>(), [](float f) { return f > 1.0F; }));
+
+    // rows are iterable too.
+    CHECK(pl::algo::count_if(
+              vector,
+              [](const std::tuple<float&, int&>& row) {
+                  return std::get<1>(row) > 6;
+              })
+          == 3);
+
+    int sum{0};
+
+    for (const auto& row : pl::as_const(vector)) {
+        sum += std::get<1>(row);
+    }
+
+    CHECK(sum == 45);
+}
@@ -36,12 +36,30 @@
 #include "../../include/pl/iterate_reversed.hpp" // pl::iterate_reversed
 #include "../../include/pl/string_view.hpp"      // pl::string_view, ...
 #include "../../test/include/static_assert.hpp"  // PL_TEST_STATIC_ASSERT
+#include <cctype>                                // std::tolower
 #include <cstddef>                               // std::size_t
+#include <cstdint>                               // std::uint64_t
 #include <cstring>                               // std::strcmp, std::memcmp
+#include <functional>                            // std::hash
 #include <iterator>                              // std::distance
 #include <sstream> // std::basic_ostringstream, std::ostringstream, std::wostringstream
 #include <string> // std::string, std::u16string, std::u32string, std::wstring
-#include <type_traits> // std::is_constructible, std::is_copy_assignable, std::is_move_assignable
+#include <type_traits> // std::is_constructible, std::is_copy_assignable, std::is_move_assignable, std::is_default_constructible
+#include <unordered_set> // std::unordered_set
+
+namespace pl {
+namespace test {
+namespace {
+struct case_insensitive_traits : public std::char_traits<char> {
+    static bool eq(char a, char b) noexcept
+    {
+        return std::tolower(static_cast<unsigned char>(a))
+               == std::tolower(static_cast<unsigned char>(b));
+    }
+};
+} // anonymous namespace
+} // namespace test
+} // namespace pl
 
 TEST_CASE("string_view_default_construct_test")
 {
@@ -789,3 +807,76 @@ TEST_CASE("string_view_print_test")
         CHECK_UNARY(result4.empty());
     }
 }
+
+TEST_CASE("string_view_fnv1a_test")
+{
+    using namespace pl::literals::string_view_literals;
+
+    PL_TEST_STATIC_ASSERT(pl::fnv1a(""_sv) == 0xCBF29CE484222325ULL);
+    PL_TEST_STATIC_ASSERT(pl::fnv1a("a"_sv) == 0xAF63DC4C8601EC8CULL);
+    PL_TEST_STATIC_ASSERT(pl::fnv1a("foobar"_sv) == 0x85944171F73967E8ULL);
+
+    SUBCASE("wide characters are hashed least significant byte first")
+    {
+        constexpr char bytes16[]{'f', '\0', 'o', '\0', 'o', '\0'};
+        constexpr char bytes32[]{
+            'f', '\0', '\0', '\0', 'o', '\0', '\0', '\0', 'o', '\0', '\0', '\0'};
+
+        CHECK(
+            pl::fnv1a(u"foo"_sv)
+            == pl::fnv1a(pl::string_view{bytes16, sizeof(bytes16)}));
+        CHECK(
+            pl::fnv1a(U"foo"_sv)
+            == pl::fnv1a(pl::string_view{bytes32, sizeof(bytes32)}));
+    }
+}
+
+TEST_CASE("string_view_hash_test")
+{
+    using namespace pl::literals::string_view_literals;
+    using namespace pl::literals::hash_literals;
+
+    PL_TEST_STATIC_ASSERT(
+        "foobar"_h == static_cast<std::size_t>(0x85944171F73967E8ULL));
+
+    const std::string string{"foobar"};
+
+    CHECK(std::hash<pl::string_view>{}(string) == "foobar"_h);
+    CHECK(std::hash<pl::u16string_view>{}(u"foobar"_sv) == u"foobar"_h);
+    CHECK(std::hash<pl::u32string_view>{}(U"foobar"_sv) == U"foobar"_h);
+    CHECK(std::hash<pl::wstring_view>{}(L"foobar"_sv) == L"foobar"_h);
+    CHECK(std::hash<pl::string_view>{}("foobaz"_sv) != "foobar"_h);
+
+#if __cplusplus >= 201703L
+    // fnv1a would ignore the comparison of other traits.
+    PL_TEST_STATIC_ASSERT(
+        not std::is_default_constructible<std::hash<
+            pl::basic_string_view<char, pl::test::case_insensitive_traits>>>::
+            value);
+#endif
+
+    SUBCASE("switch")
+    {
+        const auto classify = [](pl::string_view key) {
+            switch (std::hash<pl::string_view>{}(key)) {
+            case "alpha"_h: return 1;
+            case "beta"_h: return 2;
+            default: return 0;
+            }
+        };
+
+        CHECK(classify("alpha") == 1);
+        CHECK(classify(string.substr(0U, 0U)) == 0);
+        CHECK(classify(pl::string_view{"beta gamma", 4U}) == 2);
+        CHECK(classify("gamma") == 0);
+    }
+
+    SUBCASE("unordered_set")
+    {
+        std::unordered_set<pl::string_view> set{"alpha", "beta"};
+
+        CHECK(set.count("alpha") == 1U);
+        CHECK(set.count(pl::string_view{"beta gamma", 4U}) == 1U);
+        CHECK(set.count("gamma") == 0U);
+    }
+}
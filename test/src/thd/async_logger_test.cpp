@@ -0,0 +1,186 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/async_logger.hpp" // pl::thd::async_logger
+#include <algorithm>                                // std::count, std::sort, std::adjacent_find
+#include <cstddef>                                  // std::size_t
+#include <cstdint>                                  // std::uint64_t
+#include <cstdio>                                   // std::FILE, std::tmpfile, std::fclose, std::fread, std::rewind
+#include <string>                                   // std::string
+#include <thread>                                   // std::thread
+#include <vector>                                   // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+class temporary_file {
+public:
+    temporary_file() : m_file{std::tmpfile()} {}
+
+    temporary_file(const temporary_file&) = delete;
+
+    temporary_file& operator=(const temporary_file&) = delete;
+
+    ~temporary_file() { std::fclose(m_file); }
+
+    int descriptor() const { return fileno(m_file); }
+
+    std::string contents() const
+    {
+        std::string result{};
+        char        buffer[256];
+        std::rewind(m_file);
+
+        for (std::size_t read{std::fread(buffer, 1U, sizeof(buffer), m_file)};
+             read != 0U;
+             read = std::fread(buffer, 1U, sizeof(buffer), m_file)) {
+            result.append(buffer, read);
+        }
+
+        return result;
+    }
+
+private:
+    std::FILE* m_file;
+};
+
+std::size_t count_lines(const std::string& string)
+{
+    return static_cast<std::size_t>(
+        std::count(string.begin(), string.end(), '\n'));
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("async_logger_single_thread_test")
+{
+    pl::test::temporary_file file{};
+    REQUIRE(file.descriptor() >= 0);
+    pl::thd::async_logger logger{file.descriptor()};
+
+    CHECK(logger.log("Hello %s\n", "World"));
+    CHECK(logger.log("%d + %d = %d\n", 1, 2, 3));
+    logger.flush();
+
+    CHECK(file.contents() == "Hello World\n1 + 2 = 3\n");
+    CHECK(logger.dropped() == 0U);
+}
+
+TEST_CASE("async_logger_truncate_test")
+{
+    pl::test::temporary_file     file{};
+    pl::thd::async_logger_options options{};
+    options.buffer_size = 8U;
+    pl::thd::async_logger logger{file.descriptor(), options};
+
+    CHECK(logger.log("0123456789\n"));
+    logger.flush();
+
+    CHECK(file.contents() == "0123456");
+}
+
+TEST_CASE("async_logger_multi_thread_test")
+{
+    static constexpr int      thread_count{4};
+    static constexpr int      messages{500};
+    pl::test::temporary_file  file{};
+    std::vector<std::string> lines{};
+
+    {
+        pl::thd::async_logger_options options{};
+        options.buffer_count = 16U;
+        pl::thd::async_logger    logger{file.descriptor(), options};
+        std::vector<std::thread> threads{};
+
+        for (int i{0}; i < thread_count; ++i) {
+            threads.emplace_back([&logger, i] {
+                for (int j{0}; j < messages; ++j) {
+                    (void)logger.log("%d %d\n", i, j);
+                }
+            });
+        }
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        CHECK(logger.dropped() == 0U);
+    }
+
+    // the destructor writes the remaining messages.
+    const std::string contents{file.contents()};
+    CHECK(pl::test::count_lines(contents)
+          == static_cast<std::size_t>(thread_count * messages));
+
+    std::string::size_type begin{0U};
+
+    for (std::string::size_type end{contents.find('\n', begin)};
+         end != std::string::npos;
+         end = contents.find('\n', begin)) {
+        lines.push_back(contents.substr(begin, end - begin));
+        begin = end + 1U;
+    }
+
+    std::sort(lines.begin(), lines.end());
+    CHECK(std::adjacent_find(lines.begin(), lines.end()) == lines.end());
+}
+
+TEST_CASE("async_logger_drop_test")
+{
+    static constexpr int          messages{2000};
+    pl::test::temporary_file      file{};
+    pl::thd::async_logger_options options{};
+    options.buffer_count    = 1U;
+    options.overflow_policy = pl::thd::log_overflow_policy::drop;
+    std::uint64_t queued{0U};
+    std::uint64_t dropped{0U};
+
+    {
+        pl::thd::async_logger logger{file.descriptor(), options};
+
+        for (int i{0}; i < messages; ++i) {
+            if (logger.log("%d\n", i)) {
+                ++queued;
+            }
+        }
+
+        logger.flush();
+        dropped = logger.dropped();
+    }
+
+    CHECK(queued + dropped == static_cast<std::uint64_t>(messages));
+    CHECK(pl::test::count_lines(file.contents()) == queued);
+}
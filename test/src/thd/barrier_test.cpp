@@ -0,0 +1,110 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/barrier.hpp" // pl::thd::barrier
+#include <atomic>                              // std::atomic
+#include <thread>                              // std::thread
+#include <utility>                             // std::move
+#include <vector>                              // std::vector
+
+TEST_CASE("barrier_single_thread_test")
+{
+    int                 completions{0};
+    pl::thd::barrier<>  plain{1};
+    auto                completion = [&completions]() noexcept { ++completions; };
+    pl::thd::barrier<decltype(completion)> barrier{2, completion};
+
+    plain.arrive_and_wait();
+    plain.arrive_and_wait();
+
+    barrier.wait(barrier.arrive(2));
+    CHECK(completions == 1);
+
+    auto token = barrier.arrive();
+    CHECK(completions == 1);
+    barrier.wait(barrier.arrive());
+    barrier.wait(std::move(token));
+    CHECK(completions == 2);
+}
+
+TEST_CASE("barrier_phases_test")
+{
+    static constexpr int thread_count{4};
+    static constexpr int rounds{100};
+    std::atomic<int>     arrived{0};
+    std::atomic<int>     failures{0};
+    int                  phases{0};
+    auto                 completion = [&arrived, &failures, &phases]() noexcept {
+        if (arrived.exchange(0) != thread_count) {
+            ++failures;
+        }
+
+        ++phases;
+    };
+    pl::thd::barrier<decltype(completion)> barrier{thread_count, completion};
+    std::vector<std::thread>               threads{};
+
+    for (int i{0}; i < thread_count; ++i) {
+        threads.emplace_back([&barrier, &arrived] {
+            for (int round{0}; round < rounds; ++round) {
+                ++arrived;
+                barrier.arrive_and_wait();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(failures.load() == 0);
+    CHECK(phases == rounds);
+}
+
+TEST_CASE("barrier_arrive_and_drop_test")
+{
+    int                phases{0};
+    auto               completion = [&phases]() noexcept { ++phases; };
+    pl::thd::barrier<decltype(completion)> barrier{2, completion};
+
+    std::thread dropper{[&barrier] { barrier.arrive_and_drop(); }};
+    barrier.arrive_and_wait();
+    dropper.join();
+    CHECK(phases == 1);
+
+    // only a single arrival is expected from now on.
+    barrier.arrive_and_wait();
+    CHECK(phases == 2);
+}
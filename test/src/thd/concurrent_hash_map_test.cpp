@@ -0,0 +1,187 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/hash.hpp"                    // pl::hash, pl::key_hash
+#include "../../../include/pl/thd/concurrent_hash_map.hpp" // pl::thd::concurrent_hash_map
+#include <ciso646>                                         // and
+#include <cstddef>                                         // std::size_t
+#include <functional>                                      // std::hash
+#include <string>                                          // std::string
+#include <thread>                                          // std::thread
+#include <tuple>                                           // std::tuple, std::make_tuple
+#include <utility>                                         // std::pair, std::make_pair
+#include <vector>                                          // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+struct point {
+    int x;
+    int y;
+};
+
+bool operator==(const point& lhs, const point& rhs)
+{
+    return (lhs.x == rhs.x) and (lhs.y == rhs.y);
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+namespace std {
+template <>
+struct hash<::pl::test::point> {
+    std::size_t operator()(const ::pl::test::point& point) const noexcept
+    {
+        return ::pl::hash(point.x, point.y);
+    }
+};
+} // namespace std
+
+TEST_CASE("concurrent_hash_map_single_thread_test")
+{
+    pl::thd::concurrent_hash_map<std::string, int> map{};
+    CHECK(map.empty());
+    CHECK(map.shard_count() == 64U);
+
+    CHECK(map.insert_or_assign("one", 1));
+    CHECK(map.insert_or_assign("two", 2));
+    CHECK_UNARY_FALSE(map.insert_or_assign("one", 11));
+    CHECK(map.size() == 2U);
+
+    int value{0};
+    CHECK(map.find("one", value));
+    CHECK(value == 11);
+    CHECK_UNARY_FALSE(map.find("three", value));
+    CHECK(map.contains("two"));
+    CHECK_UNARY_FALSE(map.contains("three"));
+
+    CHECK(map.update("two", [](int& i) { i *= 10; }));
+    CHECK_UNARY_FALSE(map.update("three", [](int& i) { i = 3; }));
+    CHECK(map.visit("two", [&value](const int& i) { value = i; }));
+    CHECK(value == 20);
+
+    int sum{0};
+    map.for_each([&sum](const std::string&, const int& i) { sum += i; });
+    CHECK(sum == 31);
+
+    CHECK(map.erase("one"));
+    CHECK_UNARY_FALSE(map.erase("one"));
+    CHECK(map.size() == 1U);
+
+    map.clear();
+    CHECK(map.empty());
+}
+
+TEST_CASE("concurrent_hash_map_composite_key_test")
+{
+    pl::thd::concurrent_hash_map<pl::test::point, std::string> map{1U};
+    CHECK(map.shard_count() == 1U);
+
+    for (int x{0}; x < 10; ++x) {
+        for (int y{0}; y < 10; ++y) {
+            CHECK(map.insert_or_assign(
+                pl::test::point{x, y}, std::to_string(x * 10 + y)));
+        }
+    }
+
+    std::string value{};
+    CHECK(map.find(pl::test::point{4, 2}, value));
+    CHECK(value == "42");
+    CHECK(map.size() == 100U);
+}
+
+TEST_CASE("concurrent_hash_map_pair_and_tuple_key_test")
+{
+    pl::thd::concurrent_hash_map<std::pair<int, std::string>, int> pairs{};
+    CHECK(pairs.insert_or_assign(std::make_pair(1, std::string{"a"}), 1));
+    CHECK(pairs.insert_or_assign(std::make_pair(1, std::string{"b"}), 2));
+    CHECK(pairs.contains(std::make_pair(1, std::string{"a"})));
+    CHECK_UNARY_FALSE(pairs.contains(std::make_pair(2, std::string{"a"})));
+
+    pl::thd::concurrent_hash_map<std::tuple<int, int, int>, int> tuples{};
+    CHECK(tuples.insert_or_assign(std::make_tuple(1, 2, 3), 6));
+    CHECK(tuples.contains(std::make_tuple(1, 2, 3)));
+    CHECK_UNARY_FALSE(tuples.contains(std::make_tuple(3, 2, 1)));
+
+    CHECK(
+        pl::key_hash<std::pair<int, int>>{}(std::make_pair(1, 2))
+        == pl::hash(1, 2));
+    CHECK(
+        pl::key_hash<std::tuple<int, int, int>>{}(std::make_tuple(1, 2, 3))
+        == pl::hash(1, 2, 3));
+    CHECK(pl::key_hash<int>{}(5) == std::hash<int>{}(5));
+}
+
+TEST_CASE("concurrent_hash_map_multi_thread_test")
+{
+    static constexpr int                   thread_count{4};
+    static constexpr int                   keys{1000};
+    pl::thd::concurrent_hash_map<int, int> map{8U};
+    std::vector<std::thread>               threads{};
+
+    for (int key{0}; key < keys; ++key) {
+        (void)map.insert_or_assign(key, 0);
+    }
+
+    for (int i{0}; i < thread_count; ++i) {
+        threads.emplace_back([&map, i] {
+            for (int key{0}; key < keys; ++key) {
+                (void)map.update(key, [](int& value) { ++value; });
+                (void)map.insert_or_assign(keys * (i + 1) + key, i);
+                int value{0};
+                (void)map.find(key, value);
+            }
+
+            for (int key{0}; key < keys; key += 2) {
+                (void)map.erase(keys * (i + 1) + key);
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(
+        map.size()
+        == static_cast<std::size_t>(keys + ((thread_count * keys) / 2)));
+
+    for (int key{0}; key < keys; ++key) {
+        int value{0};
+        REQUIRE(map.find(key, value));
+        CHECK(value == thread_count);
+    }
+}
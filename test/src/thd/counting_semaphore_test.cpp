@@ -0,0 +1,114 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/counting_semaphore.hpp" // pl::thd::counting_semaphore
+#include <atomic>                                         // std::atomic
+#include <chrono>                                         // std::chrono::milliseconds
+#include <thread>                                         // std::thread
+#include <vector>                                         // std::vector
+
+TEST_CASE("counting_semaphore_single_thread_test")
+{
+    pl::thd::counting_semaphore<> semaphore{2};
+    CHECK(semaphore.try_acquire());
+    semaphore.acquire();
+    CHECK_UNARY_FALSE(semaphore.try_acquire());
+    CHECK_UNARY_FALSE(semaphore.try_acquire_for(std::chrono::milliseconds{1}));
+    semaphore.release(3);
+    CHECK(semaphore.try_acquire_until(
+        std::chrono::steady_clock::now() + std::chrono::milliseconds{1}));
+    CHECK(semaphore.try_acquire());
+    CHECK(semaphore.try_acquire());
+    CHECK_UNARY_FALSE(semaphore.try_acquire());
+
+    const std::ptrdiff_t max{pl::thd::binary_semaphore::max()};
+    CHECK(max == 1);
+}
+
+TEST_CASE("binary_semaphore_ping_pong_test")
+{
+    static constexpr int      round_trips{1000};
+    pl::thd::binary_semaphore ping{0};
+    pl::thd::binary_semaphore pong{0};
+    int                       counter{0};
+
+    std::thread other{[&ping, &pong, &counter] {
+        for (int i{0}; i < round_trips; ++i) {
+            ping.acquire();
+            ++counter;
+            pong.release();
+        }
+    }};
+
+    for (int i{0}; i < round_trips; ++i) {
+        ping.release();
+        pong.acquire();
+    }
+
+    other.join();
+    CHECK(counter == round_trips);
+}
+
+TEST_CASE("counting_semaphore_bounded_concurrency_test")
+{
+    static constexpr int          thread_count{8};
+    static constexpr int          permits{3};
+    pl::thd::counting_semaphore<> semaphore{permits};
+    std::atomic<int>              inside{0};
+    std::atomic<int>              failures{0};
+    std::vector<std::thread>      threads{};
+
+    for (int i{0}; i < thread_count; ++i) {
+        threads.emplace_back([&semaphore, &inside, &failures] {
+            for (int j{0}; j < 100; ++j) {
+                semaphore.acquire();
+
+                if (++inside > permits) {
+                    ++failures;
+                }
+
+                --inside;
+                semaphore.release();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    CHECK(failures.load() == 0);
+    CHECK(semaphore.try_acquire_for(std::chrono::milliseconds{1}));
+}
@@ -0,0 +1,79 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/futex.hpp" // pl::thd::futex_wait, pl::thd::futex_wake_all
+#include <atomic>                            // std::atomic
+#include <chrono>                            // std::chrono::milliseconds
+#include <cstdint>                           // std::uint32_t
+#include <thread>                            // std::thread
+
+TEST_CASE("futex_wait_returns_on_mismatch_test")
+{
+    const std::atomic<std::uint32_t> word{1U};
+    pl::thd::futex_wait(word, 0U);
+    pl::thd::futex_wait_for(word, 0U, std::chrono::milliseconds{100});
+    CHECK(word.load() == 1U);
+}
+
+TEST_CASE("futex_wait_for_times_out_test")
+{
+    const std::atomic<std::uint32_t> word{0U};
+    const auto begin = std::chrono::steady_clock::now();
+    pl::thd::futex_wait_for(word, 0U, std::chrono::milliseconds{20});
+    // may return spuriously, but must not block forever.
+    CHECK(std::chrono::steady_clock::now() >= begin);
+}
+
+TEST_CASE("futex_wake_test")
+{
+    std::atomic<std::uint32_t> word{0U};
+    std::atomic<int>           woken{0};
+    std::thread                waiter{[&word, &woken] {
+        while (word.load() == 0U) {
+            pl::thd::futex_wait(word, 0U);
+        }
+
+        ++woken;
+    }};
+
+    word.store(1U);
+    pl::thd::futex_wake_all(word);
+    waiter.join();
+    CHECK(woken.load() == 1);
+
+    word.store(2U);
+    pl::thd::futex_wake_one(word);
+    CHECK(word.load() == 2U);
+}
@@ -0,0 +1,225 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/hazard_pointer.hpp" // pl::thd::hazard_pointer
+#include <atomic>                                     // std::atomic
+#include <cstddef>                                    // std::size_t
+#include <thread>                                     // std::thread
+#include <utility>                                    // std::move
+#include <vector>                                     // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+class node : public thd::hazard_pointer_obj_base<node> {
+public:
+    node(int value, std::atomic<int>& live)
+        : thd::hazard_pointer_obj_base<node>{}, m_value{value}, m_live{&live}
+    {
+        ++*m_live;
+    }
+
+    node(const node&) = delete;
+    node& operator=(const node&) = delete;
+
+    ~node() { --*m_live; }
+
+    int               m_value;
+    std::atomic<int>* m_live;
+};
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("hazard_pointer_basic_test")
+{
+    pl::thd::hazard_pointer empty{};
+    CHECK(empty.empty());
+
+    pl::thd::hazard_pointer_domain domain{};
+    pl::thd::hazard_pointer        hp{pl::thd::make_hazard_pointer(domain)};
+    CHECK_UNARY_FALSE(hp.empty());
+
+    pl::thd::hazard_pointer moved{std::move(hp)};
+    CHECK(hp.empty());
+    CHECK_UNARY_FALSE(moved.empty());
+
+    swap(hp, moved);
+    CHECK_UNARY_FALSE(hp.empty());
+    CHECK(moved.empty());
+}
+
+TEST_CASE("hazard_pointer_protect_test")
+{
+    std::atomic<int>               live{0};
+    pl::thd::hazard_pointer_domain domain{};
+    std::atomic<pl::test::node*>   head{new pl::test::node{1, live}};
+
+    pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer(domain)};
+    pl::test::node* const   protected_node{hp.protect(head)};
+    REQUIRE(protected_node != nullptr);
+    CHECK(protected_node->m_value == 1);
+
+    head.store(new pl::test::node{2, live});
+    protected_node->retire({}, domain);
+    CHECK(domain.retired_count() == 1U);
+
+    domain.reclaim();
+    CHECK(live.load() == 2);
+    CHECK(protected_node->m_value == 1);
+    CHECK(domain.retired_count() == 1U);
+
+    hp.reset_protection();
+    domain.reclaim();
+    CHECK(live.load() == 1);
+    CHECK(domain.retired_count() == 0U);
+
+    head.load()->retire({}, domain);
+    head.store(nullptr);
+    CHECK(hp.protect(head) == nullptr);
+    domain.reclaim();
+    CHECK(live.load() == 0);
+}
+
+TEST_CASE("hazard_pointer_try_protect_test")
+{
+    std::atomic<int>               live{0};
+    pl::thd::hazard_pointer_domain domain{};
+    pl::test::node* const          first{new pl::test::node{1, live}};
+    std::atomic<pl::test::node*>   src{first};
+
+    pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer(domain)};
+    pl::test::node*         ptr{src.load()};
+    CHECK(hp.try_protect(ptr, src));
+    CHECK(ptr == first);
+
+    pl::test::node* const second{new pl::test::node{2, live}};
+    src.store(second);
+    pl::test::node* stale{first};
+    CHECK_UNARY_FALSE(hp.try_protect(stale, src));
+    CHECK(stale == second);
+
+    first->retire({}, domain);
+    second->retire({}, domain);
+    domain.reclaim();
+    CHECK(live.load() == 0);
+}
+
+TEST_CASE("hazard_pointer_slot_reuse_test")
+{
+    const std::size_t threshold{
+        pl::thd::hazard_pointer_domain::min_scan_threshold};
+    pl::thd::hazard_pointer_domain domain{};
+    std::atomic<int>               live{0};
+    std::atomic<pl::test::node*>   src{new pl::test::node{1, live}};
+
+    for (int i{0}; i < 100; ++i) {
+        pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer(domain)};
+        (void)hp.protect(src);
+    }
+
+    // the 100 hazard pointers above reused a single slot, so retiring
+    // quickly exceeds the scan threshold and reclaims the objects.
+    for (std::size_t i{0U}; i < 2U * threshold; ++i) {
+        (new pl::test::node{0, live})->retire({}, domain);
+    }
+
+    CHECK(domain.retired_count() < threshold);
+    src.load()->retire({}, domain);
+}
+
+TEST_CASE("hazard_pointer_domain_destructor_test")
+{
+    std::atomic<int> live{0};
+
+    {
+        pl::thd::hazard_pointer_domain domain{};
+        (new pl::test::node{1, live})->retire({}, domain);
+        (new pl::test::node{2, live})->retire({}, domain);
+        CHECK(live.load() == 2);
+    }
+
+    CHECK(live.load() == 0);
+}
+
+TEST_CASE("hazard_pointer_concurrent_test")
+{
+    static constexpr int readers{4};
+    static constexpr int updates{2000};
+    std::atomic<int>     live{0};
+
+    {
+        pl::thd::hazard_pointer_domain domain{};
+        std::atomic<pl::test::node*>   shared{new pl::test::node{0, live}};
+        std::atomic<bool>              done{false};
+        std::atomic<int>               failures{0};
+        std::vector<std::thread>       threads{};
+
+        for (int i{0}; i < readers; ++i) {
+            threads.emplace_back([&domain, &shared, &done, &failures] {
+                pl::thd::hazard_pointer hp{pl::thd::make_hazard_pointer(domain)};
+                int                     last{0};
+
+                while (not done.load()) {
+                    const pl::test::node* const n{hp.protect(shared)};
+
+                    if (n->m_value < last) {
+                        ++failures;
+                    }
+
+                    last = n->m_value;
+                    hp.reset_protection();
+                }
+            });
+        }
+
+        for (int i{1}; i <= updates; ++i) {
+            pl::test::node* const old{
+                shared.exchange(new pl::test::node{i, live})};
+            old->retire({}, domain);
+        }
+
+        done.store(true);
+
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        CHECK(failures.load() == 0);
+        shared.load()->retire({}, domain);
+    }
+
+    CHECK(live.load() == 0);
+}
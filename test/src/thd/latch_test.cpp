@@ -0,0 +1,83 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/latch.hpp" // pl::thd::latch
+#include <atomic>                            // std::atomic
+#include <thread>                            // std::thread
+#include <vector>                            // std::vector
+
+TEST_CASE("latch_single_thread_test")
+{
+    pl::thd::latch latch{3};
+    CHECK_UNARY_FALSE(latch.try_wait());
+    latch.count_down();
+    CHECK_UNARY_FALSE(latch.try_wait());
+    latch.count_down(2);
+    CHECK(latch.try_wait());
+    latch.wait();
+
+    pl::thd::latch zero{0};
+    CHECK(zero.try_wait());
+    zero.wait();
+
+    const std::ptrdiff_t max{pl::thd::latch::max()};
+    CHECK(max > 0);
+}
+
+TEST_CASE("latch_multi_thread_test")
+{
+    static constexpr int     thread_count{4};
+    pl::thd::latch           start{1};
+    pl::thd::latch           done{thread_count};
+    std::atomic<int>         started{0};
+    std::vector<std::thread> threads{};
+
+    for (int i{0}; i < thread_count; ++i) {
+        threads.emplace_back([&start, &done, &started] {
+            start.wait();
+            ++started;
+            done.arrive_and_wait();
+        });
+    }
+
+    CHECK(started.load() == 0);
+    start.count_down();
+    done.wait();
+    CHECK(started.load() == thread_count);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
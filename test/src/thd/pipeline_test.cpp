@@ -0,0 +1,300 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/except.hpp"                // pl::precondition_violation_exception
+#include "../../../include/pl/thd/pipeline.hpp"          // pl::thd::pipeline, pl::thd::make_pipeline
+#include "../../../include/pl/thd/thread_safe_queue.hpp" // pl::thd::thread_safe_queue
+#include <atomic>                                        // std::atomic
+#include <chrono>                                        // std::chrono::milliseconds, std::chrono::steady_clock
+#include <cstddef>                                       // std::size_t
+#include <mutex>                                         // std::mutex, std::lock_guard
+#include <stdexcept>                                     // std::runtime_error
+#include <string>                                        // std::string, std::to_string, std::stoi
+#include <thread>                                        // std::thread
+#include <vector>                                        // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+/*!
+ * \brief Callable whose copy constructor throws once copies are armed and
+ *        a number of copies has been made.
+**/
+class throwing_copy {
+public:
+    throwing_copy(std::atomic<int>& copies_left) noexcept
+        : m_copies_left{&copies_left}
+    {
+    }
+
+    throwing_copy(const throwing_copy& other) : m_copies_left{other.m_copies_left}
+    {
+        if (m_copies_left->fetch_sub(1) == 0) {
+            throw std::runtime_error{"copy failed"};
+        }
+    }
+
+    throwing_copy& operator=(const throwing_copy&) = default;
+
+    int operator()(int i) const noexcept { return i; }
+
+private:
+    std::atomic<int>* m_copies_left;
+};
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("bounded_thread_safe_queue_test")
+{
+    pl::thd::thread_safe_queue<int> q{2U};
+    CHECK(q.capacity() == 2U);
+
+    q.push(1);
+    q.push(2);
+
+    std::atomic<bool> pushed{false};
+    std::thread       producer{[&q, &pushed] {
+        q.push(3); // blocks until there is space.
+        pushed = true;
+    }};
+
+    CHECK(q.pop() == 1);
+    producer.join();
+    CHECK_UNARY(pushed.load());
+    CHECK(q.size() == 2U);
+    CHECK(q.pop() == 2);
+    CHECK(q.pop() == 3);
+
+    CHECK_THROWS_AS(
+        pl::thd::thread_safe_queue<int>{0U},
+        pl::precondition_violation_exception);
+}
+
+TEST_CASE("pipeline_test")
+{
+    static constexpr int item_count{1000};
+
+    SUBCASE("preserve_order")
+    {
+        pl::thd::pipeline_options options{};
+        options.queue_capacity = 2U;
+        options.batch_size     = 7U;
+        options.preserve_order = true;
+
+        std::vector<int> results{};
+
+        {
+            pl::thd::pipeline<int> p{
+                pl::thd::make_pipeline<int>(options)
+                    .stage(4U, [](int i) { return std::to_string(i); })
+                    .stage(3U, [](const std::string& s) { return std::stoi(s); })
+                    .sink([&results](int i) { results.push_back(i); })};
+
+            for (int i{0}; i < item_count; ++i) {
+                p.push(i);
+            }
+
+            p.finish();
+        }
+
+        REQUIRE(results.size() == static_cast<std::size_t>(item_count));
+
+        for (int i{0}; i < item_count; ++i) {
+            CHECK(results[static_cast<std::size_t>(i)] == i);
+        }
+    }
+
+    SUBCASE("unordered")
+    {
+        std::atomic<long> sum{0};
+
+        {
+            pl::thd::pipeline<int> p{
+                pl::thd::make_pipeline<int>()
+                    .stage(2U, [](int i) { return static_cast<long>(i) * 2; })
+                    .sink(2U, [&sum](long i) { sum += i; })};
+
+            for (int i{0}; i < item_count; ++i) {
+                p.push(i);
+            }
+
+            // the destructor finishes the pipeline.
+        }
+
+        CHECK(sum == static_cast<long>(item_count) * (item_count - 1));
+    }
+
+    SUBCASE("sink_only")
+    {
+        std::vector<int> results{};
+
+        {
+            pl::thd::pipeline<int> p{pl::thd::make_pipeline<int>().sink(
+                [&results](int i) { results.push_back(i); })};
+            p.push(1);
+            p.push(2);
+            p.finish();
+        }
+
+        CHECK(results.size() == 2U);
+    }
+
+    SUBCASE("exception")
+    {
+        pl::thd::pipeline<int> p{
+            pl::thd::make_pipeline<int>()
+                .stage(2U,
+                       [](int i) {
+                           if (i == 500) {
+                               throw std::runtime_error{"error"};
+                           }
+
+                           return i;
+                       })
+                .sink([](int) {})};
+
+        for (int i{0}; i < item_count; ++i) {
+            p.push(i);
+        }
+
+        CHECK_THROWS_AS(p.finish(), std::runtime_error);
+    }
+
+    SUBCASE("exception_preserve_order")
+    {
+        pl::thd::pipeline_options options{};
+        options.queue_capacity = 1U;
+        options.batch_size     = 1U;
+        options.preserve_order = true;
+
+        pl::thd::pipeline<int> p{
+            pl::thd::make_pipeline<int>(options)
+                .stage(2U,
+                       [](int i) {
+                           if (i == 10) {
+                               throw std::runtime_error{"error"};
+                           }
+
+                           return i;
+                       })
+                .sink([](int) {})};
+
+        // the dropped batches must not block the producer.
+        for (int i{0}; i < item_count; ++i) {
+            p.push(i);
+        }
+
+        CHECK_THROWS_AS(p.finish(), std::runtime_error);
+    }
+
+    SUBCASE("preserve_order_bounds_items_in_flight")
+    {
+        pl::thd::pipeline_options options{};
+        options.queue_capacity = 1U;
+        options.batch_size     = 1U;
+        options.preserve_order = true;
+
+        // 1 * 2 queues + 3 threads.
+        static constexpr int window{5};
+
+        std::atomic<bool> stall{true};
+        std::atomic<int>  processed{0};
+        std::atomic<int>  pushed{0};
+        std::vector<int>  results{};
+
+        pl::thd::pipeline<int> p{
+            pl::thd::make_pipeline<int>(options)
+                .stage(2U,
+                       [&stall, &processed](int i) {
+                           while ((i == 0) and stall) {
+                               std::this_thread::yield();
+                           }
+
+                           ++processed;
+                           return i;
+                       })
+                .sink([&results](int i) { results.push_back(i); })};
+
+        std::thread producer{[&p, &pushed] {
+            for (int i{0}; i < item_count; ++i) {
+                p.push(i);
+                ++pushed;
+            }
+        }};
+
+        const auto deadline
+            = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+
+        while ((processed < window - 1)
+               and (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::yield();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{100});
+
+        // batch 0 stalls, the stage and the producer are blocked rather
+        // than the sink collecting every other batch.
+        CHECK(processed == window - 1);
+        CHECK(pushed == window);
+
+        stall = false;
+        producer.join();
+        p.finish();
+
+        REQUIRE(results.size() == static_cast<std::size_t>(item_count));
+
+        for (int i{0}; i < item_count; ++i) {
+            CHECK(results[static_cast<std::size_t>(i)] == i);
+        }
+    }
+
+    SUBCASE("starting_a_thread_fails")
+    {
+        std::atomic<int> copies_left{1000};
+        auto             builder
+            = pl::thd::make_pipeline<int>()
+                  .stage(2U, [](int i) { return i; })
+                  .stage(3U, pl::test::throwing_copy{copies_left});
+
+        // fails while starting the threads of the second stage, after the
+        // sink and some of the threads of the stage have been started.
+        copies_left = 3;
+
+        CHECK_THROWS_AS(
+            (void)std::move(builder).sink([](int) {}), std::runtime_error);
+    }
+}
+
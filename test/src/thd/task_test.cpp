@@ -0,0 +1,129 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/task.hpp"        // pl::thd::task, pl::thd::sync_wait
+#include "../../../include/pl/thd/thread_pool.hpp" // pl::thd::thread_pool
+#ifdef __cpp_impl_coroutine
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+#include <thread>    // std::this_thread::get_id, std::thread::id
+
+namespace pl {
+namespace test {
+namespace {
+pl::thd::task<int> value_task(int i) { co_return i * 2; }
+
+pl::thd::task<int> nested_task(int i)
+{
+    const int a{co_await value_task(i)};
+    const int b{co_await value_task(a)};
+    co_return b;
+}
+
+pl::thd::task<int&> reference_task(int& i) { co_return i; }
+
+pl::thd::task<void> void_task(int& i)
+{
+    ++i;
+    co_return;
+}
+
+pl::thd::task<std::string> throwing_task()
+{
+    throw std::runtime_error{"error"};
+    co_return std::string{};
+}
+
+pl::thd::task<std::thread::id> thread_id_task(pl::thd::thread_pool& tp)
+{
+    co_await tp.schedule();
+    co_return std::this_thread::get_id();
+}
+
+pl::thd::task<int> deep_task(int depth)
+{
+    if (depth == 0) {
+        co_return 0;
+    }
+
+    co_return 1 + co_await deep_task(depth - 1);
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("task_value_test")
+{
+    CHECK(pl::thd::sync_wait(pl::test::value_task(5)) == 10);
+    CHECK(pl::thd::sync_wait(pl::test::nested_task(1)) == 4);
+}
+
+TEST_CASE("task_is_lazy_test")
+{
+    int                 i{0};
+    pl::thd::task<void> t{pl::test::void_task(i)};
+    CHECK_UNARY_FALSE(t.is_ready());
+    CHECK(i == 0);
+    pl::thd::sync_wait(std::move(t));
+    CHECK(i == 1);
+}
+
+TEST_CASE("task_reference_test")
+{
+    int  i{1};
+    int& r{pl::thd::sync_wait(pl::test::reference_task(i))};
+    CHECK(&r == &i);
+}
+
+TEST_CASE("task_exception_test")
+{
+    CHECK_THROWS_AS(
+        pl::thd::sync_wait(pl::test::throwing_task()), std::runtime_error);
+}
+
+TEST_CASE("task_chain_test")
+{
+    static constexpr int depth{1000};
+    CHECK(pl::thd::sync_wait(pl::test::deep_task(depth)) == depth);
+}
+
+TEST_CASE("thread_pool_schedule_test")
+{
+    pl::thd::thread_pool tp{2U};
+    const std::thread::id id{
+        pl::thd::sync_wait(pl::test::thread_id_task(tp))};
+    CHECK(id != std::this_thread::get_id());
+}
+#endif // __cpp_impl_coroutine
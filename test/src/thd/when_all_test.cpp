@@ -0,0 +1,128 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/thread_pool.hpp" // pl::thd::thread_pool
+#include "../../../include/pl/thd/when_all.hpp"    // pl::thd::when_all
+#ifdef __cpp_impl_coroutine
+#include <atomic>    // std::atomic
+#include <stdexcept> // std::runtime_error
+#include <string>    // std::string
+#include <tuple>     // std::tuple, std::get
+#include <variant>   // std::monostate
+#include <vector>    // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+pl::thd::task<int> square_task(pl::thd::thread_pool& tp, int i)
+{
+    co_await tp.schedule();
+    co_return i * i;
+}
+
+pl::thd::task<std::string> string_task(pl::thd::thread_pool& tp)
+{
+    co_await tp.schedule();
+    co_return std::string{"text"};
+}
+
+pl::thd::task<void> count_task(
+    pl::thd::thread_pool& tp,
+    std::atomic<int>&     counter)
+{
+    co_await tp.schedule();
+    ++counter;
+}
+
+pl::thd::task<int> throwing_task(pl::thd::thread_pool& tp)
+{
+    co_await tp.schedule();
+    throw std::runtime_error{"error"};
+}
+
+pl::thd::task<int> sum_task(pl::thd::thread_pool& tp, int count)
+{
+    std::vector<pl::thd::task<int>> tasks{};
+
+    for (int i{0}; i < count; ++i) {
+        tasks.push_back(square_task(tp, i));
+    }
+
+    const std::vector<int> results{
+        co_await pl::thd::when_all(std::move(tasks))};
+    int sum{0};
+
+    for (int r : results) {
+        sum += r;
+    }
+
+    co_return sum;
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("when_all_variadic_test")
+{
+    pl::thd::thread_pool tp{4U};
+    std::atomic<int>     counter{0};
+
+    const std::tuple<int, std::string, std::monostate> result{
+        pl::thd::sync_wait(pl::thd::when_all(
+            pl::test::square_task(tp, 3),
+            pl::test::string_task(tp),
+            pl::test::count_task(tp, counter)))};
+
+    CHECK(std::get<0>(result) == 9);
+    CHECK(std::get<1>(result) == "text");
+    CHECK(counter == 1);
+}
+
+TEST_CASE("when_all_vector_test")
+{
+    pl::thd::thread_pool tp{4U};
+    CHECK(pl::thd::sync_wait(pl::test::sum_task(tp, 100)) == 328350);
+    CHECK(pl::thd::sync_wait(pl::test::sum_task(tp, 0)) == 0);
+}
+
+TEST_CASE("when_all_exception_test")
+{
+    pl::thd::thread_pool tp{2U};
+    CHECK_THROWS_AS(
+        pl::thd::sync_wait(pl::thd::when_all(
+            pl::test::square_task(tp, 2), pl::test::throwing_task(tp))),
+        std::runtime_error);
+}
+#endif // __cpp_impl_coroutine
@@ -0,0 +1,112 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/thread_pool.hpp" // pl::thd::thread_pool
+#include "../../../include/pl/thd/when_any.hpp"    // pl::thd::when_any
+#ifdef __cpp_impl_coroutine
+#include <future>    // std::promise, std::shared_future
+#include <stdexcept> // std::runtime_error
+#include <vector>    // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+pl::thd::task<int> immediate_task(int i) { co_return i; }
+
+pl::thd::task<int> blocking_task(
+    pl::thd::thread_pool&    tp,
+    std::shared_future<void> fut,
+    int                      i)
+{
+    co_await tp.schedule();
+    fut.wait();
+    co_return i;
+}
+
+pl::thd::task<void> void_task(pl::thd::thread_pool& tp)
+{
+    co_await tp.schedule();
+}
+
+pl::thd::task<int> throwing_task()
+{
+    throw std::runtime_error{"error"};
+    co_return 0;
+}
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("when_any_test")
+{
+    pl::thd::thread_pool tp{2U};
+
+    SUBCASE("first_to_complete_wins")
+    {
+        std::promise<void>       blocker{};
+        std::shared_future<void> fut{blocker.get_future().share()};
+
+        const pl::thd::when_any_result<int> result{
+            pl::thd::sync_wait(pl::thd::when_any(
+                pl::test::blocking_task(tp, fut, 1),
+                pl::test::immediate_task(2)))};
+
+        CHECK(result.index == 1U);
+        CHECK(result.value == 2);
+
+        // let the straggler finish, it must outlive the when_any.
+        blocker.set_value();
+    }
+
+    SUBCASE("vector")
+    {
+        std::vector<pl::thd::task<void>> tasks{};
+        tasks.push_back(pl::test::void_task(tp));
+        tasks.push_back(pl::test::void_task(tp));
+
+        const pl::thd::when_any_result<void> result{
+            pl::thd::sync_wait(pl::thd::when_any(std::move(tasks)))};
+
+        CHECK(result.index < 2U);
+    }
+
+    SUBCASE("exception")
+    {
+        CHECK_THROWS_AS(
+            pl::thd::sync_wait(pl::thd::when_any(pl::test::throwing_task())),
+            std::runtime_error);
+    }
+}
+#endif // __cpp_impl_coroutine
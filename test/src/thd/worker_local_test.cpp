@@ -0,0 +1,166 @@
+/* This is free and unencumbered software released into the public domain.
+ *
+ * Anyone is free to copy, modify, publish, use, compile, sell, or
+ * distribute this software, either in source code form or as a compiled
+ * binary, for any purpose, commercial or non-commercial, and by any
+ * means.
+ *
+ * In jurisdictions that recognize copyright laws, the author or authors
+ * of this software dedicate any and all copyright interest in the
+ * software to the public domain. We make this dedication for the benefit
+ * of the public at large and to the detriment of our heirs and
+ * successors. We intend this dedication to be an overt act of
+ * relinquishment in perpetuity of all present and future rights to this
+ * software under copyright law.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+ * OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * For more information, please refer to <http://unlicense.org/>
+ */
+
+#include "../../../include/pl/compiler.hpp"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-noreturn"
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../doctest.h"
+#if PL_COMPILER == PL_COMPILER_GCC
+#pragma GCC diagnostic pop
+#endif // PL_COMPILER == PL_COMPILER_GCC
+#include "../../../include/pl/thd/thread_pool.hpp"  // pl::thd::thread_pool
+#include "../../../include/pl/thd/worker_local.hpp" // pl::thd::worker_local
+#include <cstddef>                                  // std::size_t
+#include <future>                                   // std::future
+#include <memory>                                   // std::unique_ptr
+#include <vector>                                   // std::vector
+
+namespace pl {
+namespace test {
+namespace {
+class counted {
+public:
+    explicit counted(int& live) : m_live{&live} { ++*m_live; }
+    counted(counted&& other) noexcept : m_live{other.m_live}
+    {
+        other.m_live = nullptr;
+    }
+    counted(const counted&) = delete;
+    counted& operator=(const counted&) = delete;
+    counted& operator=(counted&&) = delete;
+    ~counted()
+    {
+        if (m_live != nullptr) {
+            --*m_live;
+        }
+    }
+
+private:
+    int* m_live;
+};
+} // anonymous namespace
+} // namespace test
+} // namespace pl
+
+TEST_CASE("worker_index_test")
+{
+    static constexpr std::size_t thread_count{3U};
+    pl::thd::thread_pool         tp{thread_count};
+
+    const std::size_t no_worker{pl::thd::thread_pool::no_worker};
+    CHECK(tp.worker_index() == no_worker);
+    CHECK(tp.worker_index() == pl::thd::thread_pool::no_worker);
+
+    std::future<std::size_t> fut{
+        tp.add_task([&tp] { return tp.worker_index(); })};
+    CHECK(fut.get() < thread_count);
+}
+
+TEST_CASE("worker_local_test")
+{
+    static constexpr std::size_t thread_count{4U};
+    static constexpr int         task_count{1000};
+    pl::thd::thread_pool         tp{thread_count};
+
+    SUBCASE("reduction")
+    {
+        pl::thd::worker_local<std::vector<int>> histograms{
+            tp, [] { return std::vector<int>(10U, 0); }};
+
+        std::vector<std::future<void>> futures{};
+
+        for (int i{0}; i < task_count; ++i) {
+            futures.push_back(tp.add_task([&histograms, i] {
+                ++histograms.local()[static_cast<std::size_t>(i % 10)];
+            }));
+        }
+
+        for (std::future<void>& fut : futures) {
+            fut.get();
+        }
+
+        CHECK(histograms.size() >= 1U);
+        CHECK(histograms.size() <= thread_count);
+
+        std::vector<int> merged(10U, 0);
+        histograms.for_each([&merged](const std::vector<int>& histogram) {
+            for (std::size_t i{0U}; i < histogram.size(); ++i) {
+                merged[i] += histogram[i];
+            }
+        });
+
+        for (int count : merged) {
+            CHECK(count == task_count / 10);
+        }
+
+        const int total{histograms.combine(
+            0, [](int acc, const std::vector<int>& histogram) {
+                for (int count : histogram) {
+                    acc += count;
+                }
+
+                return acc;
+            })};
+        CHECK(total == task_count);
+
+        histograms.clear();
+        CHECK(histograms.size() == 0U);
+    }
+
+    SUBCASE("same_object_per_thread")
+    {
+        pl::thd::worker_local<int> local{tp};
+        std::future<bool>          fut{tp.add_task([&local] {
+            int* const first{&local.local()};
+            return first == &local.local();
+        })};
+        CHECK_UNARY(fut.get());
+    }
+}
+
+TEST_CASE("worker_local_pool_teardown_test")
+{
+    int live{0};
+    std::unique_ptr<pl::thd::worker_local<pl::test::counted>> local{};
+
+    {
+        pl::thd::thread_pool tp{2U};
+        local = std::make_unique<pl::thd::worker_local<pl::test::counted>>(
+            tp, [&live] { return pl::test::counted{live}; });
+
+        std::future<void> fut{tp.add_task([&local] { (void)local->local(); })};
+        fut.get();
+        CHECK(live == 1);
+        CHECK(local->pool() == &tp);
+    }
+
+    // the objects are destroyed together with the thread_pool.
+    CHECK(live == 0);
+    CHECK(local->pool() == nullptr);
+    local.reset();
+}
@@ -95,6 +95,84 @@ TEST_CASE("vla_test")
     vla.at(4U) = pl::test::vla_test_type{"Test"s, 9};
     CHECK(vla.at(4U) == pl::test::vla_test_type{"Test"s, 9});
 }
+
+TEST_CASE("safe_vla_test")
+{
+    using namespace std::literals::string_literals;
+
+    static constexpr std::size_t amount{5U};
+
+    PL_SAFE_VLA(
+        pl::test::vla_test_type,
+        vla,
+        amount,
+        pl::test::vla_test_type{"Text"s, 5});
+
+    CHECK(vla.size() == amount);
+    CHECK_FALSE(pl_vla_buffer_vla.is_on_heap());
+
+    for (const pl::test::vla_test_type& e : vla) {
+        CHECK(e == pl::test::vla_test_type{"Text"s, 5});
+    }
+
+    vla.at(4U) = pl::test::vla_test_type{"Test"s, 9};
+    CHECK(vla.back() == pl::test::vla_test_type{"Test"s, 9});
+}
+
+TEST_CASE("safe_vla_heap_test")
+{
+    const std::size_t amount{
+        (PL_SAFE_VLA_MAX_STACK_BYTES / sizeof(std::string)) + 1U};
+    const void* previous{nullptr};
+
+    for (int i{0}; i < 3; ++i) {
+        PL_SAFE_VLA(std::string, vla, amount, "text");
+
+        CHECK(vla.size() == amount);
+        CHECK(pl_vla_buffer_vla.is_on_heap());
+        CHECK(vla.front() == "text");
+        CHECK(vla.back() == "text");
+
+        // the heap buffer is reused.
+        if (previous != nullptr) {
+            CHECK(vla.data() == previous);
+        }
+
+        previous = vla.data();
+    }
+}
+
+TEST_CASE("safe_vla_cache_limit_test")
+{
+    pl::detail::vla_buffer_cache& cache{
+        pl::detail::vla_buffer_cache::instance()};
+
+    {
+        PL_SAFE_VLA(char, small_vla, PL_SAFE_VLA_MAX_STACK_BYTES + 1U, 'a');
+        CHECK(pl_vla_buffer_small_vla.is_on_heap());
+    }
+
+    const std::size_t cached{cache.size()};
+    REQUIRE(cached != 0U);
+
+    {
+        PL_SAFE_VLA(char, huge_vla, PL_SAFE_VLA_MAX_CACHED_BYTES + 1U, 'a');
+        CHECK(pl_vla_buffer_huge_vla.is_on_heap());
+        CHECK(huge_vla.size() == PL_SAFE_VLA_MAX_CACHED_BYTES + 1U);
+    }
+
+    // the huge buffer was freed rather than cached.
+    CHECK(cache.size() == cached);
+
+    {
+        PL_SAFE_VLA(char, vla, PL_SAFE_VLA_MAX_CACHED_BYTES, 'a');
+        CHECK(pl_vla_buffer_vla.is_on_heap());
+    }
+
+    // buffers up to the limit are still cached.
+    const std::size_t max_buffers{pl::detail::vla_buffer_cache::max_buffers};
+    CHECK(cache.size() == (cached < max_buffers ? cached + 1U : max_buffers));
+}
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif // PL_COMPILER == PL_COMPILER_GCC
@@ -33,10 +33,14 @@
 #if PL_COMPILER == PL_COMPILER_GCC
 #pragma GCC diagnostic pop
 #endif                               // PL_COMPILER == PL_COMPILER_GCC
-#include "../../include/pl/byte.hpp" // pl::byte
+#include "../../include/pl/byte.hpp"            // pl::byte
 #include "../../include/pl/cont/make_array.hpp" // pl::make_array
-#include "../../include/pl/zero_memory.hpp" // pl::zero_memory, pl::secure_zero_memory
-#include <cstdint>                          // std::uint64_t, UINT64_C
+#include "../../include/pl/zero_memory.hpp"     // pl::zero_memory, pl::secure_zero_memory, pl::zero_memory_policy
+#include <algorithm>                            // std::count
+#include <ciso646>                              // and
+#include <cstddef>                              // std::size_t, std::ptrdiff_t
+#include <cstdint>                              // std::uint64_t, UINT64_C
+#include <vector>                               // std::vector
 
 TEST_CASE("zero_memory_test")
 {
@@ -78,3 +82,41 @@ TEST_CASE("zero_memory_test")
         CHECK(i == UINT64_C(0));
     }
 }
+
+TEST_CASE("zero_memory_policy_test")
+{
+    static constexpr std::size_t max_size{1000U};
+    static constexpr std::size_t max_offset{20U};
+    static constexpr pl::byte    fill{0xA5};
+
+    for (pl::zero_memory_policy policy :
+         {pl::zero_memory_policy::automatic,
+          pl::zero_memory_policy::cached,
+          pl::zero_memory_policy::streaming}) {
+        for (std::size_t size : {0U, 1U, 15U, 16U, 63U, 64U, 130U, 1000U}) {
+            for (std::size_t offset : {0U, 1U, 8U, 17U}) {
+                std::vector<pl::byte> buffer(max_size + max_offset, fill);
+
+                void* const result{
+                    pl::zero_memory(buffer.data() + offset, size, policy)};
+                CHECK(result == buffer.data() + offset);
+
+                for (std::size_t i{0U}; i < buffer.size(); ++i) {
+                    const bool in_range{(i >= offset) and (i < offset + size)};
+                    CHECK(buffer[i] == (in_range ? pl::byte{0x00} : fill));
+                }
+            }
+        }
+    }
+
+    SUBCASE("secure_zero_memory")
+    {
+        std::vector<pl::byte> buffer(max_size, fill);
+        pl::secure_zero_memory(buffer.data() + 3U, max_size - 6U);
+
+        CHECK(buffer.front() == fill);
+        CHECK(buffer.back() == fill);
+        CHECK(std::count(buffer.begin(), buffer.end(), pl::byte{0x00})
+              == static_cast<std::ptrdiff_t>(max_size - 6U));
+    }
+}